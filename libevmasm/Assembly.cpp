@@ -34,7 +34,9 @@
 #include <liblangutil/Exceptions.h>
 
 #include <libsolutil/JSON.h>
+#include <libsolutil/Profiler.h>
 #include <libsolutil/StringUtils.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <fmt/format.h>
 
@@ -43,9 +45,14 @@
 #include <range/v3/view/enumerate.hpp>
 #include <range/v3/view/map.hpp>
 
+#include <boost/container_hash/hash.hpp>
+
 #include <fstream>
 #include <limits>
+#include <mutex>
 #include <iterator>
+#include <optional>
+#include <unordered_map>
 
 using namespace solidity;
 using namespace solidity::evmasm;
@@ -676,6 +683,9 @@ void Assembly::encodeAllPossibleSubPathsInAssemblyTree(std::vector<size_t> _path
 
 std::shared_ptr<std::string const> Assembly::sharedSourceName(std::string const& _name) const
 {
+	// Assemblies of different contracts may be created and optimized concurrently.
+	static std::mutex mutex;
+	std::lock_guard<std::mutex> lock(mutex);
 	if (s_sharedSourceNames.find(_name) == s_sharedSourceNames.end())
 		s_sharedSourceNames[_name] = std::make_shared<std::string>(_name);
 
@@ -722,39 +732,160 @@ AssemblyItem Assembly::newAuxDataLoadN(size_t _offset)
 	return AssemblyItem{AuxDataLoadN, _offset};
 }
 
-Assembly& Assembly::optimise(OptimiserSettings const& _settings)
+namespace
+{
+
+/// @returns true if the same sub-assembly is reachable from @a _assembly in more than one way.
+bool hasSharedSubAssemblies(Assembly const& _assembly, std::set<Assembly const*>& _visited)
+{
+	for (size_t subId = 0; subId < _assembly.numSubs(); ++subId)
+	{
+		Assembly const& sub = _assembly.sub(subId);
+		if (!_visited.insert(&sub).second || hasSharedSubAssemblies(sub, _visited))
+			return true;
+	}
+	return false;
+}
+
+/// Chunks of items that the common subexpression eliminator could not improve.
+/// The result of the eliminator only depends on the items of a chunk and on whether MSIZE is used,
+/// so these chunks are skipped in later iterations of the optimiser loop.
+class UnimprovableChunks
+{
+public:
+	void setUsesMSize(bool _usesMSize)
+	{
+		if (m_usesMSize != _usesMSize)
+			m_chunks.clear();
+		m_usesMSize = _usesMSize;
+	}
+
+	bool contains(AssemblyItems::const_iterator _begin, AssemblyItems::const_iterator _end) const
+	{
+		auto [first, last] = m_chunks.equal_range(hash(_begin, _end));
+		for (auto it = first; it != last; ++it)
+			if (std::equal(it->second.begin(), it->second.end(), _begin, _end))
+				return true;
+		return false;
+	}
+
+	void insert(AssemblyItems::const_iterator _begin, AssemblyItems::const_iterator _end)
+	{
+		m_chunks.emplace(hash(_begin, _end), AssemblyItems(_begin, _end));
+	}
+
+private:
+	/// @returns a hash of the items that is compatible with AssemblyItem::operator==.
+	static size_t hash(AssemblyItems::const_iterator _begin, AssemblyItems::const_iterator _end)
+	{
+		size_t seed = 0;
+		for (auto it = _begin; it != _end; ++it)
+		{
+			boost::hash_combine(seed, static_cast<int>(it->type()));
+			if (it->type() == Operation)
+				boost::hash_combine(seed, static_cast<uint8_t>(it->instruction()));
+			else if (it->type() != VerbatimBytecode)
+			{
+				u256 data = it->data();
+				boost::hash_combine(seed, data);
+			}
+		}
+		return seed;
+	}
+
+	std::optional<bool> m_usesMSize;
+	std::unordered_multimap<size_t, AssemblyItems> m_chunks;
+};
+
+/// Runs the common subexpression eliminator on a single chunk of items, starting from an empty state.
+/// @returns the optimised items if they are shorter than the chunk and nothing otherwise.
+std::optional<AssemblyItems> eliminateCommonSubexpressions(
+	AssemblyItems::const_iterator _begin,
+	AssemblyItems::const_iterator _end,
+	bool _usesMSize
+)
+{
+	KnownState emptyState;
+	CommonSubexpressionEliminator eliminator{emptyState};
+	solAssert(eliminator.feedItems(_begin, _end, _usesMSize) == _end);
+	try
+	{
+		AssemblyItems optimisedChunk = eliminator.getOptimizedItems();
+		if (optimisedChunk.size() < static_cast<size_t>(_end - _begin))
+			return optimisedChunk;
+	}
+	catch (StackTooDeepException const&)
+	{
+		// This might happen if the opcode reconstruction is not as efficient
+		// as the hand-crafted code.
+	}
+	catch (ItemNotAvailableException const&)
+	{
+		// This might happen if e.g. associativity and commutativity rules
+		// reorganise the expression tree, but not all leaves are available.
+	}
+	return std::nullopt;
+}
+
+}
+
+Assembly& Assembly::optimise(OptimiserSettings const& _settings, ThreadPool* _threadPool)
 {
-	optimiseInternal(_settings, {});
+	PROFILER_PROBE("EVMAssemblyOptimiser", probe);
+	// A shared sub-assembly is optimised only once, at the first place it is encountered.
+	// Optimising it concurrently from several places is not possible, but the thread pool
+	// can still be used within each assembly.
+	std::set<Assembly const*> visited;
+	bool concurrentSubs = _threadPool && !hasSharedSubAssemblies(*this, visited);
+	optimiseInternal(_settings, {}, _threadPool, concurrentSubs);
 	return *this;
 }
 
 std::map<u256, u256> const& Assembly::optimiseInternal(
 	OptimiserSettings const& _settings,
-	std::set<size_t> _tagsReferencedFromOutside
+	std::set<size_t> _tagsReferencedFromOutside,
+	ThreadPool* _threadPool,
+	bool _concurrentSubs
 )
 {
 	if (m_tagReplacements)
 		return *m_tagReplacements;
 
 	// Run optimisation for sub-assemblies.
+	// The sub-assemblies do not depend on each other, so they can be optimised concurrently.
+	// The tags referenced from this assembly only change when the replacements of the same
+	// sub-assembly are applied, so they can be determined up front.
 	// TODO: verify and double-check this for EOF.
+	std::vector<std::set<size_t>> referencedTags(m_subs.size());
+	std::vector<std::function<void()>> subOptimisations;
 	for (size_t subId = 0; subId < m_subs.size(); ++subId)
 	{
-		OptimiserSettings settings = _settings;
-		Assembly& sub = *m_subs[subId];
-		std::set<size_t> referencedTags;
 		for (auto& codeSection: m_codeSections)
-			referencedTags += JumpdestRemover::referencedTags(codeSection.items, subId);
-		std::map<u256, u256> const& subTagReplacements = sub.optimiseInternal(
-			settings,
-			referencedTags
-		);
+			referencedTags[subId] += JumpdestRemover::referencedTags(codeSection.items, subId);
+		subOptimisations.emplace_back([&, subId]() {
+			m_subs[subId]->optimiseInternal(_settings, referencedTags[subId], _threadPool, _concurrentSubs);
+		});
+	}
+	if (_threadPool && _concurrentSubs)
+		_threadPool->runAll(std::move(subOptimisations));
+	else
+		for (auto const& subOptimisation: subOptimisations)
+			subOptimisation();
+
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+	{
+		solAssert(m_subs[subId]->m_tagReplacements);
 		// Apply the replacements (can be empty).
 		for (auto& codeSection: m_codeSections)
-			BlockDeduplicator::applyTagReplacement(codeSection.items, subTagReplacements, subId);
+			BlockDeduplicator::applyTagReplacement(codeSection.items, *m_subs[subId]->m_tagReplacements, subId);
 	}
 
 	std::map<u256, u256> tagReplacements;
+	// The steps are deterministic, so the peephole optimiser only has to run again on code sections
+	// that changed after it reached its fixed point, and the common subexpression eliminator
+	// only has to analyse chunks it has not seen before.
+	std::vector<bool> changedSincePeephole(m_codeSections.size(), true);
+	UnimprovableChunks unimprovableChunks;
 	// Iterate until no new optimisation possibilities are found.
 	for (unsigned count = 1; count > 0;)
 	{
@@ -764,45 +895,53 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 		if (_settings.runInliner && !m_eofVersion.has_value())
 		{
 			solAssert(m_codeSections.size() == 1);
-			Inliner{
+			if (Inliner{
 				m_codeSections.front().items,
 				_tagsReferencedFromOutside,
 				_settings.expectedExecutionsPerDeployment,
 				isCreation(),
 				_settings.evmVersion}
-				.optimise();
+				.optimise()
+			)
+				changedSincePeephole.front() = true;
 		}
 		// TODO: verify this for EOF.
 		if (_settings.runJumpdestRemover && !m_eofVersion.has_value())
 		{
-			for (auto& codeSection: m_codeSections)
+			for (size_t section = 0; section < m_codeSections.size(); ++section)
 			{
-				JumpdestRemover jumpdestOpt{codeSection.items};
+				JumpdestRemover jumpdestOpt{m_codeSections[section].items};
 				if (jumpdestOpt.optimise(_tagsReferencedFromOutside))
+				{
+					changedSincePeephole[section] = true;
 					count++;
+				}
 			}
 		}
 
 		// TODO: verify this for EOF.
 		if (_settings.runPeephole && !m_eofVersion.has_value())
 		{
-			for (auto& codeSection: m_codeSections)
+			for (size_t section = 0; section < m_codeSections.size(); ++section)
 			{
-				PeepholeOptimiser peepOpt{codeSection.items, m_evmVersion};
+				if (!changedSincePeephole[section])
+					continue;
+				PeepholeOptimiser peepOpt{m_codeSections[section].items, m_evmVersion};
 				while (peepOpt.optimise())
 				{
 					count++;
 					assertThrow(count < 64000, OptimizerException, "Peephole optimizer seems to be stuck.");
 				}
+				changedSincePeephole[section] = false;
 			}
 		}
 
 		// This only modifies PushTags, we have to run again to actually remove code.
 		// TODO: implement for EOF.
 		if (_settings.runDeduplicate && !m_eofVersion.has_value())
-			for (auto& section: m_codeSections)
+			for (size_t section = 0; section < m_codeSections.size(); ++section)
 			{
-				BlockDeduplicator deduplicator{section.items};
+				BlockDeduplicator deduplicator{m_codeSections[section].items};
 				if (deduplicator.deduplicate())
 				{
 					for (auto const& replacement: deduplicator.replacedTags())
@@ -821,6 +960,7 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 						if (_tagsReferencedFromOutside.erase(static_cast<size_t>(replacement.first)))
 							_tagsReferencedFromOutside.insert(static_cast<size_t>(replacement.second));
 					}
+					changedSincePeephole[section] = true;
 					count++;
 				}
 			}
@@ -838,43 +978,79 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 			bool usesMSize = ranges::any_of(items, [](AssemblyItem const& _i) {
 				return _i == AssemblyItem{Instruction::MSIZE} || _i.type() == VerbatimBytecode;
 			});
+			unimprovableChunks.setUsesMSize(usesMSize);
 
-			auto iter = items.begin();
-			while (iter != items.end())
+			// Every chunk is analysed starting from an empty state, so the chunks are independent
+			// and can be analysed concurrently. They are reassembled in their original order.
+			struct Chunk
 			{
-				KnownState emptyState;
-				CommonSubexpressionEliminator eliminator{emptyState};
-				auto orig = iter;
-				iter = eliminator.feedItems(iter, items.end(), usesMSize);
-				bool shouldReplace = false;
-				AssemblyItems optimisedChunk;
-				try
-				{
-					optimisedChunk = eliminator.getOptimizedItems();
-					shouldReplace = (optimisedChunk.size() < static_cast<size_t>(iter - orig));
-				}
-				catch (StackTooDeepException const&)
+				AssemblyItems::const_iterator begin;
+				AssemblyItems::const_iterator end;
+				bool knownUnimprovable = false;
+				std::optional<AssemblyItems> replacement;
+			};
+			std::vector<Chunk> chunks;
+			for (auto iter = items.cbegin(); iter != items.cend();)
+			{
+				auto chunkEnd = CommonSubexpressionEliminator::chunkEnd(iter, items.cend(), usesMSize);
+				chunks.push_back({iter, chunkEnd, unimprovableChunks.contains(iter, chunkEnd), std::nullopt});
+				iter = chunkEnd;
+			}
+
+			// Most chunks are small compared to the cost of a task, so consecutive chunks are analysed
+			// in batches of similar size. A few batches per thread balance the load.
+			std::vector<Chunk*> pendingChunks;
+			size_t pendingItems = 0;
+			for (Chunk& chunk: chunks)
+				if (!chunk.knownUnimprovable)
 				{
-					// This might happen if the opcode reconstruction is not as efficient
-					// as the hand-crafted code.
+					pendingChunks.push_back(&chunk);
+					pendingItems += static_cast<size_t>(chunk.end - chunk.begin);
 				}
-				catch (ItemNotAvailableException const&)
+			size_t batchCount = _threadPool ? std::min(pendingChunks.size(), 4 * (_threadPool->size() + 1)) : 1;
+			size_t itemsPerBatch = batchCount > 0 ? (pendingItems + batchCount - 1) / batchCount : 0;
+
+			std::vector<std::function<void()>> analyses;
+			for (size_t batchBegin = 0; batchBegin < pendingChunks.size();)
+			{
+				size_t batchEnd = batchBegin;
+				size_t batchItems = 0;
+				while (batchEnd < pendingChunks.size() && (batchEnd == batchBegin || batchItems < itemsPerBatch))
 				{
-					// This might happen if e.g. associativity and commutativity rules
-					// reorganise the expression tree, but not all leaves are available.
+					batchItems += static_cast<size_t>(pendingChunks[batchEnd]->end - pendingChunks[batchEnd]->begin);
+					++batchEnd;
 				}
+				analyses.emplace_back([&pendingChunks, batchBegin, batchEnd, usesMSize]() {
+					for (size_t i = batchBegin; i < batchEnd; ++i)
+					{
+						Chunk& chunk = *pendingChunks[i];
+						chunk.replacement = eliminateCommonSubexpressions(chunk.begin, chunk.end, usesMSize);
+					}
+				});
+				batchBegin = batchEnd;
+			}
+			if (_threadPool && analyses.size() > 1)
+				_threadPool->runAll(std::move(analyses));
+			else
+				for (auto const& analysis: analyses)
+					analysis();
 
-				if (shouldReplace)
+			for (Chunk const& chunk: chunks)
+				if (chunk.replacement)
 				{
 					count++;
-					optimisedItems += optimisedChunk;
+					optimisedItems += *chunk.replacement;
 				}
 				else
-					copy(orig, iter, back_inserter(optimisedItems));
-			}
+				{
+					if (!chunk.knownUnimprovable)
+						unimprovableChunks.insert(chunk.begin, chunk.end);
+					copy(chunk.begin, chunk.end, back_inserter(optimisedItems));
+				}
 			if (optimisedItems.size() < items.size())
 			{
 				items = std::move(optimisedItems);
+				changedSincePeephole.front() = true;
 				count++;
 			}
 		}
@@ -1169,7 +1345,7 @@ LinkerObject const& Assembly::assembleLegacy() const
 		{
 			assertThrow(item.data() <= std::numeric_limits<size_t>::max(), AssemblyException, "");
 			auto s = subAssemblyById(static_cast<size_t>(item.data()))->assemble().bytecode.size();
-			item.setPushedValue(u256(s));
+			item.setPushedValue(s);
 			unsigned b = std::max<unsigned>(1, numberEncodingSize(s));
 			ret.bytecode.push_back(static_cast<uint8_t>(pushInstruction(b)));
 			ret.bytecode.resize(ret.bytecode.size() + b);
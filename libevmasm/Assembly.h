@@ -40,6 +40,11 @@
 #include <map>
 #include <utility>
 
+namespace solidity::util
+{
+class ThreadPool;
+}
+
 namespace solidity::evmasm
 {
 
@@ -145,7 +150,10 @@ public:
 
 	/// Modify and return the current assembly such that creation and execution gas usage
 	/// is optimised according to the settings in @a _settings.
-	Assembly& optimise(OptimiserSettings const& _settings);
+	/// If @a _threadPool is given, the blocks of each assembly are optimised concurrently. So are
+	/// the sub-assemblies, unless some of them are shared between several places in the tree.
+	/// The result does not depend on it.
+	Assembly& optimise(OptimiserSettings const& _settings, util::ThreadPool* _threadPool = nullptr);
 
 	/// Create a text representation of the assembly.
 	std::string assemblyString(
@@ -208,7 +216,13 @@ protected:
 	/// Does the same operations as @a optimise, but should only be applied to a sub and
 	/// returns the replaced tags. Also takes an argument containing the tags of this assembly
 	/// that are referenced in a super-assembly.
-	std::map<u256, u256> const& optimiseInternal(OptimiserSettings const& _settings, std::set<size_t> _tagsReferencedFromOutside);
+	/// Sub-assemblies are only optimised concurrently if @a _concurrentSubs is true.
+	std::map<u256, u256> const& optimiseInternal(
+		OptimiserSettings const& _settings,
+		std::set<size_t> _tagsReferencedFromOutside,
+		util::ThreadPool* _threadPool,
+		bool _concurrentSubs
+	);
 
 	/// For EOF and legacy it calculates approximate size of "pure" code without data.
 	unsigned codeSize(unsigned subTagSize) const;
@@ -74,7 +74,7 @@ std::pair<std::string, std::string> AssemblyItem::nameAndData(langutil::EVMVersi
 	switch (type())
 	{
 	case Operation:
-		return {instructionInfo(instruction(), _evmVersion).name, m_data != nullptr ? toStringInHex(*m_data) : ""};
+		return {instructionInfo(instruction(), _evmVersion).name, ""};
 	case Push:
 		return {"PUSH", toStringInHex(data())};
 	case PushTag:
@@ -152,8 +152,8 @@ size_t AssemblyItem::bytesRequired(size_t _addressLength, langutil::EVMVersion _
 			immutableOccurrences = 1; // Assume one immut. ref.
 		else
 		{
-			solAssert(m_immutableOccurrences, "No immutable references. `bytesRequired()` called before assembly()?");
-			immutableOccurrences = m_immutableOccurrences.value();
+			solAssert(m_hasImmutableOccurrences, "No immutable references. `bytesRequired()` called before assembly()?");
+			immutableOccurrences = m_immutableOccurrences;
 		}
 
 		if (immutableOccurrences != 0)
@@ -164,7 +164,7 @@ size_t AssemblyItem::bytesRequired(size_t _addressLength, langutil::EVMVersion _
 			return 2;
 	}
 	case VerbatimBytecode:
-		return std::get<2>(*m_verbatimBytecode).size();
+		return std::get<2>(verbatim()).size();
 	case AuxDataLoadN:
 		return 1 + 2;
 	case UndefinedItem:
@@ -181,7 +181,7 @@ size_t AssemblyItem::arguments() const
 		// the same across all EVM versions except for the instruction name.
 		return static_cast<size_t>(instructionInfo(instruction(), EVMVersion()).args);
 	else if (type() == VerbatimBytecode)
-		return std::get<0>(*m_verbatimBytecode);
+		return std::get<0>(verbatim());
 	else if (type() == AssignImmutable)
 		return 2;
 	else
@@ -209,7 +209,7 @@ size_t AssemblyItem::returnValues() const
 	case Tag:
 		return 0;
 	case VerbatimBytecode:
-		return std::get<1>(*m_verbatimBytecode);
+		return std::get<1>(verbatim());
 	case AuxDataLoadN:
 		return 1;
 	case AssignImmutable:
@@ -338,7 +338,7 @@ std::string AssemblyItem::toAssemblyText(Assembly const& _assembly) const
 		assertThrow(false, AssemblyException, "Invalid assembly item.");
 		break;
 	case VerbatimBytecode:
-		text = std::string("verbatimbytecode_") + util::toHex(std::get<2>(*m_verbatimBytecode));
+		text = std::string("verbatimbytecode_") + util::toHex(std::get<2>(verbatim()));
 		break;
 	case AuxDataLoadN:
 		assertThrow(data() <= std::numeric_limits<size_t>::max(), AssemblyException, "Invalid auxdataloadn argument.");
@@ -430,10 +430,10 @@ size_t AssemblyItem::opcodeCount() const noexcept
 			// For n immutable occurrences the first (n - 1) occurrences will
 			// generate 5 opcodes and the last will generate 3 opcodes,
 			// because it is reusing the 2 top-most elements on the stack.
-			solAssert(m_immutableOccurrences, "");
+			solAssert(m_hasImmutableOccurrences, "");
 
-			if (m_immutableOccurrences.value() != 0)
-				return (*m_immutableOccurrences - 1) * 5 + 3;
+			if (m_immutableOccurrences != 0)
+				return (m_immutableOccurrences - 1) * 5 + 3;
 			else
 				return 2; // two POP's
 		default:
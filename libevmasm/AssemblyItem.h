@@ -29,9 +29,14 @@
 #include <libsolutil/Common.h>
 #include <libsolutil/Numeric.h>
 #include <libsolutil/Assertions.h>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <optional>
 #include <iostream>
 #include <sstream>
+#include <tuple>
+#include <variant>
 
 namespace solidity::evmasm
 {
@@ -67,7 +72,7 @@ using AssemblyItems = std::vector<AssemblyItem>;
 class AssemblyItem
 {
 public:
-	enum class JumpType { Ordinary, IntoFunction, OutOfFunction };
+	enum class JumpType: uint8_t { Ordinary, IntoFunction, OutOfFunction };
 
 	AssemblyItem(u256 _push, langutil::DebugData::ConstPtr _debugData = langutil::DebugData::create()):
 		AssemblyItem(Push, std::move(_push), std::move(_debugData)) { }
@@ -83,12 +88,12 @@ public:
 		if (m_type == Operation)
 			m_instruction = Instruction(uint8_t(_data));
 		else
-			m_data = std::make_shared<u256>(std::move(_data));
+			setData(_data);
 	}
 	explicit AssemblyItem(bytes _verbatimData, size_t _arguments, size_t _returnVariables):
 		m_type(VerbatimBytecode),
 		m_instruction{},
-		m_verbatimBytecode{{_arguments, _returnVariables, std::move(_verbatimData)}},
+		m_externalData{std::make_shared<ExternalData const>(Verbatim{_arguments, _returnVariables, std::move(_verbatimData)})},
 		m_debugData{langutil::DebugData::create()}
 	{}
 
@@ -109,8 +114,25 @@ public:
 	void setPushTagSubIdAndTag(size_t _subId, size_t _tag);
 
 	AssemblyItemType type() const { return m_type; }
-	u256 const& data() const { assertThrow(m_type != Operation, util::Exception, ""); return *m_data; }
-	void setData(u256 const& _data) { assertThrow(m_type != Operation, util::Exception, ""); m_data = std::make_shared<u256>(_data); }
+	u256 data() const
+	{
+		assertThrow(m_type != Operation, util::Exception, "");
+		return m_externalData ? std::get<u256>(*m_externalData) : u256(m_data);
+	}
+	void setData(u256 const& _data)
+	{
+		assertThrow(m_type != Operation, util::Exception, "");
+		if (_data <= std::numeric_limits<uint64_t>::max())
+		{
+			m_data = static_cast<uint64_t>(_data);
+			m_externalData.reset();
+		}
+		else
+		{
+			m_data = 0;
+			m_externalData = std::make_shared<ExternalData const>(_data);
+		}
+	}
 
 	/// This function is used in `Assembly::assemblyJSON`.
 	/// It returns the name & data of the current assembly item.
@@ -120,7 +142,7 @@ public:
 	/// of it's data.
 	std::pair<std::string, std::string> nameAndData(langutil::EVMVersion _evmVersion) const;
 
-	bytes const& verbatimData() const { assertThrow(m_type == VerbatimBytecode, util::Exception, ""); return std::get<2>(*m_verbatimBytecode); }
+	bytes const& verbatimData() const { assertThrow(m_type == VerbatimBytecode, util::Exception, ""); return std::get<2>(verbatim()); }
 
 	/// @returns the instruction of this item (only valid if type() == Operation)
 	Instruction instruction() const { assertThrow(m_type == Operation, util::Exception, ""); return m_instruction; }
@@ -133,9 +155,12 @@ public:
 		if (type() == Operation)
 			return instruction() == _other.instruction();
 		else if (type() == VerbatimBytecode)
-			return *m_verbatimBytecode == *_other.m_verbatimBytecode;
+			return verbatim() == _other.verbatim();
+		else if (m_externalData || _other.m_externalData)
+			// Data is only stored externally if it does not fit into m_data.
+			return m_externalData && _other.m_externalData && data() == _other.data();
 		else
-			return data() == _other.data();
+			return m_data == _other.m_data;
 	}
 	bool operator!=(AssemblyItem const& _other) const { return !operator==(_other); }
 	/// Less-than operator compatible with operator==.
@@ -146,9 +171,11 @@ public:
 		else if (type() == Operation)
 			return instruction() < _other.instruction();
 		else if (type() == VerbatimBytecode)
-			return *m_verbatimBytecode < *_other.m_verbatimBytecode;
-		else
+			return verbatim() < _other.verbatim();
+		else if (m_externalData || _other.m_externalData)
 			return data() < _other.data();
+		else
+			return m_data < _other.m_data;
 	}
 
 	/// Shortcut that avoids constructing an AssemblyItem just to perform the comparison.
@@ -206,31 +233,45 @@ public:
 	JumpType getJumpType() const { return m_jumpType; }
 	std::string getJumpTypeAsString() const;
 
-	void setPushedValue(u256 const& _value) const { m_pushedValue = std::make_shared<u256>(_value); }
-	u256 const* pushedValue() const { return m_pushedValue.get(); }
+	void setPushedValue(size_t _value) const { m_pushedValue = _value; m_hasPushedValue = true; }
+	std::optional<u256> pushedValue() const { return m_hasPushedValue ? std::make_optional<u256>(m_pushedValue) : std::nullopt; }
 
 	std::string toAssemblyText(Assembly const& _assembly) const;
 
 	size_t m_modifierDepth = 0;
 
-	void setImmutableOccurrences(size_t _n) const { m_immutableOccurrences = _n; }
+	void setImmutableOccurrences(size_t _n) const { m_immutableOccurrences = _n; m_hasImmutableOccurrences = true; }
 
 private:
+	/// Number of arguments, number of return variables and bytecode of a VerbatimBytecode item.
+	using Verbatim = std::tuple<size_t, size_t, bytes>;
+	/// Data that does not fit into the item itself. It is immutable, so that copies of the item,
+	/// which are frequent during optimisation, can share it.
+	using ExternalData = std::variant<u256, Verbatim>;
+
+	Verbatim const& verbatim() const { return std::get<Verbatim>(*m_externalData); }
+
 	size_t opcodeCount() const noexcept;
 
+	// The members are ordered to avoid padding. Most items are operations or pushes of small
+	// values, which do not need any memory beyond the item itself.
 	AssemblyItemType m_type;
 	Instruction m_instruction; ///< Only valid if m_type == Operation
-	std::shared_ptr<u256> m_data; ///< Only valid if m_type != Operation
-	/// If m_type == VerbatimBytecode, this holds number of arguments, number of
-	/// return variables and verbatim bytecode.
-	std::optional<std::tuple<size_t, size_t, bytes>> m_verbatimBytecode;
-	langutil::DebugData::ConstPtr m_debugData;
 	JumpType m_jumpType = JumpType::Ordinary;
+	mutable bool m_hasPushedValue = false;
+	mutable bool m_hasImmutableOccurrences = false;
+	/// The data if m_type != Operation and it fits into 64 bits, zero otherwise.
+	uint64_t m_data = 0;
+	/// The data if m_type != Operation and it does not fit into m_data, or the verbatim
+	/// bytecode if m_type == VerbatimBytecode.
+	std::shared_ptr<ExternalData const> m_externalData;
+	langutil::DebugData::ConstPtr m_debugData;
 	/// Pushed value for operations with data to be determined during assembly stage,
-	/// e.g. PushSubSize, PushTag, PushSub, etc.
-	mutable std::shared_ptr<u256> m_pushedValue;
-	/// Number of PushImmutable's with the same hash. Only used for AssignImmutable.
-	mutable std::optional<size_t> m_immutableOccurrences;
+	/// e.g. PushSubSize, PushTag, PushSub, etc. Only valid if m_hasPushedValue is set.
+	mutable size_t m_pushedValue = 0;
+	/// Number of PushImmutable's with the same hash. Only used for AssignImmutable and
+	/// only valid if m_hasImmutableOccurrences is set.
+	mutable size_t m_immutableOccurrences = 0;
 };
 
 inline size_t bytesRequired(AssemblyItems const& _items, size_t _addressLength, langutil::EVMVersion _evmVersion, Precision _precision = Precision::Precise)
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <iterator>
 #include <map>
 #include <ostream>
 #include <set>
@@ -74,6 +75,11 @@ public:
 	template <class AssemblyItemIterator>
 	AssemblyItemIterator feedItems(AssemblyItemIterator _iterator, AssemblyItemIterator _end, bool _msizeImportant);
 
+	/// @returns the iterator pointing at the first item after the chunk that starts at @a _iterator
+	/// and would be consumed by a single call to feedItems, without analysing the chunk.
+	template <class AssemblyItemIterator>
+	static AssemblyItemIterator chunkEnd(AssemblyItemIterator _iterator, AssemblyItemIterator _end, bool _msizeImportant);
+
 	/// @returns the resulting items after optimization.
 	AssemblyItems getOptimizedItems();
 
@@ -179,16 +185,37 @@ AssemblyItemIterator CommonSubexpressionEliminator::feedItems(
 )
 {
 	assertThrow(!m_breakingItem, OptimizerException, "Invalid use of CommonSubexpressionEliminator.");
+	AssemblyItemIterator end = chunkEnd(_iterator, _end, _msizeImportant);
+	for (; _iterator != end; ++_iterator)
+		// Only the last item of a chunk can break the basic block.
+		if (std::next(_iterator) == end && SemanticInformation::breaksCSEAnalysisBlock(*_iterator, _msizeImportant))
+			m_breakingItem = &(*_iterator);
+		else
+			feedItem(*_iterator);
+	return _iterator;
+}
+
+template <class AssemblyItemIterator>
+AssemblyItemIterator CommonSubexpressionEliminator::chunkEnd(
+	AssemblyItemIterator _iterator,
+	AssemblyItemIterator _end,
+	bool _msizeImportant
+)
+{
 	unsigned const maxChunkSize = 2000;
 	unsigned chunkSize = 0;
-	for (
-		;
-		_iterator != _end && !SemanticInformation::breaksCSEAnalysisBlock(*_iterator, _msizeImportant) && chunkSize < maxChunkSize;
-		++_iterator, ++chunkSize
+	while (
+		_iterator != _end &&
+		!SemanticInformation::breaksCSEAnalysisBlock(*_iterator, _msizeImportant) &&
+		chunkSize < maxChunkSize
 	)
-		feedItem(*_iterator);
+	{
+		++_iterator;
+		++chunkSize;
+	}
+	// The item that breaks the basic block is part of the chunk.
 	if (_iterator != _end && chunkSize < maxChunkSize)
-		m_breakingItem = &(*_iterator++);
+		++_iterator;
 	return _iterator;
 }
 
@@ -54,8 +54,12 @@ bool ExpressionClasses::Expression::operator==(ExpressionClasses::Expression con
 			std::tie(otherInstr, _other.arguments, _other.sequenceNumber);
 	}
 	else
-		return std::tie(item->data(), arguments, sequenceNumber) ==
-			std::tie(_other.item->data(), _other.arguments, _other.sequenceNumber);
+	{
+		u256 data = item->data();
+		u256 otherData = _other.item->data();
+		return std::tie(data, arguments, sequenceNumber) ==
+			std::tie(otherData, _other.arguments, _other.sequenceNumber);
+	}
 }
 
 size_t ExpressionClasses::Expression::ExpressionHash::operator()(Expression const& _expression) const
@@ -68,7 +72,10 @@ size_t ExpressionClasses::Expression::ExpressionHash::operator()(Expression cons
 	if (type == Operation)
 		boost::hash_combine(seed, _expression.item->instruction());
 	else
-		boost::hash_combine(seed, _expression.item->data());
+	{
+		u256 data = _expression.item->data();
+		boost::hash_combine(seed, data);
+	}
 
 	boost::hash_range(seed, _expression.arguments.begin(), _expression.arguments.end());
 	boost::hash_combine(seed, _expression.sequenceNumber);
@@ -154,7 +161,7 @@ bool ExpressionClasses::knownToBeDifferent(ExpressionClasses::Id _a, ExpressionC
 bool ExpressionClasses::knownToBeDifferentBy32(ExpressionClasses::Id _a, ExpressionClasses::Id _b)
 {
 	// Try to simplify "_a - _b" and return true iff the value is at least 32 away from zero.
-	u256 const* v = knownConstant(find(Instruction::SUB, {_a, _b}));
+	std::optional<u256> v = knownConstant(find(Instruction::SUB, {_a, _b}));
 	// forbidden interval is ["-31", 31]
 	return v && *v + 31 > u256(62);
 }
@@ -169,14 +176,14 @@ bool ExpressionClasses::knownNonZero(Id _c)
 	return Pattern(u256(0)).matches(representative(find(Instruction::ISZERO, {_c})), *this);
 }
 
-u256 const* ExpressionClasses::knownConstant(Id _c)
+std::optional<u256> ExpressionClasses::knownConstant(Id _c)
 {
 	std::map<unsigned, Expression const*> matchGroups;
 	Pattern constant(Push);
 	constant.setMatchGroup(1, matchGroups);
 	if (!constant.matches(representative(_c), *this))
-		return nullptr;
-	return &constant.d();
+		return std::nullopt;
+	return constant.d();
 }
 
 AssemblyItem const* ExpressionClasses::storeItem(AssemblyItem const& _item)
@@ -204,7 +211,8 @@ std::string ExpressionClasses::fullDAGToString(ExpressionClasses::Id _id) const
 
 ExpressionClasses::Id ExpressionClasses::tryToSimplify(Expression const& _expr)
 {
-	static Rules rules;
+	// The rules keep the state of the current match, so each thread needs its own copy.
+	static thread_local Rules rules;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
 	if (
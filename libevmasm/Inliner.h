@@ -53,7 +53,9 @@ public:
 	}
 	virtual ~Inliner() = default;
 
-	void optimise();
+	/// Inlines the blocks that are considered worth it.
+	/// @returns true if anything was inlined.
+	bool optimise();
 
 private:
 	struct InlinableBlock
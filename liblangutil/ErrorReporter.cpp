@@ -77,6 +77,19 @@ void ErrorReporter::error(ErrorId _errorId, Error::Type _type, SourceLocation co
 	m_errorList.push_back(std::make_shared<Error>(_errorId, _type, _description, _location, _secondaryLocation));
 }
 
+void ErrorReporter::report(ErrorList const& _errorList)
+{
+	for (auto const& error: _errorList)
+	{
+		solAssert(error);
+		ErrorId const errorId = error->errorId();
+		if (errorId == 4591_error || errorId == 2833_error || errorId == 4013_error)
+			continue;
+		if (!checkForExcessiveErrors(error->type()))
+			m_errorList.push_back(error);
+	}
+}
+
 bool ErrorReporter::hasExcessiveErrors() const
 {
 	return m_errorCount > c_maxErrorsAllowed;
@@ -53,6 +53,11 @@ public:
 		m_errorList += _errorList;
 	}
 
+	/// Reports the errors in @a _errorList in order, subject to the limits on the number of errors, warnings
+	/// and infos of this reporter. Notes about exceeding these limits contained in @a _errorList are skipped.
+	/// @throws FatalError if the limit on the number of errors is exceeded.
+	void report(ErrorList const& _errorList);
+
 	void warning(ErrorId _error, std::string const& _description);
 
 	void warning(ErrorId _error, SourceLocation const& _location, std::string const& _description);
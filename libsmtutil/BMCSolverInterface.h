@@ -20,6 +20,8 @@
 
 #include <libsmtutil/SolverInterface.h>
 
+#include <functional>
+
 namespace solidity::smtutil
 {
 
@@ -44,6 +46,21 @@ public:
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
 
+	/// @returns tasks that send the query check() would send for the current assertions to the
+	/// solvers and remember the responses, so that a subsequent call to check() with the same
+	/// assertions does not have to wait for the solvers.
+	/// The tasks may run concurrently with each other on any thread, but not concurrently
+	/// with other member functions of the solver.
+	virtual std::vector<std::function<void()>> prefetch(std::vector<Expression> const& /*_expressionsToEvaluate*/) { return {}; }
+
+	/// Asks a call to check() that is running on another thread to give up as soon as possible.
+	/// The interrupted call returns an unspecified result, which should be discarded.
+	/// The cancellation also applies to all later calls to check() until resetCancellation() is called.
+	virtual void cancel() {}
+	/// Lets calls to check() run to completion again after a call to cancel().
+	/// Must not be called concurrently with check() or cancel().
+	virtual void resetCancellation() {}
+
 protected:
 	std::optional<unsigned> m_queryTimeout;
 };
@@ -59,6 +59,7 @@ void CHCSmtLib2Interface::reset()
 	m_unhandledQueries.clear();
 	m_commands.clear();
 	m_context.clear();
+	m_queryContextRelations.clear();
 	createHeader();
 	m_context.setTupleDeclarationCallback([&](TupleSort const& _tupleSort){
 		m_commands.declareTuple(
@@ -68,6 +69,8 @@ void CHCSmtLib2Interface::reset()
 				| ranges::views::transform([&](SortPointer const& _sort){ return m_context.toSmtLibSort(_sort); })
 				| ranges::to<std::vector>()
 		);
+		// The sort stays known to the context, so its declaration has to outlive the query contexts.
+		m_commands.hoistLastCommand();
 	});
 }
 
@@ -83,6 +86,8 @@ void CHCSmtLib2Interface::registerRelation(Expression const& _expr)
 	std::string codomain = toSmtLibSort(fSort->codomain);
 	m_commands.declareFunction(_expr.name, domain, codomain);
 	m_context.declare(_expr.name, _expr.sort);
+	if (!m_queryContextRelations.empty())
+		m_queryContextRelations.back().push_back(_expr.name);
 }
 
 void CHCSmtLib2Interface::addRule(Expression const& _expr, std::string const& /*_name*/)
@@ -90,6 +95,21 @@ void CHCSmtLib2Interface::addRule(Expression const& _expr, std::string const& /*
 	m_commands.assertion("(forall" + forall(_expr) + '\n' + m_context.toSExpr(_expr) + ")\n");
 }
 
+void CHCSmtLib2Interface::pushQueryContext()
+{
+	m_commands.push();
+	m_queryContextRelations.emplace_back();
+}
+
+void CHCSmtLib2Interface::popQueryContext()
+{
+	smtAssert(!m_queryContextRelations.empty());
+	m_commands.pop();
+	for (auto const& name: m_queryContextRelations.back())
+		m_context.undeclare(name);
+	m_queryContextRelations.pop_back();
+}
+
 CHCSolverInterface::QueryResult CHCSmtLib2Interface::query(Expression const& _block)
 {
 	std::string query = dumpQuery(_block);
@@ -121,6 +141,13 @@ CHCSolverInterface::QueryResult CHCSmtLib2Interface::query(Expression const& _bl
 
 }
 
+std::vector<std::function<void()>> CHCSmtLib2Interface::prefetch(Expression const& _block)
+{
+	if (!m_smtCallback)
+		return {};
+	return {[this, query = dumpQuery(_block)]() { prefetchResponse(query); }};
+}
+
 void CHCSmtLib2Interface::declareVariable(std::string const& _name, SortPointer const& _sort)
 {
 	smtAssert(_sort);
@@ -175,6 +202,15 @@ std::string CHCSmtLib2Interface::querySolver(std::string const& _input)
 	util::h256 inputHash = util::keccak256(_input);
 	if (m_queryResponses.count(inputHash))
 		return m_queryResponses.at(inputHash);
+	{
+		std::lock_guard<std::mutex> lock(m_prefetchedResponsesMutex);
+		if (auto it = m_prefetchedResponses.find(inputHash); it != m_prefetchedResponses.end())
+		{
+			std::string response = std::move(it->second);
+			m_prefetchedResponses.erase(it);
+			return response;
+		}
+	}
 
 	if (m_smtCallback)
 	{
@@ -187,6 +223,22 @@ std::string CHCSmtLib2Interface::querySolver(std::string const& _input)
 	return "unknown\n";
 }
 
+std::optional<std::string> CHCSmtLib2Interface::prefetchResponse(std::string const& _input)
+{
+	util::h256 inputHash = util::keccak256(_input);
+	if (m_queryResponses.count(inputHash))
+		return m_queryResponses.at(inputHash);
+
+	smtAssert(m_smtCallback);
+	auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _input);
+	if (!result.success)
+		return std::nullopt;
+
+	std::lock_guard<std::mutex> lock(m_prefetchedResponsesMutex);
+	m_prefetchedResponses[inputHash] = result.responseOrErrorMessage;
+	return result.responseOrErrorMessage;
+}
+
 std::string CHCSmtLib2Interface::dumpQuery(Expression const& _expr)
 {
 	return m_commands.toString() + createQueryAssertion(_expr.name) + '\n' + "(check-sat)" + '\n';
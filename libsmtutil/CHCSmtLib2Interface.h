@@ -27,6 +27,8 @@
 #include <libsmtutil/SMTLib2Interface.h>
 #include <libsmtutil/SMTLib2Parser.h>
 
+#include <mutex>
+
 namespace solidity::smtutil
 {
 
@@ -45,10 +47,15 @@ public:
 
 	void addRule(Expression const& _expr, std::string const& _name) override;
 
+	void pushQueryContext() override;
+	void popQueryContext() override;
+
 	/// Takes a function application _expr and checks for reachability.
 	/// @returns solving result, an invariant, and counterexample graph, if possible.
 	QueryResult query(Expression const& _expr) override;
 
+	std::vector<std::function<void()>> prefetch(Expression const& _expr) override;
+
 	void declareVariable(std::string const& _name, SortPointer const& _sort) override;
 
 	std::string dumpQuery(Expression const& _expr);
@@ -94,6 +101,11 @@ protected:
 	/// Communicates with the solver via the callback. Throws SMTSolverError on error.
 	virtual std::string querySolver(std::string const& _input);
 
+	/// Asks the solver @a _input via the callback and keeps the response for a later querySolver().
+	/// Can be called concurrently from the tasks returned by prefetch().
+	/// @returns the response, if any.
+	std::optional<std::string> prefetchResponse(std::string const& _input);
+
 	/// Translates CHC solver response with a model to our representation of invariants. Returns None on error.
 	std::optional<smtutil::Expression> invariantsFromSolverResponse(std::string const& _response) const;
 
@@ -101,10 +113,16 @@ protected:
 
 	SMTLib2Commands m_commands;
 	SMTLib2Context m_context;
+	/// Names of the relations declared in each open query context.
+	std::vector<std::vector<std::string>> m_queryContextRelations;
 
 	std::map<util::h256, std::string> m_queryResponses;
 	std::vector<std::string> m_unhandledQueries;
 
+	/// Responses obtained by the tasks returned from prefetch() that were not used yet.
+	std::map<util::h256, std::string> m_prefetchedResponses;
+	std::mutex m_prefetchedResponsesMutex;
+
 	frontend::ReadCallback::Callback m_smtCallback;
 };
 
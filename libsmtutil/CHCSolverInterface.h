@@ -24,6 +24,7 @@
 
 #include <libsmtutil/SolverInterface.h>
 
+#include <functional>
 #include <map>
 #include <vector>
 
@@ -42,6 +43,12 @@ public:
 	/// Needs to bound all vars as universally quantified.
 	virtual void addRule(Expression const& _expr, std::string const& _name) = 0;
 
+	/// Opens a query context. The relations and rules added until the matching
+	/// popQueryContext() are only part of the queries formed in between.
+	virtual void pushQueryContext() = 0;
+	/// Removes the relations and rules added since the matching pushQueryContext().
+	virtual void popQueryContext() = 0;
+
 	using CexNode = Expression;
 	struct CexGraph
 	{
@@ -59,6 +66,13 @@ public:
 	/// @returns solving result, an invariant, and counterexample graph, if possible.
 	virtual QueryResult query(Expression const& _expr) = 0;
 
+	/// @returns tasks that ask the solver the reachability query for @a _expr as query() would
+	/// and remember the response, so that a subsequent call to query() does not have to wait
+	/// for the solver. The query is formed right away, i.e. it only includes the rules added
+	/// until this call. The tasks may run concurrently with each other on any thread, but not
+	/// concurrently with other member functions of the solver.
+	virtual std::vector<std::function<void()>> prefetch(Expression const& /*_expr*/) { return {}; }
+
 protected:
 	std::optional<unsigned> m_queryTimeout;
 };
@@ -49,6 +49,12 @@ void SMTLib2Context::declare(std::string const& _name, SortPointer const& _sort)
 	smtAssert(inserted, "Trying to redeclare SMT function!");
 }
 
+void SMTLib2Context::undeclare(std::string const& _name)
+{
+	auto erased = m_functions.erase(_name);
+	smtAssert(erased == 1, "Trying to undeclare unknown SMT function!");
+}
+
 SortPointer SMTLib2Context::getDeclaredSort(std::string const& _name) const
 {
 	smtAssert(isDeclared(_name));
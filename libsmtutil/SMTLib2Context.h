@@ -73,6 +73,7 @@ public:
 
 	bool isDeclared(std::string const& _name) const;
 	void declare(std::string const& _name, SortPointer const& _sort);
+	void undeclare(std::string const& _name);
 	SortPointer getDeclaredSort(std::string const& _name) const;
 
 	SortId resolve(SortPointer const& _sort);
@@ -212,17 +212,71 @@ std::string SMTLib2Interface::checkSatAndGetValuesCommand(std::vector<Expression
 	return command;
 }
 
+std::vector<std::function<void()>> SMTLib2Interface::prefetch(std::vector<Expression> const& _expressionsToEvaluate)
+{
+	if (!m_smtCallback)
+		return {};
+	std::string query = dumpQuery(_expressionsToEvaluate);
+	h256 queryHash = keccak256(query);
+	if (m_queryResponses.count(queryHash))
+		return {};
+	return {[this, query = std::move(query), queryHash]() {
+		setupSmtCallback();
+		auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), query);
+		if (result.success)
+		{
+			std::lock_guard<std::mutex> lock(m_prefetchedResponsesMutex);
+			m_prefetchedResponses[queryHash] = std::move(result.responseOrErrorMessage);
+		}
+	}};
+}
+
+void SMTLib2Interface::cancel()
+{
+	std::lock_guard<std::mutex> lock(m_cancellationMutex);
+	m_cancelled = true;
+	if (m_queryThread)
+		cancelSmtCallback(*m_queryThread);
+}
+
+void SMTLib2Interface::resetCancellation()
+{
+	std::lock_guard<std::mutex> lock(m_cancellationMutex);
+	m_cancelled = false;
+}
+
 std::string SMTLib2Interface::querySolver(std::string const& _input)
 {
 	h256 inputHash = keccak256(_input);
 	if (m_queryResponses.count(inputHash))
 		return m_queryResponses.at(inputHash);
+	{
+		std::lock_guard<std::mutex> lock(m_prefetchedResponsesMutex);
+		if (auto it = m_prefetchedResponses.find(inputHash); it != m_prefetchedResponses.end())
+		{
+			std::string response = std::move(it->second);
+			m_prefetchedResponses.erase(it);
+			return response;
+		}
+	}
 	if (m_smtCallback)
 	{
-		setupSmtCallback();
+		{
+			std::lock_guard<std::mutex> lock(m_cancellationMutex);
+			if (m_cancelled)
+				return "unknown\n";
+			// Selecting the solver resets the cancellation of the previous queries of this thread.
+			setupSmtCallback();
+			m_queryThread = std::this_thread::get_id();
+		}
 		auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _input);
+		std::lock_guard<std::mutex> lock(m_cancellationMutex);
+		m_queryThread.reset();
 		if (result.success)
 			return result.responseOrErrorMessage;
+		// Cancelled queries were not unhandled, their result is just not needed.
+		if (m_cancelled)
+			return "unknown\n";
 	}
 	m_unhandledQueries.push_back(_input);
 	return "unknown\n";
@@ -246,6 +300,17 @@ void SMTLib2Commands::pop() {
 		m_commands.pop_back();
 }
 
+void SMTLib2Commands::hoistLastCommand() {
+	smtAssert(!m_commands.empty());
+	if (m_frameLimits.empty())
+		return;
+	std::string command = std::move(m_commands.back());
+	m_commands.pop_back();
+	m_commands.insert(m_commands.begin() + static_cast<std::ptrdiff_t>(m_frameLimits.front()), std::move(command));
+	for (auto& limit: m_frameLimits)
+		++limit;
+}
+
 std::string SMTLib2Commands::toString() const {
 	return boost::algorithm::join(m_commands, "\n");
 }
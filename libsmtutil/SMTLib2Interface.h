@@ -29,8 +29,11 @@
 
 #include <cstdio>
 #include <map>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace solidity::smtutil
@@ -58,6 +61,9 @@ public:
 		std::vector<std::string> const& _memberSorts
 	);
 
+	/// Moves the last command in front of all open frames, so that pop() does not remove it.
+	void hoistLastCommand();
+
 	[[nodiscard]] std::string toString() const;
 private:
 	std::vector<std::string> m_commands;
@@ -87,6 +93,10 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	std::vector<std::function<void()>> prefetch(std::vector<Expression> const& _expressionsToEvaluate) override;
+
+	void cancel() override;
+	void resetCancellation() override;
 
 	std::vector<std::string> unhandledQueries() override { return m_unhandledQueries; }
 
@@ -99,6 +109,8 @@ public:
 
 protected:
 	virtual void setupSmtCallback() {}
+	/// Terminates the query the callback is currently answering for this solver on @a _queryThread.
+	virtual void cancelSmtCallback(std::thread::id /*_queryThread*/) {}
 
 	void declareFunction(std::string const& _name, SortPointer const& _sort);
 
@@ -113,7 +125,17 @@ protected:
 	std::map<util::h256, std::string> m_queryResponses;
 	std::vector<std::string> m_unhandledQueries;
 
+	/// Responses obtained by the tasks returned from prefetch() that were not used yet.
+	std::map<util::h256, std::string> m_prefetchedResponses;
+	std::mutex m_prefetchedResponsesMutex;
+
 	frontend::ReadCallback::Callback m_smtCallback;
+	/// Protects m_queryThread and m_cancelled, so that a cancellation either happens before the
+	/// callback is set up for a query and prevents the query or cancels the query after it was set up.
+	std::mutex m_cancellationMutex;
+	/// The thread of the query the callback is currently answering, if any.
+	std::optional<std::thread::id> m_queryThread;
+	bool m_cancelled = false;
 };
 
 }
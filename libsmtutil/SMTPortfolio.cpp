@@ -20,6 +20,10 @@
 
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <condition_variable>
+#include <future>
+#include <mutex>
+
 using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::frontend;
@@ -27,10 +31,18 @@ using namespace solidity::smtutil;
 
 SMTPortfolio::SMTPortfolio(
 	std::vector<std::unique_ptr<BMCSolverInterface>> _solvers,
-	std::optional<unsigned> _queryTimeout
+	std::optional<unsigned> _queryTimeout,
+	bool _raceSolvers
 ):
 	BMCSolverInterface(_queryTimeout), m_solvers(std::move(_solvers))
-{}
+{
+#ifndef EMSCRIPTEN_BUILD
+	if (_raceSolvers && m_solvers.size() > 1)
+		m_threadPool = std::make_unique<ThreadPool>(m_solvers.size());
+#else
+	(void)_raceSolvers;
+#endif
+}
 
 
 void SMTPortfolio::reset()
@@ -93,9 +105,16 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  *   when it is told that this is a hard query to solve.
  *
  *   If all solvers return ERROR, the result is ERROR.
+ *
+ * If the solvers race against each other, the rules above are applied to the results in the order
+ * in which the solvers finish, except that the first answer is final and cancels the remaining
+ * solvers, so conflicting answers are not detected.
 */
 std::pair<CheckResult, std::vector<std::string>> SMTPortfolio::check(std::vector<Expression> const& _expressionsToEvaluate)
 {
+	if (m_threadPool)
+		return race(_expressionsToEvaluate);
+
 	CheckResult lastResult = CheckResult::ERROR;
 	std::vector<std::string> finalValues;
 	for (auto const& s: m_solvers)
@@ -122,6 +141,72 @@ std::pair<CheckResult, std::vector<std::string>> SMTPortfolio::check(std::vector
 	return std::make_pair(lastResult, finalValues);
 }
 
+std::vector<std::function<void()>> SMTPortfolio::prefetch(std::vector<Expression> const& _expressionsToEvaluate)
+{
+	std::vector<std::function<void()>> tasks;
+	for (auto const& solver: m_solvers)
+		tasks += solver->prefetch(_expressionsToEvaluate);
+	return tasks;
+}
+
+std::pair<CheckResult, std::vector<std::string>> SMTPortfolio::race(std::vector<Expression> const& _expressionsToEvaluate)
+{
+	std::mutex mutex;
+	std::condition_variable solverFinished;
+	std::vector<bool> finished(m_solvers.size(), false);
+	size_t finishedCount = 0;
+	std::optional<std::pair<CheckResult, std::vector<std::string>>> answer;
+	CheckResult lastResult = CheckResult::ERROR;
+
+	// Cancellations only apply to the race they were issued for.
+	for (auto const& solver: m_solvers)
+		solver->resetCancellation();
+
+	std::vector<std::future<void>> futures;
+	for (size_t i = 0; i < m_solvers.size(); ++i)
+		futures.emplace_back(m_threadPool->submit([&, i]() {
+			std::pair<CheckResult, std::vector<std::string>> result{CheckResult::ERROR, {}};
+			ScopeGuard notifyFinished([&]() {
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					finished[i] = true;
+					++finishedCount;
+					if (!answer)
+					{
+						if (solverAnswered(result.first))
+							answer = std::move(result);
+						else if (result.first == CheckResult::UNKNOWN)
+							lastResult = result.first;
+					}
+				}
+				solverFinished.notify_all();
+			});
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (answer)
+					return;
+			}
+			result = m_solvers[i]->check(_expressionsToEvaluate);
+		}));
+
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		solverFinished.wait(lock, [&]() { return answer || finishedCount == m_solvers.size(); });
+		for (size_t i = 0; i < m_solvers.size(); ++i)
+			if (!finished[i])
+				m_solvers[i]->cancel();
+	}
+
+	// The cancelled solvers still have to be waited for, since they must not be
+	// used concurrently with the next query.
+	for (auto& future: futures)
+		future.get();
+
+	if (answer)
+		return std::move(*answer);
+	return {lastResult, {}};
+}
+
 std::vector<std::string> SMTPortfolio::unhandledQueries()
 {
 	// This code assumes that the constructor guarantees that
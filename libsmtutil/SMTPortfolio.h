@@ -22,8 +22,10 @@
 #include <libsmtutil/BMCSolverInterface.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolutil/FixedHash.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace solidity::smtutil
@@ -34,6 +36,8 @@ namespace solidity::smtutil
  * propagating the functionalities to all solvers.
  * It also checks whether different solvers give conflicting answers
  * to SMT queries.
+ * Alternatively, the solvers can race against each other, in which case the first
+ * definitive answer is used and the remaining solvers are cancelled.
  */
 class SMTPortfolio: public BMCSolverInterface
 {
@@ -42,7 +46,11 @@ public:
 	SMTPortfolio(SMTPortfolio const&) = delete;
 	SMTPortfolio& operator=(SMTPortfolio const&) = delete;
 
-	SMTPortfolio(std::vector<std::unique_ptr<BMCSolverInterface>> solvers, std::optional<unsigned> _queryTimeout);
+	SMTPortfolio(
+		std::vector<std::unique_ptr<BMCSolverInterface>> solvers,
+		std::optional<unsigned> _queryTimeout,
+		bool _raceSolvers = false
+	);
 
 	void reset() override;
 
@@ -54,6 +62,7 @@ public:
 	void addAssertion(Expression const& _expr) override;
 
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	std::vector<std::function<void()>> prefetch(std::vector<Expression> const& _expressionsToEvaluate) override;
 
 	std::vector<std::string> unhandledQueries() override;
 	size_t solvers() override { return m_solvers.size(); }
@@ -63,7 +72,12 @@ public:
 private:
 	static bool solverAnswered(CheckResult result);
 
+	/// Queries all solvers concurrently and returns the first answer.
+	std::pair<CheckResult, std::vector<std::string>> race(std::vector<Expression> const& _expressionsToEvaluate);
+
 	std::vector<std::unique_ptr<BMCSolverInterface>> m_solvers;
+	/// One thread per solver if the solvers race against each other, otherwise null.
+	std::unique_ptr<util::ThreadPool> m_threadPool;
 
 	std::vector<Expression> m_assertions;
 };
@@ -325,6 +325,15 @@ ContractDefinitionAnnotation& ContractDefinition::annotation() const
 	return initAnnotation<ContractDefinitionAnnotation>();
 }
 
+void ContractDefinition::clearAnnotation()
+{
+	ASTNode::clearAnnotation();
+	// The interface functions and events depend on the inheritance hierarchy and the types.
+	for (auto& interfaceFunctionList: m_interfaceFunctionList)
+		interfaceFunctionList.reset();
+	m_interfaceEvents.reset();
+}
+
 ContractDefinition const* ContractDefinition::superContract(ContractDefinition const& _mostDerivedContract) const
 {
 	auto const& hierarchy = _mostDerivedContract.annotation().linearizedBaseContracts;
@@ -127,7 +127,13 @@ public:
 	virtual bool experimentalSolidityOnly() const { return false; }
 
 protected:
-	size_t const m_id = 0;
+	friend class Parser;
+
+	/// Not const, since the parser shifts the IDs of source units parsed independently of each other.
+	size_t m_id = 0;
+
+	/// Discards the annotation and everything derived from it, so that the node can be analyzed again.
+	virtual void clearAnnotation() { m_annotation.reset(); }
 
 	template <class T>
 	T& initAnnotation() const
@@ -584,6 +590,9 @@ public:
 	/// @returns the next constructor in the inheritance hierarchy.
 	FunctionDefinition const* nextConstructor(ContractDefinition const& _mostDerivedContract) const;
 
+protected:
+	void clearAnnotation() override;
+
 private:
 	std::multimap<std::string, FunctionDefinition const*> const& definedFunctionsByName() const;
 
@@ -37,18 +37,27 @@ namespace solidity::frontend
 class Compiler
 {
 public:
-	Compiler(langutil::EVMVersion _evmVersion, RevertStrings _revertStrings, OptimiserSettings _optimiserSettings):
+	/// @arg _inlineAssemblyCache if given, is used to share parsed inline assembly snippets with
+	/// the compilers of other contracts
+	Compiler(
+		langutil::EVMVersion _evmVersion,
+		RevertStrings _revertStrings,
+		OptimiserSettings _optimiserSettings,
+		std::shared_ptr<InlineAssemblyCache> _inlineAssemblyCache = nullptr
+	):
 		m_optimiserSettings(std::move(_optimiserSettings)),
-		m_runtimeContext(_evmVersion, _revertStrings),
-		m_context(_evmVersion, _revertStrings, &m_runtimeContext)
+		m_runtimeContext(_evmVersion, _revertStrings, nullptr, _inlineAssemblyCache),
+		m_context(_evmVersion, _revertStrings, &m_runtimeContext, std::move(_inlineAssemblyCache))
 	{ }
 
 	/// Compiles a contract.
 	/// @arg _metadata contains the to be injected metadata CBOR
+	/// @arg _threadPool if given, is used to optimise the assembly concurrently
 	void compileContract(
 		ContractDefinition const& _contract,
 		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> const& _otherCompilers,
-		bytes const& _metadata
+		bytes const& _metadata,
+		util::ThreadPool* _threadPool = nullptr
 	);
 	/// @returns Entire assembly.
 	evmasm::Assembly const& assembly() const { return m_context.assembly(); }
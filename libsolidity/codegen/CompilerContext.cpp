@@ -388,6 +388,12 @@ void CompilerContext::appendInlineAssembly(
 {
 	unsigned startStackHeight = stackHeight();
 
+	// Snippets that are not system-level are parsed without source locations, so that they can be
+	// reused for other nodes. Their assembly items get the location of the current node instead.
+	std::optional<langutil::SourceLocation> locationOverride;
+	if (!_system)
+		locationOverride = m_asm->currentSourceLocation();
+
 	std::set<yul::YulName> externallyUsedIdentifiers;
 	for (auto const& fun: _externallyUsedFunctions)
 		externallyUsedIdentifiers.insert(yul::YulName(fun));
@@ -421,7 +427,7 @@ void CompilerContext::appendInlineAssembly(
 		if (stackDiff < 1 || stackDiff > 16)
 			BOOST_THROW_EXCEPTION(
 				StackTooDeepError() <<
-				errinfo_sourceLocation(nativeLocationOf(_identifier)) <<
+				errinfo_sourceLocation(locationOverride ? *locationOverride : nativeLocationOf(_identifier)) <<
 				util::errinfo_comment(util::stackTooDeepString)
 			);
 		if (_context == yul::IdentifierContext::RValue)
@@ -433,18 +439,92 @@ void CompilerContext::appendInlineAssembly(
 		}
 	};
 
+	yul::EVMDialect const& dialect = yul::EVMDialect::strictAssemblyForEVM(m_evmVersion, std::nullopt);
+	// Several optimizer steps cannot handle externally supplied stack variables,
+	// so we essentially only optimize the ABI functions.
+	bool const optimize = _optimiserSettings.runYulOptimiser && _localVariables.empty();
+
+	InlineAssemblyCache::Key cacheKey{
+		_localVariables,
+		_externallyUsedFunctions,
+		_system,
+		_sourceName,
+		m_evmVersion,
+		optimize ? std::make_optional(_optimiserSettings) : std::nullopt,
+		optimize && runtimeContext() != nullptr
+	};
+	std::shared_ptr<InlineAssemblyCache::Snippet const> snippet;
+	if (m_inlineAssemblyCache)
+		snippet = m_inlineAssemblyCache->find(_assembly, cacheKey);
+	if (!snippet)
+	{
+		snippet = parseInlineAssembly(
+			_assembly,
+			dialect,
+			identifierAccess.resolve,
+			externallyUsedIdentifiers,
+			_system,
+			optimize ? &_optimiserSettings : nullptr,
+			_sourceName
+		);
+		if (m_inlineAssemblyCache)
+			m_inlineAssemblyCache->insert(_assembly, std::move(cacheKey), snippet);
+	}
+
+	if (_system)
+	{
+		// Store as generated source.
+		solAssert(m_generatedYulUtilityCode.empty(), "");
+		m_generatedYulUtilityCode = snippet->generatedYulUtilityCode;
+	}
+
+	// The scopes are not modified by the code transform, so they can be shared with the cache.
+	yul::AsmAnalysisInfo analysisInfo = *snippet->analysisInfo;
+	solAssert(m_asm->codeSections().size() == 1, "Expected a single code section in legacy codegen.");
+	size_t const firstItem = m_asm->codeSections().front().items.size();
+	yul::CodeGenerator::assemble(
+		snippet->ast->root(),
+		analysisInfo,
+		*m_asm,
+		m_evmVersion,
+		std::nullopt,
+		identifierAccess.generateCode,
+		_system,
+		_optimiserSettings.optimizeStackAllocation
+	);
+	if (locationOverride)
+	{
+		AssemblyItems& items = m_asm->codeSections().front().items;
+		for (size_t i = firstItem; i < items.size(); ++i)
+			items[i].setLocation(*locationOverride);
+	}
+
+	// Reset the source location to the one of the node (instead of the CODEGEN source location)
+	updateSourceLocation();
+}
+
+
+std::shared_ptr<InlineAssemblyCache::Snippet const> CompilerContext::parseInlineAssembly(
+	std::string const& _assembly,
+	yul::EVMDialect const& _dialect,
+	yul::ExternalIdentifierAccess::Resolver const& _resolver,
+	std::set<yul::YulName> const& _externallyUsedIdentifiers,
+	bool _system,
+	OptimiserSettings const* _optimiserSettings,
+	std::string const& _sourceName
+)
+{
 	ErrorList errors;
 	ErrorReporter errorReporter(errors);
 	langutil::CharStream charStream(_assembly, _sourceName);
-	yul::EVMDialect const& dialect = yul::EVMDialect::strictAssemblyForEVM(m_evmVersion, std::nullopt);
 	std::optional<langutil::SourceLocation> locationOverride;
 	if (!_system)
-		locationOverride = m_asm->currentSourceLocation();
+		locationOverride = langutil::SourceLocation{};
 	std::shared_ptr<yul::AST> parserResult =
-		yul::Parser(errorReporter, dialect, std::move(locationOverride))
+		yul::Parser(errorReporter, _dialect, std::move(locationOverride))
 		.parse(charStream);
 #ifdef SOL_OUTPUT_ASM
-	cout << yul::AsmPrinter(&dialect)(*parserResult) << endl;
+	cout << yul::AsmPrinter(&_dialect)(*parserResult) << endl;
 #endif
 
 	auto reportError = [&](std::string const& _context)
@@ -456,83 +536,63 @@ void CompilerContext::appendInlineAssembly(
 			_assembly + "\n"
 			"------------------ Errors: ----------------\n";
 		for (auto const& error: errorReporter.errors())
-			// TODO if we have "locationOverride", it will be the wrong char stream,
-			// but we do not have access to the solidity scanner.
 			message += SourceReferenceFormatter::formatErrorInformation(*error, charStream);
 		message += "-------------------------------------------\n";
 
 		solAssert(false, message);
 	};
 
-	yul::AsmAnalysisInfo analysisInfo;
+	auto analysisInfo = std::make_shared<yul::AsmAnalysisInfo>();
 	bool analyzerResult = false;
 	if (parserResult)
 		analyzerResult = yul::AsmAnalyzer(
-			analysisInfo,
+			*analysisInfo,
 			errorReporter,
-			dialect,
-			identifierAccess.resolve
+			_dialect,
+			_resolver
 		).analyze(parserResult->root());
 	if (!parserResult || errorReporter.hasErrorsWarningsOrInfos() || !analyzerResult)
 		reportError("Invalid assembly generated by code generator.");
-	std::shared_ptr<yul::AST const> toBeAssembledAST = parserResult;
 
-	// Several optimizer steps cannot handle externally supplied stack variables,
-	// so we essentially only optimize the ABI functions.
-	if (_optimiserSettings.runYulOptimiser && _localVariables.empty())
+	auto snippet = std::make_shared<InlineAssemblyCache::Snippet>();
+	snippet->ast = parserResult;
+	snippet->analysisInfo = analysisInfo;
+
+	if (_optimiserSettings)
 	{
 		yul::Object obj;
-		obj.setCode(parserResult, std::make_shared<yul::AsmAnalysisInfo>(analysisInfo));
+		obj.setCode(parserResult, analysisInfo);
 
-		solAssert(!dialect.providesObjectAccess());
-		optimizeYul(obj, dialect, _optimiserSettings, externallyUsedIdentifiers);
+		solAssert(!_dialect.providesObjectAccess());
+		optimizeYul(obj, _dialect, *_optimiserSettings, _externallyUsedIdentifiers);
 
 		if (_system)
 		{
 			// Store as generated sources, but first re-parse to update the source references.
-			solAssert(m_generatedYulUtilityCode.empty(), "");
-			m_generatedYulUtilityCode = yul::AsmPrinter()(obj.code()->root());
-			std::string code = yul::AsmPrinter{}(obj.code()->root());
-			langutil::CharStream charStream(m_generatedYulUtilityCode, _sourceName);
-			obj.setCode(yul::Parser(errorReporter, dialect).parse(charStream));
-			obj.analysisInfo = std::make_shared<yul::AsmAnalysisInfo>(yul::AsmAnalyzer::analyzeStrictAssertCorrect(dialect, obj));
+			snippet->generatedYulUtilityCode = yul::AsmPrinter()(obj.code()->root());
+			langutil::CharStream charStream(snippet->generatedYulUtilityCode, _sourceName);
+			obj.setCode(yul::Parser(errorReporter, _dialect).parse(charStream));
+			obj.analysisInfo = std::make_shared<yul::AsmAnalysisInfo>(yul::AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, obj));
 		}
 
-		analysisInfo = std::move(*obj.analysisInfo);
-		toBeAssembledAST = obj.code();
+		snippet->analysisInfo = obj.analysisInfo;
+		snippet->ast = obj.code();
 
 #ifdef SOL_OUTPUT_ASM
 		cout << "After optimizer:" << endl;
-		cout << yul::AsmPrinter(&dialect)(*parserResult) << endl;
+		cout << yul::AsmPrinter(&_dialect)(*parserResult) << endl;
 #endif
 	}
 	else if (_system)
-	{
-		// Store as generated source.
-		solAssert(m_generatedYulUtilityCode.empty(), "");
-		m_generatedYulUtilityCode = _assembly;
-	}
+		snippet->generatedYulUtilityCode = _assembly;
 
 	if (errorReporter.hasErrorsWarningsOrInfos())
 		reportError("Failed to analyze inline assembly block.");
 
 	solAssert(!errorReporter.hasErrorsWarningsOrInfos(), "Failed to analyze inline assembly block.");
-	yul::CodeGenerator::assemble(
-		toBeAssembledAST->root(),
-		analysisInfo,
-		*m_asm,
-		m_evmVersion,
-		std::nullopt,
-		identifierAccess.generateCode,
-		_system,
-		_optimiserSettings.optimizeStackAllocation
-	);
-
-	// Reset the source location to the one of the node (instead of the CODEGEN source location)
-	updateSourceLocation();
+	return snippet;
 }
 
-
 void CompilerContext::optimizeYul(yul::Object& _object, yul::EVMDialect const& _dialect, OptimiserSettings const& _optimiserSettings, std::set<yul::YulName> const& _externalIdentifiers)
 {
 #ifdef SOL_OUTPUT_ASM
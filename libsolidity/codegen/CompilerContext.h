@@ -27,6 +27,7 @@
 #include <libsolidity/ast/ASTForward.h>
 #include <libsolidity/ast/Types.h>
 #include <libsolidity/codegen/ABIFunctions.h>
+#include <libsolidity/codegen/InlineAssemblyCache.h>
 
 #include <libsolidity/interface/DebugSettings.h>
 #include <libsolidity/interface/OptimiserSettings.h>
@@ -39,6 +40,7 @@
 #include <libsolutil/ErrorCodes.h>
 
 #include <libyul/AsmAnalysisInfo.h>
+#include <libyul/backends/evm/AbstractAssembly.h>
 #include <libyul/backends/evm/EVMDialect.h>
 
 #include <functional>
@@ -63,13 +65,15 @@ public:
 	explicit CompilerContext(
 		langutil::EVMVersion _evmVersion,
 		RevertStrings _revertStrings,
-		CompilerContext* _runtimeContext = nullptr
+		CompilerContext* _runtimeContext = nullptr,
+		std::shared_ptr<InlineAssemblyCache> _inlineAssemblyCache = nullptr
 	):
 		m_asm(std::make_shared<evmasm::Assembly>(_evmVersion, _runtimeContext != nullptr, std::nullopt, std::string{})),
 		m_evmVersion(_evmVersion),
 		m_revertStrings(_revertStrings),
 		m_reservedMemory{0},
 		m_runtimeContext(_runtimeContext),
+		m_inlineAssemblyCache(std::move(_inlineAssemblyCache)),
 		m_abiFunctions(m_evmVersion, m_revertStrings, m_yulFunctionCollector),
 		m_yulUtilFunctions(m_evmVersion, m_revertStrings, m_yulFunctionCollector)
 	{
@@ -263,6 +267,8 @@ public:
 	///                and the code is marked to be exported as "compiler-generated assembly utility file".
 	/// @param _optimiserSettings settings for the Yul optimiser, which is run in this function already.
 	/// @param _sourceName the name of the assembly file to be used for source locations
+	/// The parsed and optimised snippet is taken from the inline assembly cache, if one was provided
+	/// and it already contains the snippet.
 	void appendInlineAssembly(
 		std::string const& _assembly,
 		std::vector<std::string> const& _localVariables = std::vector<std::string>(),
@@ -282,8 +288,11 @@ public:
 	/// Appends arbitrary data to the end of the bytecode.
 	void appendToAuxiliaryData(bytes const& _data) { m_asm->appendToAuxiliaryData(_data); }
 
-	/// Run optimisation step.
-	void optimise(OptimiserSettings const& _settings) { m_asm->optimise(evmasm::Assembly::OptimiserSettings::translateSettings(_settings, m_evmVersion)); }
+	/// Run optimisation step, using the threads of @a _threadPool if given.
+	void optimise(OptimiserSettings const& _settings, util::ThreadPool* _threadPool = nullptr)
+	{
+		m_asm->optimise(evmasm::Assembly::OptimiserSettings::translateSettings(_settings, m_evmVersion), _threadPool);
+	}
 
 	/// @returns the runtime context if in creation mode and runtime context is set, nullptr otherwise.
 	CompilerContext* runtimeContext() const { return m_runtimeContext; }
@@ -311,6 +320,18 @@ public:
 	RevertStrings revertStrings() const { return m_revertStrings; }
 
 private:
+	/// Parses and analyses the inline assembly @a _assembly and optimises it if @a _optimiserSettings is given.
+	/// Snippets that are not system-level are parsed without source locations.
+	std::shared_ptr<InlineAssemblyCache::Snippet const> parseInlineAssembly(
+		std::string const& _assembly,
+		yul::EVMDialect const& _dialect,
+		yul::ExternalIdentifierAccess::Resolver const& _resolver,
+		std::set<yul::YulName> const& _externallyUsedIdentifiers,
+		bool _system,
+		OptimiserSettings const* _optimiserSettings,
+		std::string const& _sourceName
+	);
+
 	/// Updates source location set in the assembly.
 	void updateSourceLocation();
 
@@ -374,6 +395,8 @@ private:
 	std::stack<ASTNode const*> m_visitedNodes;
 	/// The runtime context if in Creation mode, this is used for generating tags that would be stored into the storage and then used at runtime.
 	CompilerContext *m_runtimeContext;
+	/// Cache of parsed inline assembly snippets shared with other contexts, might be nullptr.
+	std::shared_ptr<InlineAssemblyCache> m_inlineAssemblyCache;
 	/// The index of the runtime subroutine.
 	size_t m_runtimeSub = std::numeric_limits<size_t>::max();
 	/// An index of low-level function labels by name.
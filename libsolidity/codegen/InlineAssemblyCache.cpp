@@ -0,0 +1,55 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache of the inline assembly snippets appended by the legacy code generator.
+ */
+
+#include <libsolidity/codegen/InlineAssemblyCache.h>
+
+#include <tuple>
+
+using namespace solidity;
+using namespace solidity::frontend;
+
+bool InlineAssemblyCache::Key::operator==(Key const& _other) const
+{
+	return
+		std::tie(localVariables, externallyUsedFunctions, system, sourceName, evmVersion, optimiserSettings, creation) ==
+		std::tie(_other.localVariables, _other.externallyUsedFunctions, _other.system, _other.sourceName, _other.evmVersion, _other.optimiserSettings, _other.creation);
+}
+
+std::shared_ptr<InlineAssemblyCache::Snippet const> InlineAssemblyCache::find(std::string const& _code, Key const& _key) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto it = m_snippets.find(_code);
+	if (it != m_snippets.end())
+		for (auto const& [key, snippet]: it->second)
+			if (key == _key)
+				return snippet;
+	return nullptr;
+}
+
+void InlineAssemblyCache::insert(std::string const& _code, Key _key, std::shared_ptr<Snippet const> _snippet)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto& snippets = m_snippets[_code];
+	for (auto const& [key, snippet]: snippets)
+		if (key == _key)
+			return;
+	snippets.emplace_back(std::move(_key), std::move(_snippet));
+}
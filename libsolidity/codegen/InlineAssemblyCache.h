@@ -0,0 +1,93 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache of the inline assembly snippets appended by the legacy code generator.
+ */
+
+#pragma once
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <liblangutil/EVMVersion.h>
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace solidity::yul
+{
+class AST;
+struct AsmAnalysisInfo;
+}
+
+namespace solidity::frontend
+{
+
+/**
+ * Parsed, analysed and, if requested, optimised inline assembly snippets of the legacy code
+ * generator, shared by the compiler contexts of all contracts of a compilation.
+ *
+ * The same snippets (revert helpers, checks, ABI routines) are appended many times, so they
+ * are only parsed once per combination of code and the properties in @a Key.
+ * Snippets are stored without the source location of the Solidity node they are generated for,
+ * the compiler context assigns it to the assembly items when the snippet is appended.
+ */
+class InlineAssemblyCache
+{
+public:
+	/// Everything apart from the code that influences the result of parsing, analysing and
+	/// optimising a snippet.
+	struct Key
+	{
+		std::vector<std::string> localVariables;
+		std::set<std::string> externallyUsedFunctions;
+		bool system = false;
+		std::string sourceName;
+		langutil::EVMVersion evmVersion;
+		/// Settings of the Yul optimiser, only set if it was run on the snippet.
+		std::optional<OptimiserSettings> optimiserSettings;
+		/// True if the snippet was optimised for the creation code.
+		bool creation = false;
+
+		bool operator==(Key const& _other) const;
+	};
+
+	struct Snippet
+	{
+		std::shared_ptr<yul::AST const> ast;
+		std::shared_ptr<yul::AsmAnalysisInfo const> analysisInfo;
+		/// Code to be exported as generated Yul utility source. Only set for system-level snippets.
+		std::string generatedYulUtilityCode;
+	};
+
+	/// @returns the snippet stored for @a _code and @a _key or nullptr if there is none.
+	std::shared_ptr<Snippet const> find(std::string const& _code, Key const& _key) const;
+	/// Stores @a _snippet for @a _code and @a _key.
+	void insert(std::string const& _code, Key _key, std::shared_ptr<Snippet const> _snippet);
+
+private:
+	mutable std::mutex m_mutex;
+	std::unordered_map<std::string, std::vector<std::pair<Key, std::shared_ptr<Snippet const>>>> m_snippets;
+};
+
+}
@@ -54,10 +54,10 @@ BMC::BMC(
 	if (_settings.solvers.smtlib2)
 		solvers.emplace_back(std::make_unique<SMTLib2Interface>(_smtlib2Responses, _smtCallback, _settings.timeout));
 	if (_settings.solvers.cvc5)
-		solvers.emplace_back(std::make_unique<Cvc5SMTLib2Interface>(_smtCallback, _settings.timeout));
+		solvers.emplace_back(std::make_unique<Cvc5SMTLib2Interface>(_smtCallback, _settings.timeout, _settings.solverSessions));
 	if (_settings.solvers.z3 )
-		solvers.emplace_back(std::make_unique<Z3SMTLib2Interface>(_smtCallback, _settings.timeout));
-	m_interface = std::make_unique<SMTPortfolio>(std::move(solvers), _settings.timeout);
+		solvers.emplace_back(std::make_unique<Z3SMTLib2Interface>(_smtCallback, _settings.timeout, _settings.solverSessions));
+	m_interface = std::make_unique<SMTPortfolio>(std::move(solvers), _settings.timeout, _settings.raceSolvers);
 #if defined (HAVE_Z3)
 	if (m_settings.solvers.z3)
 		if (!_smtlib2Responses.empty())
@@ -928,8 +928,30 @@ std::string BMC::targetDescription(BMCVerificationTarget const& _target)
 
 void BMC::checkVerificationTargets()
 {
-	for (auto& target: m_verificationTargets)
-		checkVerificationTarget(target);
+	if (!m_queryThreadPool)
+	{
+		for (auto& target: m_verificationTargets)
+			checkVerificationTarget(target);
+		return;
+	}
+
+	// The queries of a batch of targets are first sent to the solvers in parallel.
+	// The targets are then checked and reported in order using the answers obtained that way.
+	size_t const batchSize = 4 * m_queryThreadPool->size();
+	for (size_t begin = 0; begin < m_verificationTargets.size(); begin += batchSize)
+	{
+		size_t end = std::min(begin + batchSize, m_verificationTargets.size());
+		std::vector<std::function<void()>> tasks;
+		m_prefetchTasks = &tasks;
+		for (size_t i = begin; i < end; ++i)
+			checkVerificationTarget(m_verificationTargets[i]);
+		m_prefetchTasks = nullptr;
+
+		runQueryTasks(std::move(tasks));
+
+		for (size_t i = begin; i < end; ++i)
+			checkVerificationTarget(m_verificationTargets[i]);
+	}
 }
 
 void BMC::checkVerificationTarget(BMCVerificationTarget& _target)
@@ -1122,6 +1144,14 @@ void BMC::checkCondition(
 			expressionsToEvaluate.emplace_back(*_additionalValue);
 			expressionNames.push_back(_additionalValueName);
 		}
+
+	if (m_prefetchTasks)
+	{
+		*m_prefetchTasks += m_interface->prefetch(expressionsToEvaluate);
+		m_interface->pop();
+		return;
+	}
+
 	smtutil::CheckResult result;
 	std::vector<std::string> values;
 	tie(result, values) = checkSatisfiableAndGenerateModel(expressionsToEvaluate);
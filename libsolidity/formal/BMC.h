@@ -213,6 +213,10 @@ private:
 
 	std::vector<BMCVerificationTarget> m_verificationTargets;
 
+	/// If not null, checkCondition() only collects the tasks that send its query
+	/// to the solvers here instead of checking and reporting the target.
+	std::vector<std::function<void()>>* m_prefetchTasks = nullptr;
+
 	/// Targets proved safe by this engine.
 	std::map<ASTNode const*, std::set<BMCVerificationTarget>, smt::EncodingContext::IdCompare> m_safeTargets;
 
@@ -1716,12 +1716,16 @@ Predicate const* CHC::createConstructorBlock(ContractDefinition const& _contract
 	);
 }
 
-void CHC::createErrorBlock()
+Predicate const* CHC::createErrorPredicate()
 {
-	m_errorPredicate = createSymbolicBlock(
+	return Predicate::create(
 		arity0FunctionSort(),
 		"error_target_" + std::to_string(m_context.newUniqueId()),
-		PredicateType::Error
+		PredicateType::Error,
+		m_context,
+		nullptr,
+		nullptr,
+		m_scopes
 	);
 }
 
@@ -2024,13 +2028,35 @@ void CHC::checkVerificationTargets()
 				targetEntryPoints[id].push_back(placeholder);
 	}
 
+	// Every target gets its own error block, which is created in a query context of its own.
+	// A query thus does not depend on the other targets, nor on the number of queries sent at the same time.
+	// The error predicates are created up front, so that their names do not depend on the results either.
+	std::map<unsigned, Predicate const*> errorPredicates;
+	for (auto const& [targetId, placeholders]: targetEntryPoints)
+		errorPredicates[targetId] = createErrorPredicate();
+
+	if (m_queryThreadPool)
+	{
+		std::vector<std::function<void()>> tasks;
+		for (auto const& [targetId, placeholders]: targetEntryPoints)
+		{
+			auto const& target = m_verificationTargets.at(targetId);
+			if (isUnsafe(target))
+				continue;
+			m_interface->pushQueryContext();
+			tasks += m_interface->prefetch(createTargetErrorBlock(*errorPredicates.at(targetId), target, placeholders));
+			m_interface->popQueryContext();
+		}
+		runQueryTasks(std::move(tasks));
+	}
+
 	std::set<unsigned> checkedErrorIds;
 	for (auto const& [targetId, placeholders]: targetEntryPoints)
 	{
 		auto const& target = m_verificationTargets.at(targetId);
 		auto [errorType, errorReporterId] = targetDescription(target);
 
-		checkAndReportTarget(target, placeholders, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
+		checkAndReportTarget(*errorPredicates.at(targetId), target, placeholders, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
 		checkedErrorIds.insert(target.errorId);
 	}
 
@@ -2146,6 +2172,7 @@ void CHC::checkVerificationTargets()
 }
 
 void CHC::checkAndReportTarget(
+	Predicate const& _errorPredicate,
 	CHCVerificationTarget const& _target,
 	std::vector<CHCQueryPlaceholder> const& _placeholders,
 	ErrorId _errorReporterId,
@@ -2153,18 +2180,47 @@ void CHC::checkAndReportTarget(
 	std::string _unknownMsg
 )
 {
-	if (m_unsafeTargets.count(_target.errorNode) && m_unsafeTargets.at(_target.errorNode).count(_target.type))
+	if (isUnsafe(_target))
 		return;
 
-	createErrorBlock();
+	m_interface->pushQueryContext();
+	reportTarget(
+		_target,
+		createTargetErrorBlock(_errorPredicate, _target, _placeholders),
+		_errorReporterId,
+		std::move(_satMsg),
+		std::move(_unknownMsg)
+	);
+	m_interface->popQueryContext();
+}
+
+smtutil::Expression CHC::createTargetErrorBlock(
+	Predicate const& _errorPredicate,
+	CHCVerificationTarget const& _target,
+	std::vector<CHCQueryPlaceholder> const& _placeholders
+)
+{
+	m_errorPredicate = &_errorPredicate;
+	m_interface->registerRelation(m_errorPredicate->functor());
 	for (auto const& placeholder: _placeholders)
 		connectBlocks(
 			placeholder.fromPredicate,
 			error(),
 			placeholder.constraints && placeholder.errorExpression == _target.errorId
 		);
+	return error();
+}
+
+void CHC::reportTarget(
+	CHCVerificationTarget const& _target,
+	smtutil::Expression const& _errorBlock,
+	ErrorId _errorReporterId,
+	std::string _satMsg,
+	std::string _unknownMsg
+)
+{
 	auto const& location = _target.errorNode->location();
-	auto [result, invariant, model] = query(error(), location);
+	auto [result, invariant, model] = query(_errorBlock, location);
 	if (result == CheckResult::UNSATISFIABLE)
 	{
 		m_safeTargets[_target.errorNode].insert(_target);
@@ -2180,7 +2236,7 @@ void CHC::checkAndReportTarget(
 	else if (result == CheckResult::SATISFIABLE)
 	{
 		solAssert(!_satMsg.empty(), "");
-		auto cex = generateCounterexample(model, error().name);
+		auto cex = generateCounterexample(model, _errorBlock.name);
 		if (cex)
 			m_unsafeTargets[_target.errorNode][_target.type] = {
 				_errorReporterId,
@@ -2202,6 +2258,11 @@ void CHC::checkAndReportTarget(
 		};
 }
 
+bool CHC::isUnsafe(CHCVerificationTarget const& _target) const
+{
+	return m_unsafeTargets.count(_target.errorNode) && m_unsafeTargets.at(_target.errorNode).count(_target.type);
+}
+
 /**
 The counterexample DAG has the following properties:
 1) The root node represents the reachable error predicate.
@@ -241,9 +241,9 @@ private:
 	/// @returns a block related to @a _contract's constructor.
 	Predicate const* createConstructorBlock(ContractDefinition const& _contract, std::string const& _prefix);
 
-	/// Creates a new error block to be used by an assertion.
-	/// Also registers the predicate.
-	void createErrorBlock();
+	/// Creates a new error predicate to be used by a verification target.
+	/// The predicate is registered with the solver by createTargetErrorBlock().
+	Predicate const* createErrorPredicate();
 
 	void connectBlocks(smtutil::Expression const& _from, smtutil::Expression const& _to, smtutil::Expression const& _constraints = smtutil::Expression(true));
 
@@ -303,13 +303,32 @@ private:
 	void checkVerificationTargets();
 	struct CHCQueryPlaceholder;
 	void checkAssertTarget(ASTNode const* _scope, CHCVerificationTarget const& _target);
+	/// Checks @a _target with an error block for @a _errorPredicate in a query context of its own.
 	void checkAndReportTarget(
+		Predicate const& _errorPredicate,
 		CHCVerificationTarget const& _target,
 		std::vector<CHCQueryPlaceholder> const& _placeholders,
 		langutil::ErrorId _errorReporterId,
 		std::string _satMsg,
 		std::string _unknownMsg = ""
 	);
+	/// Registers @a _errorPredicate and makes it reachable from @a _placeholders if @a _target fails.
+	/// @returns the error block.
+	smtutil::Expression createTargetErrorBlock(
+		Predicate const& _errorPredicate,
+		CHCVerificationTarget const& _target,
+		std::vector<CHCQueryPlaceholder> const& _placeholders
+	);
+	/// Queries the reachability of @a _errorBlock and records the result for @a _target.
+	void reportTarget(
+		CHCVerificationTarget const& _target,
+		smtutil::Expression const& _errorBlock,
+		langutil::ErrorId _errorReporterId,
+		std::string _satMsg,
+		std::string _unknownMsg
+	);
+	/// @returns true if a counterexample was already found for @a _target.
+	bool isUnsafe(CHCVerificationTarget const& _target) const;
 
 	std::pair<std::string, langutil::ErrorId> targetDescription(CHCVerificationTarget const& _target);
 
@@ -24,12 +24,24 @@ using namespace solidity::frontend::smt;
 
 Cvc5SMTLib2Interface::Cvc5SMTLib2Interface(
 	frontend::ReadCallback::Callback _smtCallback,
-	std::optional<unsigned int> _queryTimeout
-): SMTLib2Interface({}, std::move(_smtCallback), _queryTimeout)
+	std::optional<unsigned int> _queryTimeout,
+	bool _solverSession
+):
+	SMTLib2Interface({}, std::move(_smtCallback), _queryTimeout),
+	m_solverSession(_solverSession)
 {
 }
 
 void Cvc5SMTLib2Interface::setupSmtCallback() {
 	if (auto* universalCallback = m_smtCallback.target<frontend::UniversalCallback>())
+	{
 		universalCallback->smtCommand().setCvc5(m_queryTimeout);
+		universalCallback->smtCommand().setSessions(m_solverSession);
+	}
+}
+
+void Cvc5SMTLib2Interface::cancelSmtCallback(std::thread::id _queryThread)
+{
+	if (auto* universalCallback = m_smtCallback.target<frontend::UniversalCallback>())
+		universalCallback->smtCommand().cancel(_queryThread);
 }
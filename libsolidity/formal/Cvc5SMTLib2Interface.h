@@ -28,10 +28,14 @@ class Cvc5SMTLib2Interface: public smtutil::SMTLib2Interface
 public:
 	explicit Cvc5SMTLib2Interface(
 		frontend::ReadCallback::Callback _smtCallback = {},
-		std::optional<unsigned> _queryTimeout = {}
+		std::optional<unsigned> _queryTimeout = {},
+		bool _solverSession = false
 	);
 private:
 	void setupSmtCallback() override;
+	void cancelSmtCallback(std::thread::id _queryThread) override;
+
+	bool m_solverSession = false;
 };
 
 }
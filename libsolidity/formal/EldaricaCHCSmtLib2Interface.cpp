@@ -30,10 +30,24 @@ EldaricaCHCSmtLib2Interface::EldaricaCHCSmtLib2Interface(
 {
 }
 
-std::string EldaricaCHCSmtLib2Interface::querySolver(std::string const& _input)
+std::vector<std::function<void()>> EldaricaCHCSmtLib2Interface::prefetch(smtutil::Expression const& _block)
+{
+	if (!m_smtCallback)
+		return {};
+	return {[this, query = dumpQuery(_block)]() {
+		setupSmtCallback();
+		prefetchResponse(query);
+	}};
+}
+
+void EldaricaCHCSmtLib2Interface::setupSmtCallback()
 {
 	if (auto* universalCallback = m_smtCallback.target<frontend::UniversalCallback>())
 		universalCallback->smtCommand().setEldarica(m_queryTimeout, m_computeInvariants);
+}
 
+std::string EldaricaCHCSmtLib2Interface::querySolver(std::string const& _input)
+{
+	setupSmtCallback();
 	return CHCSmtLib2Interface::querySolver(_input);
 }
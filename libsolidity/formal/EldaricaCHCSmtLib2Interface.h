@@ -32,7 +32,11 @@ public:
 		bool computeInvariants
 	);
 
+	std::vector<std::function<void()>> prefetch(smtutil::Expression const& _expr) override;
+
 private:
+	void setupSmtCallback();
+
 	std::string querySolver(std::string const& _input) override;
 
 	bool m_computeInvariants;
@@ -43,6 +43,14 @@ ModelChecker::ModelChecker(
 	m_bmc(m_context, m_uniqueErrorReporter, m_unsupportedErrorReporter, m_provedSafeReporter, _smtlib2Responses, _smtCallback, m_settings, _charStreamProvider),
 	m_chc(m_context, m_uniqueErrorReporter, m_unsupportedErrorReporter, m_provedSafeReporter, _smtlib2Responses, _smtCallback, m_settings, _charStreamProvider)
 {
+#ifndef EMSCRIPTEN_BUILD
+	if (size_t threadCount = util::ThreadPool::threadCountForJobs(m_settings.jobs))
+	{
+		m_queryThreadPool = std::make_unique<util::ThreadPool>(threadCount);
+		m_bmc.setQueryThreadPool(m_queryThreadPool.get());
+		m_chc.setQueryThreadPool(m_queryThreadPool.get());
+	}
+#endif
 }
 
 // TODO This should be removed for 0.9.0.
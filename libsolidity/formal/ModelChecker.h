@@ -35,6 +35,10 @@
 #include <liblangutil/ErrorReporter.h>
 #include <liblangutil/UniqueErrorReporter.h>
 
+#include <libsolutil/ThreadPool.h>
+
+#include <memory>
+
 namespace solidity::langutil
 {
 class ErrorReporter;
@@ -103,6 +107,9 @@ private:
 
 	ModelCheckerSettings m_settings;
 
+	/// Threads the engines send independent queries from, if more than one job was requested.
+	std::unique_ptr<util::ThreadPool> m_queryThreadPool;
+
 	/// Stores the context of the encoding.
 	smt::EncodingContext m_context;
 
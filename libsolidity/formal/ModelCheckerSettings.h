@@ -169,10 +169,19 @@ struct ModelCheckerSettings
 	ModelCheckerEngine engine = ModelCheckerEngine::None();
 	ModelCheckerExtCalls externalCalls = {};
 	ModelCheckerInvariants invariants = ModelCheckerInvariants::Default();
+	/// Number of verification targets whose queries are sent to the solvers concurrently,
+	/// where 0 stands for the number of hardware threads.
+	unsigned jobs = 1;
 	bool printQuery = false;
+	/// Run the BMC solvers concurrently and use the first definitive answer
+	/// instead of waiting for all of them and checking that they agree.
+	bool raceSolvers = false;
 	bool showProvedSafe = false;
 	bool showUnproved = false;
 	bool showUnsupported = false;
+	/// Keep one solver process per BMC solver alive and query it incrementally
+	/// instead of spawning a new process for every query.
+	bool solverSessions = false;
 	smtutil::SMTSolverChoice solvers = smtutil::SMTSolverChoice::Z3();
 	ModelCheckerTargets targets = ModelCheckerTargets::Default();
 	std::optional<unsigned> timeout; // in milliseconds
@@ -187,10 +196,13 @@ struct ModelCheckerSettings
 			engine == _other.engine &&
 			externalCalls.mode == _other.externalCalls.mode &&
 			invariants == _other.invariants &&
+			jobs == _other.jobs &&
 			printQuery == _other.printQuery &&
+			raceSolvers == _other.raceSolvers &&
 			showProvedSafe == _other.showProvedSafe &&
 			showUnproved == _other.showUnproved &&
 			showUnsupported == _other.showUnsupported &&
+			solverSessions == _other.solverSessions &&
 			solvers == _other.solvers &&
 			targets == _other.targets &&
 			timeout == _other.timeout;
@@ -34,6 +34,7 @@
 
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/FunctionSelector.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <range/v3/view.hpp>
 
@@ -2887,6 +2888,18 @@ std::string SMTEncoder::extraComment()
 	return extra;
 }
 
+void SMTEncoder::runQueryTasks(std::vector<std::function<void()>> _tasks)
+{
+	solAssert(m_queryThreadPool);
+	std::vector<std::future<void>> results;
+	for (auto& task: _tasks)
+		results.emplace_back(m_queryThreadPool->submit(std::move(task)));
+	for (auto& result: results)
+		result.wait();
+	for (auto& result: results)
+		result.get();
+}
+
 FunctionDefinition const* SMTEncoder::functionCallToDefinition(
 	FunctionCall const& _funCall,
 	ContractDefinition const* _scopeContract,
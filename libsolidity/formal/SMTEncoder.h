@@ -34,6 +34,7 @@
 #include <libsolidity/interface/ReadFile.h>
 #include <liblangutil/UniqueErrorReporter.h>
 
+#include <functional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -46,6 +47,11 @@ struct SourceLocation;
 class CharStreamProvider;
 }
 
+namespace solidity::util
+{
+class ThreadPool;
+}
+
 namespace solidity::frontend
 {
 
@@ -61,6 +67,10 @@ public:
 		langutil::CharStreamProvider const& _charStreamProvider
 	);
 
+	/// Sets the pool of threads from which the queries for independent verification targets
+	/// may be sent to the solvers concurrently. The encoding itself stays on the calling thread.
+	void setQueryThreadPool(util::ThreadPool* _threadPool) { m_queryThreadPool = _threadPool; }
+
 	/// @returns the leftmost identifier in a multi-d IndexAccess.
 	static Expression const* leftmostBase(IndexAccess const& _indexAccess);
 
@@ -512,6 +522,13 @@ protected:
 
 	ModelCheckerSettings m_settings;
 
+	/// Runs @a _tasks on m_queryThreadPool and waits until all of them have finished.
+	void runQueryTasks(std::vector<std::function<void()>> _tasks);
+
+	/// Threads the solver queries are sent from if verification targets are checked in parallel,
+	/// nullptr otherwise.
+	util::ThreadPool* m_queryThreadPool = nullptr;
+
 	/// Character stream for each source,
 	/// used for retrieving source text of expressions for e.g. counter-examples.
 	langutil::CharStreamProvider const& m_charStreamProvider;
@@ -58,6 +58,26 @@ void Z3CHCSmtLib2Interface::setupSmtCallback(bool _enablePreprocessing)
 		universalCallback->smtCommand().setZ3(m_queryTimeout, _enablePreprocessing, m_computeInvariants);
 }
 
+std::vector<std::function<void()>> Z3CHCSmtLib2Interface::prefetch(smtutil::Expression const& _block)
+{
+#ifdef EMSCRIPTEN_BUILD
+	return {};
+#else
+	if (!m_smtCallback)
+		return {};
+	return {[this, query = dumpQuery(_block)]() {
+		setupSmtCallback(true);
+		auto response = prefetchResponse(query);
+		// query() asks for the proof right away if the answer is unsat, so do the same here.
+		if (response && boost::starts_with(*response, "unsat"))
+		{
+			setupSmtCallback(false);
+			prefetchResponse(proofQuery(query));
+		}
+	}};
+#endif
+}
+
 CHCSolverInterface::QueryResult Z3CHCSmtLib2Interface::query(smtutil::Expression const& _block)
 {
 	setupSmtCallback(true);
@@ -79,7 +99,7 @@ CHCSolverInterface::QueryResult Z3CHCSmtLib2Interface::query(smtutil::Expression
 		{
 			// Repeat the query with preprocessing disabled, to get the full proof
 			setupSmtCallback(false);
-			query = "(set-option :produce-proofs true)" + query + "\n(get-proof)";
+			query = proofQuery(query);
 #ifdef EMSCRIPTEN_BUILD
 			z3::set_param("fp.xform.slice", false);
 			z3::set_param("fp.xform.inline_linear", false);
@@ -113,6 +133,10 @@ CHCSolverInterface::QueryResult Z3CHCSmtLib2Interface::query(smtutil::Expression
 	}
 }
 
+std::string Z3CHCSmtLib2Interface::proofQuery(std::string const& _query)
+{
+	return "(set-option :produce-proofs true)" + _query + "\n(get-proof)";
+}
 
 CHCSolverInterface::CexGraph Z3CHCSmtLib2Interface::graphFromZ3Answer(std::string const& _proof) const
 {
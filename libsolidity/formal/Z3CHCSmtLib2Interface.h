@@ -32,11 +32,16 @@ public:
 		bool _computeInvariants
 	);
 
+	std::vector<std::function<void()>> prefetch(smtutil::Expression const& _expr) override;
+
 private:
 	void setupSmtCallback(bool _disablePreprocessing);
 
 	CHCSolverInterface::QueryResult query(smtutil::Expression const& _expr) override;
 
+	/// @returns @a _query extended to ask for the proof of an unsat answer.
+	static std::string proofQuery(std::string const& _query);
+
 	CHCSolverInterface::CexGraph graphFromZ3Answer(std::string const& _proof) const;
 
 	static CHCSolverInterface::CexGraph graphFromSMTLib2Expression(
@@ -28,8 +28,11 @@ using namespace solidity::frontend::smt;
 
 Z3SMTLib2Interface::Z3SMTLib2Interface(
 	frontend::ReadCallback::Callback _smtCallback,
-	std::optional<unsigned int> _queryTimeout
-): SMTLib2Interface({}, std::move(_smtCallback), _queryTimeout)
+	std::optional<unsigned int> _queryTimeout,
+	bool _solverSession
+):
+	SMTLib2Interface({}, std::move(_smtCallback), _queryTimeout),
+	m_solverSession(_solverSession)
 {
 #ifdef EMSCRIPTEN_BUILD
 	constexpr int resourceLimit = 2000000;
@@ -46,7 +49,16 @@ Z3SMTLib2Interface::Z3SMTLib2Interface(
 
 void Z3SMTLib2Interface::setupSmtCallback() {
 	if (auto* universalCallback = m_smtCallback.target<frontend::UniversalCallback>())
+	{
 		universalCallback->smtCommand().setZ3(m_queryTimeout, true, false);
+		universalCallback->smtCommand().setSessions(m_solverSession);
+	}
+}
+
+void Z3SMTLib2Interface::cancelSmtCallback(std::thread::id _queryThread)
+{
+	if (auto* universalCallback = m_smtCallback.target<frontend::UniversalCallback>())
+		universalCallback->smtCommand().cancel(_queryThread);
 }
 
 std::string Z3SMTLib2Interface::querySolver(std::string const& _query)
@@ -28,11 +28,15 @@ class Z3SMTLib2Interface: public smtutil::SMTLib2Interface
 public:
 	explicit Z3SMTLib2Interface(
 		frontend::ReadCallback::Callback _smtCallback = {},
-		std::optional<unsigned> _queryTimeout = {}
+		std::optional<unsigned> _queryTimeout = {},
+		bool _solverSession = false
 	);
 private:
 	void setupSmtCallback() override;
+	void cancelSmtCallback(std::thread::id _queryThread) override;
 	std::string querySolver(std::string const& _query) override;
+
+	bool m_solverSession = false;
 };
 
 }
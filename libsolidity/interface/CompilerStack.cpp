@@ -48,6 +48,7 @@
 #include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/ast/ASTJsonImporter.h>
 #include <libsolidity/codegen/Compiler.h>
+#include <libsolidity/codegen/InlineAssemblyCache.h>
 #include <libsolidity/formal/ModelChecker.h>
 #include <libsolidity/interface/ABI.h>
 #include <libsolidity/interface/Natspec.h>
@@ -84,6 +85,7 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/FunctionSelector.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <boost/algorithm/string/replace.hpp>
 
@@ -94,7 +96,9 @@
 #include <fmt/format.h>
 
 #include <utility>
+#include <list>
 #include <map>
+#include <optional>
 #include <limits>
 #include <string>
 
@@ -107,16 +111,16 @@ using namespace std::string_literals;
 
 using solidity::util::errinfo_comment;
 
-static int g_compilerStackCounts = 0;
+static thread_local int g_compilerStackCounts = 0;
 
 CompilerStack::CompilerStack(ReadCallback::Callback _readFile):
 	m_readFile{std::move(_readFile)},
 	m_objectOptimizer(std::make_shared<yul::ObjectOptimizer>()),
 	m_errorReporter{m_errorList}
 {
-	// Because TypeProvider is currently a singleton API, we must ensure that
-	// no more than one entity is actually using it at a time.
-	solAssert(g_compilerStackCounts == 0, "You shall not have another CompilerStack aside me.");
+	// Because TypeProvider is a singleton API per thread, we must ensure that
+	// no more than one entity is actually using it at a time on each thread.
+	solAssert(g_compilerStackCounts == 0, "You shall not have another CompilerStack aside me on this thread.");
 	++g_compilerStackCounts;
 }
 
@@ -228,6 +232,39 @@ void CompilerStack::setViaIR(bool _viaIR)
 	m_viaIR = _viaIR;
 }
 
+void CompilerStack::setParallelism(size_t _parallelism)
+{
+	solAssert(m_stackState < CompilationSuccessful, "Must set parallelism before compiling.");
+	m_parallelism = _parallelism;
+}
+
+void CompilerStack::setProfiling(bool _enabled)
+{
+	solAssert(m_stackState < ParsedAndImported, "Must set profiling before parsing.");
+	m_profiler = _enabled ? std::make_unique<util::Profiler>() : nullptr;
+}
+
+void CompilerStack::setObjectOptimizer(std::shared_ptr<yul::ObjectOptimizer> _objectOptimizer)
+{
+	solAssert(m_stackState < CompilationSuccessful, "Must set the object optimizer before compiling.");
+	solAssert(_objectOptimizer);
+	m_objectOptimizer = std::move(_objectOptimizer);
+}
+
+void CompilerStack::setParsedSourceCache(std::shared_ptr<ParsedSourceCache> _parsedSourceCache)
+{
+	solAssert(m_stackState < ParsedAndImported, "Must set the parsed source cache before parsing.");
+	m_parsedSourceCache = std::move(_parsedSourceCache);
+}
+
+void CompilerStack::setOptimizerCacheDirectory(boost::filesystem::path const& _directory, size_t _sizeLimit)
+{
+	solAssert(m_stackState < CompilationSuccessful, "Must set the optimizer cache directory before compiling.");
+	m_objectOptimizer->setPersistentCache(
+		std::make_shared<yul::PersistentObjectCache>(_directory, VersionString, _sizeLimit)
+	);
+}
+
 void CompilerStack::setEVMVersion(langutil::EVMVersion _version)
 {
 	solAssert(m_stackState < ParsedAndImported, "Must set EVM version before parsing.");
@@ -318,6 +355,10 @@ void CompilerStack::reset(bool _keepSettings)
 		m_importRemapper.clear();
 		m_libraries.clear();
 		m_viaIR = false;
+		m_parallelism = 1;
+		m_objectOptimizer->setPersistentCache(nullptr);
+		m_parsedSourceCache.reset();
+		m_profiler.reset();
 		m_evmVersion = langutil::EVMVersion();
 		m_eofVersion.reset();
 		m_modelCheckerSettings = ModelCheckerSettings{};
@@ -335,6 +376,8 @@ void CompilerStack::reset(bool _keepSettings)
 	m_sourceOrder.clear();
 	m_contracts.clear();
 	m_errorReporter.clear();
+	if (m_profiler)
+		m_profiler = std::make_unique<util::Profiler>();
 	TypeProvider::reset();
 }
 
@@ -350,6 +393,8 @@ void CompilerStack::setSources(StringMap _sources)
 bool CompilerStack::parse()
 {
 	solAssert(m_stackState == SourcesSet, "Must call parse only after the SourcesSet state.");
+	util::Profiler::Activation profilerActivation(m_profiler.get());
+	PROFILER_PROBE("Parsing", probe);
 	m_errorReporter.clear();
 
 	if (SemVerVersion{std::string(VersionString)}.isPrerelease())
@@ -357,54 +402,109 @@ bool CompilerStack::parse()
 
 	try
 	{
-		Parser parser{m_errorReporter, m_evmVersion, m_eofVersion};
-
-		std::vector<std::string> sourcesToParse;
+		using ParsedSource = ParsedSourceCache::ParsedSource;
+
+		// The sources are parsed in waves: the sources of a wave are parsed concurrently and the imports
+		// they introduce form the next wave. A serial parse processes the sources in the same order, so
+		// numbering the nodes of each source unit after the maximal ID of the previous one and processing
+		// the results in order gives the same AST IDs, imports and errors as a serial parse.
+		// The errors of each source are reported through m_errorReporter, so that its limits apply across
+		// sources. A source whose errors exceed the limit is dropped, like a serial parse would abort it.
+		// Source units taken from the cache are numbered the same way and their annotations are discarded.
+		util::ThreadPool threadPool(util::ThreadPool::threadCountForJobs(m_parallelism));
+		int64_t maxAstId = 0;
+		std::vector<std::pair<std::string, std::shared_ptr<CharStream>>> sourcesToParse;
 		for (auto const& s: m_sources)
-			sourcesToParse.push_back(s.first);
+			sourcesToParse.emplace_back(s.first, s.second.charStream);
 
-		for (size_t i = 0; i < sourcesToParse.size(); ++i)
+		while (!sourcesToParse.empty())
 		{
-			std::string const& path = sourcesToParse[i];
-			Source& source = m_sources[path];
-			source.ast = parser.parse(*source.charStream);
-			if (!source.ast)
-				solAssert(Error::containsErrors(m_errorReporter.errors()), "Parser returned null but did not report error.");
-			else
+			std::vector<std::shared_ptr<ParsedSource const>> parsedSources;
+			std::vector<bool> parsedNow;
+			std::vector<std::function<void()>> tasks;
+			for (auto const& sourceToParse: sourcesToParse)
 			{
-				source.ast->annotation().path = path;
-
-				for (auto const& import: ASTNode::filteredNodes<ImportDirective>(source.ast->nodes()))
-				{
-					solAssert(!import->path().empty(), "Import path cannot be empty.");
-					// Check whether the import directive is for the standard library,
-					// and if yes, add specified file to source units to be parsed.
-					auto it = stdlib::sources.find(import->path());
-					if (it != stdlib::sources.end())
+				CharStream& charStream = *sourceToParse.second;
+				if (m_parsedSourceCache)
+					if (auto cachedSource = m_parsedSourceCache->find(charStream, m_evmVersion, m_eofVersion))
 					{
-						auto [name, content] = *it;
-						m_sources[name].charStream = std::make_unique<CharStream>(content, name);
-						sourcesToParse.push_back(name);
+						Parser::clearAnnotations(cachedSource->nodes);
+						parsedSources.emplace_back(std::move(cachedSource));
+						parsedNow.emplace_back(false);
+						continue;
 					}
+				auto parsedSource = std::make_shared<ParsedSource>();
+				parsedSources.emplace_back(parsedSource);
+				parsedNow.emplace_back(true);
+				tasks.emplace_back([this, &parsedSource = *parsedSource, &charStream]() {
+					ErrorReporter errorReporter(parsedSource.errors);
+					Parser parser(errorReporter, m_evmVersion, m_eofVersion);
+					parsedSource.ast = parser.parse(charStream);
+					parsedSource.nodes = parser.nodes();
+				});
+			}
+			threadPool.runAll(std::move(tasks));
 
-					// The current value of `path` is the absolute path as seen from this source file.
-					// We first have to apply remappings before we can store the actual absolute path
-					// as seen globally.
-					import->annotation().absolutePath = applyRemapping(util::absolutePath(
-						import->path(),
-						path
-					), path);
+			std::vector<std::pair<std::string, std::shared_ptr<CharStream>>> nextSourcesToParse;
+			for (size_t i = 0; i < sourcesToParse.size(); ++i)
+			{
+				std::string const& path = sourcesToParse[i].first;
+				ParsedSource const& parsedSource = *parsedSources[i];
+				bool aborted = false;
+				try
+				{
+					m_errorReporter.report(parsedSource.errors);
+				}
+				catch (FatalError const&)
+				{
+					aborted = true;
 				}
+				Parser::assignIDs(parsedSource.nodes, maxAstId);
+				maxAstId += static_cast<int64_t>(parsedSource.nodes.size());
+				if (m_parsedSourceCache && parsedNow[i] && parsedSource.ast && !Error::containsErrors(parsedSource.errors))
+					m_parsedSourceCache->insert(*sourcesToParse[i].second, m_evmVersion, m_eofVersion, parsedSources[i]);
+
+				Source& source = m_sources[path];
+				source.ast = aborted ? nullptr : parsedSource.ast;
+				if (!source.ast)
+					solAssert(Error::containsErrors(parsedSource.errors), "Parser returned null but did not report error.");
+				else
+				{
+					source.ast->annotation().path = path;
 
-				if (m_stopAfter >= ParsedAndImported)
-					for (auto const& newSource: loadMissingSources(*source.ast))
+					for (auto const& import: ASTNode::filteredNodes<ImportDirective>(source.ast->nodes()))
 					{
-						std::string const& newPath = newSource.first;
-						std::string const& newContents = newSource.second;
-						m_sources[newPath].charStream = std::make_shared<CharStream>(newContents, newPath);
-						sourcesToParse.push_back(newPath);
+						solAssert(!import->path().empty(), "Import path cannot be empty.");
+						// Check whether the import directive is for the standard library,
+						// and if yes, add specified file to source units to be parsed.
+						auto it = stdlib::sources.find(import->path());
+						if (it != stdlib::sources.end())
+						{
+							auto [name, content] = *it;
+							m_sources[name].charStream = std::make_unique<CharStream>(content, name);
+							nextSourcesToParse.emplace_back(name, m_sources[name].charStream);
+						}
+
+						// The current value of `path` is the absolute path as seen from this source file.
+						// We first have to apply remappings before we can store the actual absolute path
+						// as seen globally.
+						import->annotation().absolutePath = applyRemapping(util::absolutePath(
+							import->path(),
+							path
+						), path);
 					}
+
+					if (m_stopAfter >= ParsedAndImported)
+						for (auto const& newSource: loadMissingSources(*source.ast))
+						{
+							std::string const& newPath = newSource.first;
+							std::string const& newContents = newSource.second;
+							m_sources[newPath].charStream = std::make_shared<CharStream>(newContents, newPath);
+							nextSourcesToParse.emplace_back(newPath, m_sources[newPath].charStream);
+						}
+				}
 			}
+			sourcesToParse = std::move(nextSourcesToParse);
 		}
 
 		if (Error::containsErrors(m_errorReporter.errors()))
@@ -414,7 +514,7 @@ bool CompilerStack::parse()
 		storeContractDefinitions();
 
 		solAssert(!m_maxAstId.has_value());
-		m_maxAstId = parser.maxID();
+		m_maxAstId = maxAstId;
 	}
 	catch (UnimplementedFeatureError const& _error)
 	{
@@ -427,6 +527,8 @@ bool CompilerStack::parse()
 void CompilerStack::importASTs(std::map<std::string, Json> const& _sources)
 {
 	solAssert(m_stackState == Empty, "Must call importASTs only before the SourcesSet state.");
+	util::Profiler::Activation profilerActivation(m_profiler.get());
+	PROFILER_PROBE("ASTImport", probe);
 	std::map<std::string, ASTPointer<SourceUnit>> reconstructedSources =
 		ASTJsonImporter(m_evmVersion, m_eofVersion).jsonToSourceUnit(_sources);
 	for (auto& src: reconstructedSources)
@@ -451,9 +553,14 @@ void CompilerStack::importASTs(std::map<std::string, Json> const& _sources)
 bool CompilerStack::analyze()
 {
 	solAssert(m_stackState == ParsedAndImported, "Must call analyze only after parsing was successful.");
+	util::Profiler::Activation profilerActivation(m_profiler.get());
+	PROFILER_PROBE("Analysis", analysisProbe);
 
-	if (!resolveImports())
-		return false;
+	{
+		PROFILER_PROBE("ImportResolution", probe);
+		if (!resolveImports())
+			return false;
+	}
 
 	for (Source const* source: m_sourceOrder)
 		if (source->ast)
@@ -465,38 +572,48 @@ bool CompilerStack::analyze()
 	{
 		bool experimentalSolidity = isExperimentalSolidity();
 
-		SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
-				noErrors = false;
+		{
+			PROFILER_PROBE("SyntaxChecker", probe);
+			SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
+			for (Source const* source: m_sourceOrder)
+				if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
+					noErrors = false;
+		}
 
 		m_globalContext = std::make_shared<GlobalContext>(m_evmVersion);
 		// We need to keep the same resolver during the whole process.
 		NameAndTypeResolver resolver(*m_globalContext, m_evmVersion, m_errorReporter, experimentalSolidity);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.registerDeclarations(*source->ast))
-				return false;
+		{
+			PROFILER_PROBE("NameAndTypeResolver", probe);
+			for (Source const* source: m_sourceOrder)
+				if (source->ast && !resolver.registerDeclarations(*source->ast))
+					return false;
 
-		std::map<std::string, SourceUnit const*> sourceUnitsByName;
-		for (auto& source: m_sources)
-			sourceUnitsByName[source.first] = source.second.ast.get();
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.performImports(*source->ast, sourceUnitsByName))
-				return false;
+			std::map<std::string, SourceUnit const*> sourceUnitsByName;
+			for (auto& source: m_sources)
+				sourceUnitsByName[source.first] = source.second.ast.get();
+			for (Source const* source: m_sourceOrder)
+				if (source->ast && !resolver.performImports(*source->ast, sourceUnitsByName))
+					return false;
 
-		resolver.warnHomonymDeclarations();
+			resolver.warnHomonymDeclarations();
+		}
 
 		{
+			PROFILER_PROBE("DocStringTagParser", probe);
 			DocStringTagParser docStringTagParser(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
 				if (source->ast && !docStringTagParser.parseDocStrings(*source->ast))
 					noErrors = false;
 		}
 
-		// Requires DocStringTagParser
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.resolveNamesAndTypes(*source->ast))
-				return false;
+		{
+			PROFILER_PROBE("NameAndTypeResolver", probe);
+			// Requires DocStringTagParser
+			for (Source const* source: m_sourceOrder)
+				if (source->ast && !resolver.resolveNamesAndTypes(*source->ast))
+					return false;
+		}
 
 		if (experimentalSolidity)
 		{
@@ -529,41 +646,54 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 {
 	bool noErrors = _noErrorsSoFar;
 
-	DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
-	for (Source const* source: m_sourceOrder)
-		if (source->ast && !declarationTypeChecker.check(*source->ast))
-			return false;
+	{
+		PROFILER_PROBE("DeclarationTypeChecker", probe);
+		DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
+		for (Source const* source: m_sourceOrder)
+			if (source->ast && !declarationTypeChecker.check(*source->ast))
+				return false;
+	}
 
-	// Requires DeclarationTypeChecker to have run
-	DocStringTagParser docStringTagParser(m_errorReporter);
-	for (Source const* source: m_sourceOrder)
-		if (source->ast && !docStringTagParser.validateDocStringsUsingTypes(*source->ast))
-			noErrors = false;
+	{
+		PROFILER_PROBE("DocStringTagParser", probe);
+		// Requires DeclarationTypeChecker to have run
+		DocStringTagParser docStringTagParser(m_errorReporter);
+		for (Source const* source: m_sourceOrder)
+			if (source->ast && !docStringTagParser.validateDocStringsUsingTypes(*source->ast))
+				noErrors = false;
+	}
+
+	{
+		PROFILER_PROBE("ContractLevelChecker", probe);
+		// Next, we check inheritance, overrides, function collisions and other things at
+		// contract or function level.
+		// This also calculates whether a contract is abstract, which is needed by the
+		// type checker.
+		ContractLevelChecker contractLevelChecker(m_errorReporter);
 
-	// Next, we check inheritance, overrides, function collisions and other things at
-	// contract or function level.
-	// This also calculates whether a contract is abstract, which is needed by the
-	// type checker.
-	ContractLevelChecker contractLevelChecker(m_errorReporter);
+		for (Source const* source: m_sourceOrder)
+			if (auto sourceAst = source->ast)
+				noErrors = contractLevelChecker.check(*sourceAst);
+	}
 
-	for (Source const* source: m_sourceOrder)
-		if (auto sourceAst = source->ast)
-			noErrors = contractLevelChecker.check(*sourceAst);
-
-	// Now we run full type checks that go down to the expression level. This
-	// cannot be done earlier, because we need cross-contract types and information
-	// about whether a contract is abstract for the `new` expression.
-	// This populates the `type` annotation for all expressions.
-	//
-	// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
-	// which is only done one step later.
-	TypeChecker typeChecker(m_evmVersion, m_errorReporter);
-	for (Source const* source: m_sourceOrder)
-		if (source->ast && !typeChecker.checkTypeRequirements(*source->ast))
-			noErrors = false;
+	{
+		PROFILER_PROBE("TypeChecker", probe);
+		// Now we run full type checks that go down to the expression level. This
+		// cannot be done earlier, because we need cross-contract types and information
+		// about whether a contract is abstract for the `new` expression.
+		// This populates the `type` annotation for all expressions.
+		//
+		// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
+		// which is only done one step later.
+		TypeChecker typeChecker(m_evmVersion, m_errorReporter);
+		for (Source const* source: m_sourceOrder)
+			if (source->ast && !typeChecker.checkTypeRequirements(*source->ast))
+				noErrors = false;
+	}
 
 	if (noErrors)
 	{
+		PROFILER_PROBE("DocStringAnalyser", probe);
 		// Requires ContractLevelChecker and TypeChecker
 		DocStringAnalyser docStringAnalyser(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
@@ -573,6 +703,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 
 	if (noErrors)
 	{
+		PROFILER_PROBE("PostTypeChecker", probe);
 		// Checks that can only be done when all types of all AST nodes are known.
 		PostTypeChecker postTypeChecker(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
@@ -585,27 +716,35 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 	// Create & assign callgraphs and check for contract dependency cycles
 	if (noErrors)
 	{
+		PROFILER_PROBE("CallGraph", probe);
 		createAndAssignCallGraphs();
 		annotateInternalFunctionIDs();
 		findAndReportCyclicContractDependencies();
 	}
 
 	if (noErrors)
+	{
+		PROFILER_PROBE("PostTypeContractLevelChecker", probe);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !PostTypeContractLevelChecker{m_errorReporter}.check(*source->ast))
 				noErrors = false;
+	}
 
 	// Check that immutable variables are never read in c'tors and assigned
 	// exactly once
 	if (noErrors)
+	{
+		PROFILER_PROBE("ImmutableValidator", probe);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast)
 				for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 					if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
 						ImmutableValidator(m_errorReporter, *contract).analyze();
+	}
 
 	if (noErrors)
 	{
+		PROFILER_PROBE("ControlFlowAnalyzer", probe);
 		// Control flow graph generator and analyzer. It can check for issues such as
 		// variable is used before it is assigned to.
 		CFG cfg(m_errorReporter);
@@ -626,6 +765,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 
 	if (noErrors)
 	{
+		PROFILER_PROBE("StaticAnalyzer", probe);
 		// Checks for common mistakes. Only generates warnings.
 		StaticAnalyzer staticAnalyzer(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
@@ -635,6 +775,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 
 	if (noErrors)
 	{
+		PROFILER_PROBE("ViewPureChecker", probe);
 		// Check for state mutability in every function.
 		std::vector<ASTPointer<ASTNode>> ast;
 		for (Source const* source: m_sourceOrder)
@@ -647,6 +788,7 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 
 	if (noErrors)
 	{
+		PROFILER_PROBE("ModelChecker", probe);
 		// Run SMTChecker
 
 		auto allSources = util::applyMap(m_sourceOrder, [](Source const* _source) { return _source->ast; });
@@ -750,50 +892,162 @@ bool CompilerStack::compile(State _stopAfter)
 	if (m_stackState >= m_stopAfter)
 		return true;
 
-	// Only compile contracts individually which have been requested.
-	std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> otherCompilers;
+	util::Profiler::Activation profilerActivation(m_profiler.get());
+	if (m_viaIR && util::ThreadPool::threadCountForJobs(m_parallelism) > 0)
+	{
+		if (!compileViaIRInParallel())
+			return false;
+	}
+	else
+	{
+		// Only compile contracts individually which have been requested.
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> otherCompilers;
+		// The legacy pipeline compiles the contracts one after another, but can optimise
+		// the assembly of each of them concurrently.
+		std::optional<util::ThreadPool> threadPool;
+		if (!m_viaIR && util::ThreadPool::threadCountForJobs(m_parallelism) > 0)
+			threadPool.emplace(util::ThreadPool::threadCountForJobs(m_parallelism));
+		// The code generator appends the same inline assembly snippets for many contracts.
+		auto inlineAssemblyCache = std::make_shared<InlineAssemblyCache>();
+
+		for (Source const* source: m_sourceOrder)
+			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+				if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
+					if (isRequestedContract(*contract))
+					{
+						PipelineConfig pipelineConfig = requestedPipelineConfig(*contract);
+
+						bool success = runCodegenStep([&]() {
+							if (pipelineConfig.needIR(m_viaIR))
+								generateIR(*contract, pipelineConfig.needIRCodegenOnly(m_viaIR));
+							if (pipelineConfig.needBytecode())
+							{
+								if (m_viaIR)
+									generateEVMFromIR(*contract, m_errorReporter);
+								else
+								{
+									if (m_experimentalAnalysis)
+										solThrow(CompilerError, "Legacy codegen after experimental analysis is unsupported.");
+									compileContract(*contract, otherCompilers, inlineAssemblyCache, threadPool ? &*threadPool : nullptr);
+								}
+							}
+						});
+						if (!success)
+							return false;
+					}
+	}
+	m_stackState = CompilationSuccessful;
+	this->link();
+	return true;
+}
+
+bool CompilerStack::runCodegenStep(std::function<void()> const& _step)
+{
+	try
+	{
+		_step();
+	}
+	catch (Error const& _error)
+	{
+		// Since codegen has no access to the error reporter, the only way for it to
+		// report an error is to throw. In most cases it uses dedicated exceptions,
+		// but CodeGenerationError is one case where someone decided to just throw Error.
+		solAssert(_error.type() == Error::Type::CodeGenerationError);
+		m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
+		return false;
+	}
+	catch (UnimplementedFeatureError const& _error)
+	{
+		reportUnimplementedFeatureError(_error);
+		return false;
+	}
+	return true;
+}
+
+bool CompilerStack::compileViaIRInParallel()
+{
+	solAssert(m_viaIR);
+
+	// IR generation is not thread-safe, because it creates types on demand, so it still runs
+	// sequentially, in the same order as in sequential compilation. The loading, optimization and
+	// assembly of the generated IR, which dominate the compilation time, do not depend on anything
+	// other than the IR and run in the thread pool. Diagnostics are collected separately for each
+	// contract and merged in the sequential order at the end, so that the output does not depend
+	// on the scheduling.
+	struct ContractCodegen
+	{
+		ErrorList irGenerationErrors;
+		ErrorList evmGenerationErrors;
+		/// Range of tasks in ParallelCodegen::tasks submitted while processing the contract.
+		size_t firstTask = 0;
+		size_t endTask = 0;
+	};
+	std::list<ContractCodegen> contracts;
+	ErrorList errorsBeforeCodegen = std::move(m_errorList);
+	m_errorList.clear();
+	std::function<void()> failedStep;
+
+	// NOTE: Declared after all the data that the tasks refer to, so that it is destroyed, and thus
+	// waits for all the tasks to finish, before that data.
+	util::ThreadPool threadPool(util::ThreadPool::threadCountForJobs(m_parallelism));
+	ParallelCodegen parallelCodegen{threadPool, {}, {}};
 
 	for (Source const* source: m_sourceOrder)
+	{
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
 				if (isRequestedContract(*contract))
 				{
 					PipelineConfig pipelineConfig = requestedPipelineConfig(*contract);
+					ContractCodegen& codegen = contracts.emplace_back();
+					codegen.firstTask = parallelCodegen.tasks.size();
 
 					try
 					{
 						if (pipelineConfig.needIR(m_viaIR))
-							generateIR(*contract, pipelineConfig.needIRCodegenOnly(m_viaIR));
-						if (pipelineConfig.needBytecode())
-						{
-							if (m_viaIR)
-								generateEVMFromIR(*contract);
-							else
-							{
-								if (m_experimentalAnalysis)
-									solThrow(CompilerError, "Legacy codegen after experimental analysis is unsupported.");
-								compileContract(*contract, otherCompilers);
-							}
-						}
+							generateIR(*contract, pipelineConfig.needIRCodegenOnly(m_viaIR), &parallelCodegen);
 					}
-					catch (Error const& _error)
+					catch (...)
 					{
-						// Since codegen has no access to the error reporter, the only way for it to
-						// report an error is to throw. In most cases it uses dedicated exceptions,
-						// but CodeGenerationError is one case where someone decided to just throw Error.
-						solAssert(_error.type() == Error::Type::CodeGenerationError);
-						m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
-						return false;
+						// Reported only once the steps that precede it in sequential order are done.
+						failedStep = [exception = std::current_exception()]() { std::rethrow_exception(exception); };
 					}
-					catch (UnimplementedFeatureError const& _error)
+
+					codegen.irGenerationErrors = std::move(m_errorList);
+					m_errorList.clear();
+
+					if (!failedStep && pipelineConfig.needBytecode() && contract->canBeDeployed())
 					{
-						reportUnimplementedFeatureError(_error);
-						return false;
+						std::shared_future<void> irLoading;
+						if (parallelCodegen.irLoadingTasks.count(contract))
+							irLoading = parallelCodegen.irLoadingTasks.at(contract);
+						parallelCodegen.tasks.emplace_back(threadPool.submit([this, contract, irLoading, &codegen, &threadPool]() {
+							if (irLoading.valid())
+								irLoading.get();
+							ErrorReporter errorReporter(codegen.evmGenerationErrors);
+							generateEVMFromIR(*contract, errorReporter, &threadPool);
+						}).share());
 					}
+					codegen.endTask = parallelCodegen.tasks.size();
+
+					if (failedStep)
+						break;
 				}
-	m_stackState = CompilationSuccessful;
-	this->link();
-	return true;
+		if (failedStep)
+			break;
+	}
+
+	m_errorList = std::move(errorsBeforeCodegen);
+	for (ContractCodegen& codegen: contracts)
+	{
+		m_errorReporter.append(codegen.irGenerationErrors);
+		for (size_t taskIndex = codegen.firstTask; taskIndex < codegen.endTask; ++taskIndex)
+			if (!runCodegenStep([&]() { parallelCodegen.tasks[taskIndex].get(); }))
+				return false;
+		m_errorReporter.append(codegen.evmGenerationErrors);
+	}
+
+	return !failedStep || runCodegenStep(failedStep);
 }
 
 void CompilerStack::link()
@@ -806,9 +1060,10 @@ void CompilerStack::link()
 	}
 }
 
-YulStack CompilerStack::loadGeneratedIR(std::string const& _ir) const
+std::shared_ptr<YulStack> CompilerStack::loadGeneratedIR(std::string const& _ir) const
 {
-	YulStack stack(
+	// Allocated on the heap since the stack's error reporter refers to its own error list.
+	auto stack = std::make_shared<YulStack>(
 		m_evmVersion,
 		m_eofVersion,
 		YulStack::Language::StrictAssembly,
@@ -817,12 +1072,12 @@ YulStack CompilerStack::loadGeneratedIR(std::string const& _ir) const
 		this, // _soliditySourceProvider
 		m_objectOptimizer
 	);
-	bool yulAnalysisSuccessful = stack.parseAndAnalyze("", _ir);
+	bool yulAnalysisSuccessful = stack->parseAndAnalyze("", _ir);
 	solAssert(
 		yulAnalysisSuccessful,
 		_ir + "\n\n"
 		"Invalid IR generated:\n" +
-		SourceReferenceFormatter::formatErrorInformation(stack.errors(), stack) + "\n"
+		SourceReferenceFormatter::formatErrorInformation(stack->errors(), *stack) + "\n"
 	);
 
 	return stack;
@@ -987,7 +1242,7 @@ std::optional<Json> CompilerStack::yulIRAst(std::string const& _contractName) co
 	yulAssert(currentContract.yulIR.has_value() == currentContract.contract->canBeDeployed());
 	if (!currentContract.yulIR)
 		return std::nullopt;
-	return loadGeneratedIR(*currentContract.yulIR).astJson();
+	return loadGeneratedIR(*currentContract.yulIR)->astJson();
 }
 
 std::optional<Json> CompilerStack::yulCFGJson(std::string const& _contractName) const
@@ -1002,7 +1257,7 @@ std::optional<Json> CompilerStack::yulCFGJson(std::string const& _contractName)
 	yulAssert(currentContract.yulIR.has_value() == currentContract.contract->canBeDeployed());
 	if (!currentContract.yulIR)
 		return std::nullopt;
-	return loadGeneratedIR(*currentContract.yulIR).cfgJson();
+	return loadGeneratedIR(*currentContract.yulIR)->cfgJson();
 }
 
 std::optional<std::string> const& CompilerStack::yulIROptimized(std::string const& _contractName) const
@@ -1023,7 +1278,7 @@ std::optional<Json> CompilerStack::yulIROptimizedAst(std::string const& _contrac
 	yulAssert(currentContract.yulIROptimized.has_value() == currentContract.contract->canBeDeployed());
 	if (!currentContract.yulIROptimized)
 		return std::nullopt;
-	return loadGeneratedIR(*currentContract.yulIROptimized).astJson();
+	return loadGeneratedIR(*currentContract.yulIROptimized)->astJson();
 }
 
 evmasm::LinkerObject const& CompilerStack::object(std::string const& _contractName) const
@@ -1413,7 +1668,8 @@ bool onlySafeExperimentalFeaturesActivated(std::set<ExperimentalFeature> const&
 void CompilerStack::assembleYul(
 	ContractDefinition const& _contract,
 	std::shared_ptr<evmasm::Assembly> _assembly,
-	std::shared_ptr<evmasm::Assembly> _runtimeAssembly
+	std::shared_ptr<evmasm::Assembly> _runtimeAssembly,
+	ErrorReporter& _errorReporter
 )
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "");
@@ -1422,6 +1678,7 @@ void CompilerStack::assembleYul(
 
 	compiledContract.evmAssembly = _assembly;
 	solAssert(compiledContract.evmAssembly, "");
+	PROFILER_PROBE("Assembly", probe);
 	try
 	{
 		// Assemble deployment (incl. runtime)  object.
@@ -1452,7 +1709,7 @@ void CompilerStack::assembleYul(
 		m_evmVersion >= langutil::EVMVersion::spuriousDragon() &&
 		compiledContract.runtimeObject.bytecode.size() > 0x6000
 	)
-		m_errorReporter.warning(
+		_errorReporter.warning(
 			5574_error,
 			_contract.location(),
 			"Contract code size is "s +
@@ -1470,7 +1727,7 @@ void CompilerStack::assembleYul(
 		m_evmVersion >= langutil::EVMVersion::shanghai() &&
 		compiledContract.object.bytecode.size() > 0xC000
 	)
-		m_errorReporter.warning(
+		_errorReporter.warning(
 			3860_error,
 			_contract.location(),
 			"Contract initcode size is "s +
@@ -1484,7 +1741,9 @@ void CompilerStack::assembleYul(
 
 void CompilerStack::compileContract(
 	ContractDefinition const& _contract,
-	std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
+	std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers,
+	std::shared_ptr<InlineAssemblyCache> const& _inlineAssemblyCache,
+	util::ThreadPool* _threadPool
 )
 {
 	solAssert(!m_viaIR, "");
@@ -1495,29 +1754,42 @@ void CompilerStack::compileContract(
 		return;
 
 	for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
-		compileContract(*dependency, _otherCompilers);
+		compileContract(*dependency, _otherCompilers, _inlineAssemblyCache, _threadPool);
 
 	if (!_contract.canBeDeployed())
 		return;
 
+	util::Profiler::Activation profilerActivation(m_profiler.get(), _contract.fullyQualifiedName());
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
-	std::shared_ptr<Compiler> compiler = std::make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings);
+	std::shared_ptr<Compiler> compiler = std::make_shared<Compiler>(
+		m_evmVersion,
+		m_revertStrings,
+		m_optimiserSettings,
+		_inlineAssemblyCache
+	);
 
 	solAssert(!m_viaIR, "");
 	bytes cborEncodedMetadata = createCBORMetadata(compiledContract, /* _forIR */ false);
 
-	// Run optimiser and compile the contract.
-	compiler->compileContract(_contract, _otherCompilers, cborEncodedMetadata);
+	{
+		PROFILER_PROBE("LegacyCodeGeneration", probe);
+		// Run optimiser and compile the contract.
+		compiler->compileContract(_contract, _otherCompilers, cborEncodedMetadata, _threadPool);
+	}
 	compiledContract.generatedYulUtilityCode = compiler->generatedYulUtilityCode();
 	compiledContract.runtimeGeneratedYulUtilityCode = compiler->runtimeGeneratedYulUtilityCode();
 
 	_otherCompilers[compiledContract.contract] = compiler;
 
-	assembleYul(_contract, compiler->assemblyPtr(), compiler->runtimeAssemblyPtr());
+	assembleYul(_contract, compiler->assemblyPtr(), compiler->runtimeAssemblyPtr(), m_errorReporter);
 }
 
-void CompilerStack::generateIR(ContractDefinition const& _contract, bool _unoptimizedOnly)
+void CompilerStack::generateIR(
+	ContractDefinition const& _contract,
+	bool _unoptimizedOnly,
+	ParallelCodegen* _parallelCodegen
+)
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "");
 
@@ -1538,60 +1810,118 @@ void CompilerStack::generateIR(ContractDefinition const& _contract, bool _unopti
 
 	std::string dependenciesSource;
 	for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
-		generateIR(*dependency, _unoptimizedOnly);
+		generateIR(*dependency, _unoptimizedOnly, _parallelCodegen);
 
 	if (!_contract.canBeDeployed())
 		return;
 
-	std::map<ContractDefinition const*, std::string_view const> otherYulSources;
-	for (auto const& pair: m_contracts)
-		otherYulSources.emplace(pair.second.contract, pair.second.yulIR ? *pair.second.yulIR : std::string_view{});
+	util::Profiler::Activation profilerActivation(m_profiler.get(), _contract.fullyQualifiedName());
+	{
+		PROFILER_PROBE("IRGeneration", probe);
+		std::map<ContractDefinition const*, std::string_view const> otherYulSources;
+		for (auto const& pair: m_contracts)
+			otherYulSources.emplace(pair.second.contract, pair.second.yulIR ? *pair.second.yulIR : std::string_view{});
 
-	if (m_experimentalAnalysis)
+		if (m_experimentalAnalysis)
+		{
+			experimental::IRGenerator generator(
+				m_evmVersion,
+				m_eofVersion,
+				m_revertStrings,
+				sourceIndices(),
+				m_debugInfoSelection,
+				this,
+				*m_experimentalAnalysis
+			);
+			compiledContract.yulIR = generator.run(
+				_contract,
+				{}, // TODO: createCBORMetadata(compiledContract, /* _forIR */ true),
+				otherYulSources
+			);
+		}
+		else
+		{
+			IRGenerator generator(
+				m_evmVersion,
+				m_eofVersion,
+				m_revertStrings,
+				sourceIndices(),
+				m_debugInfoSelection,
+				this,
+				m_optimiserSettings
+			);
+			compiledContract.yulIR = generator.run(
+				_contract,
+				createCBORMetadata(compiledContract, /* _forIR */ true),
+				otherYulSources
+			);
+		}
+	}
+
+	yulAssert(compiledContract.yulIR);
+	if (!_parallelCodegen)
 	{
-		experimental::IRGenerator generator(
-			m_evmVersion,
-			m_eofVersion,
-			m_revertStrings,
-			sourceIndices(),
-			m_debugInfoSelection,
-			this,
-			*m_experimentalAnalysis
-		);
-		compiledContract.yulIR = generator.run(
-			_contract,
-			{}, // TODO: createCBORMetadata(compiledContract, /* _forIR */ true),
-			otherYulSources
-		);
+		loadAndOptimizeIR(compiledContract, _unoptimizedOnly);
+		return;
 	}
-	else
+
+	// The dependencies are embedded in the IR of the contract as subobjects. Waiting for them
+	// to be optimized first lets the object optimizer reuse the results instead of optimizing
+	// the same code concurrently. Tasks are started in submission order and the ones of the
+	// dependencies have already been submitted, so this cannot lead to a deadlock.
+	std::vector<std::shared_future<void>> dependencyTasks;
+	for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
+		if (_parallelCodegen->irLoadingTasks.count(dependency))
+			dependencyTasks.emplace_back(_parallelCodegen->irLoadingTasks.at(dependency));
+
+	std::shared_future<void> task = _parallelCodegen->threadPool.submit(
+		[this, &compiledContract, _unoptimizedOnly, dependencyTasks, &threadPool = _parallelCodegen->threadPool]() {
+			for (auto const& dependencyTask: dependencyTasks)
+				dependencyTask.wait();
+			loadAndOptimizeIR(compiledContract, _unoptimizedOnly, &threadPool);
+		}
+	).share();
+	_parallelCodegen->irLoadingTasks[&_contract] = task;
+	_parallelCodegen->tasks.emplace_back(std::move(task));
+}
+
+void CompilerStack::loadAndOptimizeIR(
+	Contract& _compiledContract,
+	bool _unoptimizedOnly,
+	util::ThreadPool* _threadPool
+) const
+{
+	yulAssert(_compiledContract.yulIR);
+	yulAssert(_compiledContract.contract);
+	util::Profiler::Activation profilerActivation(m_profiler.get(), _compiledContract.contract->fullyQualifiedName());
+	std::shared_ptr<YulStack> stack;
 	{
-		IRGenerator generator(
-			m_evmVersion,
-			m_eofVersion,
-			m_revertStrings,
-			sourceIndices(),
-			m_debugInfoSelection,
-			this,
-			m_optimiserSettings
-		);
-		compiledContract.yulIR = generator.run(
-			_contract,
-			createCBORMetadata(compiledContract, /* _forIR */ true),
-			otherYulSources
-		);
+		PROFILER_PROBE("IRLoading", probe);
+		stack = loadGeneratedIR(*_compiledContract.yulIR);
 	}
+	if (_unoptimizedOnly)
+		return;
 
-	yulAssert(compiledContract.yulIR);
-	YulStack stack = loadGeneratedIR(*compiledContract.yulIR);
-	if (!_unoptimizedOnly)
 	{
-		stack.optimize();
-		compiledContract.yulIROptimized = stack.print();
+		PROFILER_PROBE("YulOptimizer", probe);
+		stack->optimize(_threadPool);
 	}
+
+	// The optimizer reparses the optimized code, so its AST is identical to the one we would
+	// get by parsing the printed code and it can be passed directly to the EVM code generation.
+	PipelineConfig pipelineConfig = requestedPipelineConfig(*_compiledContract.contract);
+	bool needStack = m_viaIR && pipelineConfig.needBytecode();
+	if (!needStack || pipelineConfig.irOptimization || m_selectedContracts.empty())
+		_compiledContract.yulIROptimized = stack->print();
+	if (needStack)
+		_compiledContract.yulIROptimizedStack = std::move(stack);
 }
 
-void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
+void CompilerStack::generateEVMFromIR(
+	ContractDefinition const& _contract,
+	ErrorReporter& _errorReporter,
+	util::ThreadPool* _threadPool
+)
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "");
 
@@ -1599,18 +1929,27 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	solAssert(compiledContract.yulIROptimized);
-	solAssert(!compiledContract.yulIROptimized->empty());
 	if (!compiledContract.object.bytecode.empty())
 		return;
 
-	// Re-parse the Yul IR in EVM dialect
-	YulStack stack = loadGeneratedIR(*compiledContract.yulIROptimized);
+	util::Profiler::Activation profilerActivation(m_profiler.get(), _contract.fullyQualifiedName());
+	std::shared_ptr<YulStack> stack = std::move(compiledContract.yulIROptimizedStack);
+	if (!stack)
+	{
+		PROFILER_PROBE("IRLoading", probe);
+		// Re-parse the Yul IR in EVM dialect
+		solAssert(compiledContract.yulIROptimized);
+		solAssert(!compiledContract.yulIROptimized->empty());
+		stack = loadGeneratedIR(*compiledContract.yulIROptimized);
+	}
 
 	std::string deployedName = IRNames::deployedObject(_contract);
 	solAssert(!deployedName.empty(), "");
-	tie(compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly) = stack.assembleEVMWithDeployed(deployedName);
-	assembleYul(_contract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly);
+	{
+		PROFILER_PROBE("EVMCodeTransform", probe);
+		tie(compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly) = stack->assembleEVMWithDeployed(deployedName, _threadPool);
+	}
+	assembleYul(_contract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly, _errorReporter);
 }
 
 CompilerStack::Contract const& CompilerStack::contract(std::string const& _contractName) const
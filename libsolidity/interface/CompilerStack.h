@@ -28,6 +28,7 @@
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolidity/interface/ImportRemapper.h>
 #include <libsolidity/interface/OptimiserSettings.h>
+#include <libsolidity/interface/ParsedSourceCache.h>
 #include <libsolidity/interface/Version.h>
 #include <libsolidity/interface/DebugSettings.h>
 
@@ -48,10 +49,12 @@
 #include <libsolutil/FixedHash.h>
 #include <libsolutil/LazyInit.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/Profiler.h>
 
 #include <libyul/ObjectOptimizer.h>
 
 #include <functional>
+#include <future>
 #include <memory>
 #include <ostream>
 #include <set>
@@ -63,6 +66,11 @@ namespace solidity::langutil
 class CharStream;
 }
 
+namespace solidity::util
+{
+class ThreadPool;
+}
+
 
 namespace solidity::evmasm
 {
@@ -85,6 +93,7 @@ class ContractDefinition;
 class FunctionDefinition;
 class SourceUnit;
 class Compiler;
+class InlineAssemblyCache;
 class GlobalContext;
 class Natspec;
 class DeclarationContainer;
@@ -97,6 +106,8 @@ class Analysis;
  * Easy to use and self-contained Solidity compiler with as few header dependencies as possible.
  * It holds state and can be used to either step through the compilation stages (and abort e.g.
  * before compilation to bytecode) or run the whole compilation in one call.
+ * Compiler stacks on different threads are independent of each other, but there can only be
+ * one per thread and it has to be used only on the thread that created it.
  */
 class CompilerStack: public langutil::CharStreamProvider, public evmasm::AbstractAssemblyStack
 {
@@ -223,6 +234,37 @@ public:
 	/// Must be set before parsing.
 	void setViaIR(bool _viaIR);
 
+	/// Sets the maximum number of threads used to parse sources and compile contracts concurrently.
+	/// 1 (the default) compiles all contracts one after another in the calling thread, 0 uses
+	/// as many threads as there are hardware threads available. The output does not depend on it.
+	/// Sources are parsed concurrently in both pipelines if set before parsing.
+	/// In the IR-based pipeline, contracts are optimized and assembled concurrently once the IR
+	/// has been generated. In the legacy pipeline, only the optimization of the assembly of
+	/// each contract is parallelized.
+	void setParallelism(size_t _parallelism);
+
+	/// Enables gathering the time, number of calls and memory usage of the compilation phases
+	/// per contract, which are available via profiler() afterwards. Must be set before parsing.
+	void setProfiling(bool _enabled);
+
+	/// Replaces the optimizer that caches the optimized Yul objects, e.g. to share its cache with
+	/// other compilations. Must be set before compiling and before setOptimizerCacheDirectory().
+	void setObjectOptimizer(std::shared_ptr<yul::ObjectOptimizer> _objectOptimizer);
+
+	/// Reuses the source units parsed by earlier compilations sharing @a _parsedSourceCache if the
+	/// contents of a source did not change and stores the ones parsed now. The reused source units
+	/// are analyzed again. Has no influence on the output. Must be set before parsing.
+	void setParsedSourceCache(std::shared_ptr<ParsedSourceCache> _parsedSourceCache);
+
+	/// Enables storing the results of the Yul optimizer in @a _directory, so that they can be
+	/// reused by later compilations using the same compiler version. The least recently used
+	/// entries are removed once the total size of the directory exceeds @a _sizeLimit bytes.
+	/// Has no influence on the output. Must be set before compiling.
+	void setOptimizerCacheDirectory(
+		boost::filesystem::path const& _directory,
+		size_t _sizeLimit = yul::PersistentObjectCache::defaultSizeLimit
+	);
+
 	/// Set the EVM version used before running compile.
 	/// When called without an argument it will revert to the default version.
 	/// Must be set before parsing.
@@ -327,6 +369,8 @@ public:
 	std::optional<Json> yulIRAst(std::string const& _contractName) const;
 
 	/// @returns the optimized IR representation of a contract.
+	/// When compiling via IR and contracts were selected explicitly, it is only available
+	/// if the optimized IR was requested in the pipeline configuration of the contract.
 	std::optional<std::string> const& yulIROptimized(std::string const& _contractName) const;
 
 	/// @returns the optimized IR representation of a contract AST in JSON format.
@@ -419,6 +463,9 @@ public:
 
 	yul::ObjectOptimizer const& objectOptimizer() const { return *m_objectOptimizer; }
 
+	/// @returns the metrics gathered during the compilation or nullptr if profiling is not enabled.
+	util::Profiler const* profiler() const { return m_profiler.get(); }
+
 private:
 	/// The state per source unit. Filled gradually during parsing.
 	struct Source
@@ -447,6 +494,9 @@ private:
 		evmasm::LinkerObject runtimeObject; ///< Runtime object.
 		std::optional<std::string> yulIR; ///< Yul IR code straight from the code generator.
 		std::optional<std::string> yulIROptimized; ///< Reparsed and possibly optimized Yul IR code.
+		/// Stack holding the optimized IR until EVM code is generated from it. Avoids printing and
+		/// parsing the optimized IR again if it was not requested as an output.
+		std::shared_ptr<yul::YulStack> yulIROptimizedStack;
 		util::LazyInit<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
 		util::LazyInit<Json const> abi;
 		util::LazyInit<Json const> storageLayout;
@@ -492,20 +542,48 @@ private:
 	/// @returns false on error.
 	bool analyzeExperimental();
 
+	/// Code generation tasks of the IR-based pipeline that were dispatched to a thread pool.
+	struct ParallelCodegen
+	{
+		util::ThreadPool& threadPool;
+		/// All tasks, in the order in which they were submitted.
+		std::vector<std::shared_future<void>> tasks;
+		/// Task that loads and optimizes the generated IR, for each contract that has one.
+		std::map<ContractDefinition const*, std::shared_future<void>> irLoadingTasks;
+	};
+
+	/// Runs a single code generation step and reports errors that code generation signals by
+	/// throwing exceptions.
+	/// @returns false if an error was reported.
+	bool runCodegenStep(std::function<void()> const& _step);
+
+	/// Compiles requested contracts via IR, dispatching the loading, optimization and assembly
+	/// of the generated IR to a thread pool. Produces the same output as sequential compilation.
+	/// @returns false on error.
+	bool compileViaIRInParallel();
+
 	/// Assembles the contract.
 	/// This function should only be internally called by compileContract and generateEVMFromIR.
+	/// Warnings are reported via @a _errorReporter, which does not have to be the one of the
+	/// compiler stack if the contract is being compiled in parallel with others.
 	void assembleYul(
 		ContractDefinition const& _contract,
 		std::shared_ptr<evmasm::Assembly> _assembly,
-		std::shared_ptr<evmasm::Assembly> _runtimeAssembly
+		std::shared_ptr<evmasm::Assembly> _runtimeAssembly,
+		langutil::ErrorReporter& _errorReporter
 	);
 
 	/// Compile a single contract.
 	/// @param _otherCompilers provides access to compilers of other contracts, to get
 	///                        their bytecode if needed. Only filled after they have been compiled.
+	/// @param _inlineAssemblyCache if given, is used to parse the inline assembly snippets of the code
+	///                             generator only once for all contracts.
+	/// @param _threadPool if given, is used to optimise the assembly concurrently.
 	void compileContract(
 		ContractDefinition const& _contract,
-		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers,
+		std::shared_ptr<InlineAssemblyCache> const& _inlineAssemblyCache = nullptr,
+		util::ThreadPool* _threadPool = nullptr
 	);
 
 	/// Generate Yul IR for a single contract.
@@ -516,11 +594,33 @@ private:
 	/// @param _unoptimizedOnly If true, only the IR coming directly from the codegen is stored.
 	///     Optimizer is not invoked and optimized IR output is not available, which means that
 	///     optimized IR, its AST or compilation via IR must not be requested.
-	void generateIR(ContractDefinition const& _contract, bool _unoptimizedOnly);
+	/// @param _parallelCodegen If not null, only the IR is generated right away while loading
+	///     and optimizing it is submitted to the thread pool.
+	void generateIR(
+		ContractDefinition const& _contract,
+		bool _unoptimizedOnly,
+		ParallelCodegen* _parallelCodegen = nullptr
+	);
+
+	/// Parses and analyzes the IR generated for a single contract and, unless
+	/// @a _unoptimizedOnly is true, optimizes it. The result is kept in memory for the EVM code
+	/// generation if it is going to be needed, and printed as optimized IR if it was requested.
+	/// Depends on output generated by generateIR. Does not modify the state of other contracts.
+	/// If @a _threadPool is given, the Yul objects of the contract are optimized concurrently.
+	void loadAndOptimizeIR(
+		Contract& _compiledContract,
+		bool _unoptimizedOnly,
+		util::ThreadPool* _threadPool = nullptr
+	) const;
 
 	/// Generate EVM representation for a single contract.
-	/// Depends on output generated by generateIR.
-	void generateEVMFromIR(ContractDefinition const& _contract);
+	/// Depends on output generated by generateIR. Releases the optimized IR stack of the contract.
+	/// If @a _threadPool is given, the sub-assemblies of the contract are optimized concurrently.
+	void generateEVMFromIR(
+		ContractDefinition const& _contract,
+		langutil::ErrorReporter& _errorReporter,
+		util::ThreadPool* _threadPool = nullptr
+	);
 
 	/// Links all the known library addresses in the available objects. Any unknown
 	/// library will still be kept as an unlinked placeholder in the objects.
@@ -529,7 +629,7 @@ private:
 	/// Parses and analyzes specified Yul source and returns the YulStack that can be used to manipulate it.
 	/// Assumes that the IR was generated from sources loaded currently into CompilerStack, which
 	/// means that it is error-free and uses the same settings.
-	yul::YulStack loadGeneratedIR(std::string const& _ir) const;
+	std::shared_ptr<yul::YulStack> loadGeneratedIR(std::string const& _ir) const;
 
 	/// @returns the contract object for the given @a _contractName.
 	/// Can only be called after state is CompilationSuccessful.
@@ -585,6 +685,7 @@ private:
 	RevertStrings m_revertStrings = RevertStrings::Default;
 	State m_stopAfter = State::CompilationSuccessful;
 	bool m_viaIR = false;
+	size_t m_parallelism = 1;
 	langutil::EVMVersion m_evmVersion;
 	std::optional<uint8_t> m_eofVersion;
 	ModelCheckerSettings m_modelCheckerSettings;
@@ -599,6 +700,8 @@ private:
 	std::vector<Source const*> m_sourceOrder;
 	std::map<std::string const, Contract> m_contracts;
 	std::shared_ptr<yul::ObjectOptimizer> m_objectOptimizer;
+	std::shared_ptr<ParsedSourceCache> m_parsedSourceCache;
+	std::unique_ptr<util::Profiler> m_profiler;
 
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
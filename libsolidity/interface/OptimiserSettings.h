@@ -125,7 +125,8 @@ struct OptimiserSettings
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
 			runYulOptimiser == _other.runYulOptimiser &&
 			yulOptimiserSteps == _other.yulOptimiserSteps &&
-			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment;
+			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment &&
+			experimentalSSACFGCodeTransform == _other.experimentalSSACFGCodeTransform;
 	}
 
 	bool operator!=(OptimiserSettings const& _other) const
@@ -167,6 +168,10 @@ struct OptimiserSettings
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
+	/// Generate the bytecode from optimized Yul with the experimental code transform based on the
+	/// SSA control flow graph instead of the one based on stack layouts. Only meant for evaluating
+	/// the code transform and not reflected in the metadata.
+	bool experimentalSSACFGCodeTransform = false;
 };
 
 }
@@ -0,0 +1,62 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache of the source units parsed by earlier compilations.
+ */
+
+#include <libsolidity/interface/ParsedSourceCache.h>
+
+#include <liblangutil/CharStream.h>
+
+#include <libsolutil/Keccak256.h>
+
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+
+std::shared_ptr<ParsedSourceCache::ParsedSource const> ParsedSourceCache::find(
+	CharStream const& _charStream,
+	EVMVersion _evmVersion,
+	std::optional<uint8_t> _eofVersion
+) const
+{
+	auto it = m_entries.find(_charStream.name());
+	if (
+		it == m_entries.end() ||
+		!(it->second.evmVersion == _evmVersion) ||
+		it->second.eofVersion != _eofVersion ||
+		it->second.contentHash != util::keccak256(_charStream.source())
+	)
+		return nullptr;
+	return it->second.parsedSource;
+}
+
+void ParsedSourceCache::insert(
+	CharStream const& _charStream,
+	EVMVersion _evmVersion,
+	std::optional<uint8_t> _eofVersion,
+	std::shared_ptr<ParsedSource const> _parsedSource
+)
+{
+	m_entries[_charStream.name()] = Entry{
+		util::keccak256(_charStream.source()),
+		_evmVersion,
+		_eofVersion,
+		std::move(_parsedSource)
+	};
+}
@@ -0,0 +1,98 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache of the source units parsed by earlier compilations.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTForward.h>
+
+#include <liblangutil/EVMVersion.h>
+#include <liblangutil/Exceptions.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace solidity::langutil
+{
+class CharStream;
+}
+
+namespace solidity::frontend
+{
+
+/**
+ * Source units parsed by earlier compilations, so that later compilations only have to parse
+ * the sources whose contents changed.
+ *
+ * Every compilation that reuses a source unit discards its annotations and assigns its node IDs
+ * again, so that the result does not depend on earlier compilations. The source units are
+ * annotated in place, so the cache must not be used by concurrent compilations. Inline assembly
+ * blocks refer to Yul strings, so the Yul string repository must not be reset while the cache
+ * is in use.
+ */
+class ParsedSourceCache
+{
+public:
+	/// A source unit together with the warnings reported while parsing it and all nodes created
+	/// while parsing it in the order of their creation.
+	struct ParsedSource
+	{
+		ASTPointer<SourceUnit> ast;
+		std::vector<std::weak_ptr<ASTNode>> nodes;
+		langutil::ErrorList errors;
+	};
+
+	/// @returns the source unit parsed from the contents of @a _charStream with the given settings
+	/// or nullptr if there is none.
+	std::shared_ptr<ParsedSource const> find(
+		langutil::CharStream const& _charStream,
+		langutil::EVMVersion _evmVersion,
+		std::optional<uint8_t> _eofVersion
+	) const;
+	/// Stores @a _parsedSource, replacing the source unit parsed from an earlier version of the
+	/// source with the same name.
+	void insert(
+		langutil::CharStream const& _charStream,
+		langutil::EVMVersion _evmVersion,
+		std::optional<uint8_t> _eofVersion,
+		std::shared_ptr<ParsedSource const> _parsedSource
+	);
+
+	size_t size() const { return m_entries.size(); }
+
+private:
+	struct Entry
+	{
+		util::h256 contentHash;
+		langutil::EVMVersion evmVersion;
+		std::optional<uint8_t> eofVersion;
+		std::shared_ptr<ParsedSource const> parsedSource;
+	};
+
+	/// Entries by source name.
+	std::map<std::string, Entry> m_entries;
+};
+
+}
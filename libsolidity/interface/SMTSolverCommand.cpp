@@ -19,118 +19,405 @@
 
 #include <liblangutil/Exceptions.h>
 
+#include <libsolutil/Common.h>
+
 #include <boost/algorithm/string/join.hpp>
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/algorithm/string/split.hpp>
 #include <boost/process.hpp>
 
+#include <range/v3/algorithm/any_of.hpp>
+
 namespace solidity::frontend
 {
 
+namespace
+{
+
+/// Printed by the solver via ``echo`` after the response to a query sent to a session.
+std::string const sessionResponseTerminator = "solc-smt-query-done";
+
+bool isHeaderCommand(std::string const& _line)
+{
+	return boost::starts_with(_line, "(set-option ") || boost::starts_with(_line, "(set-logic ");
+}
+
+/// Returns true if @a _line begins the part of the query that checks satisfiability of the
+/// asserted formulas and asks for the values of the expressions to evaluate. This part
+/// is never kept on the assertion stack of a session. Declarations made by the SMTChecker
+/// use ``declare-fun``, ``declare-const`` is only used for the evaluated expressions.
+bool isCheckCommand(std::string const& _line)
+{
+	return _line == "(check-sat)" || boost::starts_with(_line, "(declare-const ");
+}
+
+}
+
+struct SMTSolverCommand::Session
+{
+	boost::process::opstream in;
+	boost::process::ipstream out;
+	boost::process::child process;
+	/// The ``set-option`` and ``set-logic`` commands the session was started with.
+	std::vector<std::string> header;
+	/// Commands currently on the solver's assertion stack.
+	std::vector<std::string> commands;
+	/// Positions in @a commands at which the open push frames start.
+	std::vector<size_t> frameStarts;
+
+	Session(boost::filesystem::path const& _solverBin, std::vector<std::string> const& _arguments):
+		process(
+			_solverBin,
+			_arguments,
+			boost::process::std_out > out,
+			boost::process::std_in < in,
+			boost::process::std_err > boost::process::null
+		)
+	{}
+
+	~Session()
+	{
+		try
+		{
+			if (process.running())
+			{
+				in << "(exit)" << std::endl;
+				in.pipe().close();
+				process.wait();
+			}
+		}
+		catch (...)
+		{
+		}
+	}
+};
+
+SMTSolverCommand::SMTSolverCommand() = default;
+
+SMTSolverCommand::~SMTSolverCommand()
+{
+	closeSessions();
+}
+
 void SMTSolverCommand::setEldarica(std::optional<unsigned int> timeoutInMilliseconds, bool computeInvariants)
 {
-	m_arguments.clear();
-	m_solverCmd = "eld";
-	m_arguments.emplace_back("-hsmt"); // Tell Eldarica to expect input in SMT2 format
-	m_arguments.emplace_back("-in"); // Tell Eldarica to read from standard input
+	Configuration configuration;
+	configuration.solverCmd = "eld";
+	configuration.arguments.emplace_back("-hsmt"); // Tell Eldarica to expect input in SMT2 format
+	configuration.arguments.emplace_back("-in"); // Tell Eldarica to read from standard input
 	if (timeoutInMilliseconds)
 	{
 		unsigned int timeoutInSeconds = timeoutInMilliseconds.value() / 1000u;
 		timeoutInSeconds = timeoutInSeconds == 0 ? 1 : timeoutInSeconds;
-		m_arguments.push_back("-t:" + std::to_string(timeoutInSeconds));
+		configuration.arguments.push_back("-t:" + std::to_string(timeoutInSeconds));
 	}
 	if (computeInvariants)
-		m_arguments.emplace_back("-ssol"); // Tell Eldarica to produce model (invariant)
+		configuration.arguments.emplace_back("-ssol"); // Tell Eldarica to produce model (invariant)
+	setConfiguration(std::move(configuration));
 }
 
 void SMTSolverCommand::setCvc5(std::optional<unsigned int> timeoutInMilliseconds)
 {
-	m_arguments.clear();
-	m_solverCmd = "cvc5";
+	Configuration configuration;
+	configuration.solverCmd = "cvc5";
 	if (timeoutInMilliseconds)
 	{
-		m_arguments.emplace_back("--tlimit-per");
-		m_arguments.push_back(std::to_string(timeoutInMilliseconds.value()));
+		configuration.arguments.emplace_back("--tlimit-per");
+		configuration.arguments.push_back(std::to_string(timeoutInMilliseconds.value()));
 	}
 	else
 	{
-		m_arguments.emplace_back("--rlimit"); // Set resource limit cvc5 can spend on a query
-		m_arguments.push_back(std::to_string(12000));
+		configuration.arguments.emplace_back("--rlimit"); // Set resource limit cvc5 can spend on a query
+		configuration.arguments.push_back(std::to_string(12000));
 	}
+	setConfiguration(std::move(configuration));
 }
 
 void SMTSolverCommand::setZ3(std::optional<unsigned int> timeoutInMilliseconds, bool _preprocessing, bool _computeInvariants)
 {
 	constexpr int Z3ResourceLimit = 2000000;
-	m_arguments.clear();
-	m_solverCmd = "z3";
-	m_arguments.emplace_back("-in"); // Read from standard input
-	m_arguments.emplace_back("-smt2"); // Expect input in SMT-LIB2 format
+	Configuration configuration;
+	configuration.solverCmd = "z3";
+	configuration.arguments.emplace_back("-in"); // Read from standard input
+	configuration.arguments.emplace_back("-smt2"); // Expect input in SMT-LIB2 format
 	if (_computeInvariants)
-		m_arguments.emplace_back("-model"); // Output model automatically after check-sat
+		configuration.arguments.emplace_back("-model"); // Output model automatically after check-sat
 	if (timeoutInMilliseconds)
-		m_arguments.emplace_back("-t:" + std::to_string(timeoutInMilliseconds.value()));
+		configuration.arguments.emplace_back("-t:" + std::to_string(timeoutInMilliseconds.value()));
 	else
-		m_arguments.emplace_back("rlimit=" + std::to_string(Z3ResourceLimit));
+		configuration.arguments.emplace_back("rlimit=" + std::to_string(Z3ResourceLimit));
 
 	// These options have been empirically established to be helpful
-	m_arguments.emplace_back("rewriter.pull_cheap_ite=true");
-	m_arguments.emplace_back("fp.spacer.q3.use_qgen=true");
-	m_arguments.emplace_back("fp.spacer.mbqi=false");
-	m_arguments.emplace_back("fp.spacer.ground_pobs=false");
+	configuration.arguments.emplace_back("rewriter.pull_cheap_ite=true");
+	configuration.arguments.emplace_back("fp.spacer.q3.use_qgen=true");
+	configuration.arguments.emplace_back("fp.spacer.mbqi=false");
+	configuration.arguments.emplace_back("fp.spacer.ground_pobs=false");
 
 	// Spacer optimization should be
 	// - enabled for better solving (default)
 	// - disable for counterexample generation
 	std::string preprocessingArg = _preprocessing ? "true" : "false";
-	m_arguments.emplace_back("fp.xform.slice=" + preprocessingArg);
-	m_arguments.emplace_back("fp.xform.inline_linear=" + preprocessingArg);
-	m_arguments.emplace_back("fp.xform.inline_eager=" + preprocessingArg);
+	configuration.arguments.emplace_back("fp.xform.slice=" + preprocessingArg);
+	configuration.arguments.emplace_back("fp.xform.inline_linear=" + preprocessingArg);
+	configuration.arguments.emplace_back("fp.xform.inline_eager=" + preprocessingArg);
+	setConfiguration(std::move(configuration));
+}
+
+void SMTSolverCommand::setSessions(bool _enabled)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	Configuration& configuration = m_configurations[std::this_thread::get_id()];
+	if (_enabled && configuration.solverCmd == "cvc5")
+	{
+		// The resource limit of cvc5 is spent over the lifetime of the process, so a session has to limit
+		// each query instead to get the same answers as a process per query.
+		for (auto& argument: configuration.arguments)
+			if (argument == "--rlimit")
+				argument = "--rlimit-per";
+		configuration.arguments.emplace_back("--incremental");
+	}
+	configuration.sessionsEnabled = _enabled;
+}
+
+void SMTSolverCommand::cancel(std::thread::id _thread)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_configurations[_thread].cancelled = true;
+	if (auto process = m_runningProcesses.find(_thread); process != m_runningProcesses.end())
+		process->second->terminate();
 }
 
-ReadCallback::Result SMTSolverCommand::solve(std::string const& _kind, std::string const& _query) const
+void SMTSolverCommand::closeSessions()
+{
+	std::map<std::pair<std::thread::id, std::vector<std::string>>, std::unique_ptr<Session>> sessions;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		sessions.swap(m_sessions);
+	}
+}
+
+void SMTSolverCommand::setConfiguration(Configuration _configuration)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_configurations[std::this_thread::get_id()] = std::move(_configuration);
+}
+
+bool SMTSolverCommand::registerProcess(boost::process::child& _process)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto const thread = std::this_thread::get_id();
+	if (m_configurations[thread].cancelled)
+		return false;
+	m_runningProcesses[thread] = &_process;
+	return true;
+}
+
+bool SMTSolverCommand::unregisterProcess()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto const thread = std::this_thread::get_id();
+	m_runningProcesses.erase(thread);
+	return !m_configurations[thread].cancelled;
+}
+
+ReadCallback::Result SMTSolverCommand::solve(std::string const& _kind, std::string const& _query)
 {
 	try
 	{
 		if (_kind != ReadCallback::kindString(ReadCallback::Kind::SMTQuery))
 			solAssert(false, "SMTQuery callback used as callback kind " + _kind);
 
-		if (m_solverCmd.empty())
+		Configuration configuration;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			configuration = m_configurations[std::this_thread::get_id()];
+		}
+
+		if (configuration.cancelled)
+			return ReadCallback::Result{false, "Query cancelled."};
+
+		if (configuration.solverCmd.empty())
 			return ReadCallback::Result{false, "No solver set."};
 
-		auto solverBin = boost::process::search_path(m_solverCmd);
+		auto solverBin = boost::process::search_path(configuration.solverCmd);
 
 		if (solverBin.empty())
-			return ReadCallback::Result{false, m_solverCmd + " binary not found."};
+			return ReadCallback::Result{false, configuration.solverCmd + " binary not found."};
 
-		auto args = m_arguments;
+		if (configuration.sessionsEnabled)
+			if (std::optional<std::string> response = solveInSession(solverBin, configuration.arguments, _query))
+				return ReadCallback::Result{true, *response};
 
-		boost::process::opstream in;  // input to subprocess written to by the main process
-		boost::process::ipstream out; // output from subprocess read by the main process
-		boost::process::child solverProcess(
-			solverBin,
-			args,
-			boost::process::std_out > out,
-			boost::process::std_in < in,
-			boost::process::std_err > boost::process::null
-		);
+		return solveInNewProcess(solverBin, configuration.arguments, _query);
+	}
+	catch (...)
+	{
+		return ReadCallback::Result{false, "Exception in SMTQuery callback: " + boost::current_exception_diagnostic_information()};
+	}
+}
+
+ReadCallback::Result SMTSolverCommand::solveInNewProcess(
+	boost::filesystem::path const& _solverBin,
+	std::vector<std::string> const& _arguments,
+	std::string const& _query
+)
+{
+	boost::process::opstream in;  // input to subprocess written to by the main process
+	boost::process::ipstream out; // output from subprocess read by the main process
+	boost::process::child solverProcess(
+		_solverBin,
+		_arguments,
+		boost::process::std_out > out,
+		boost::process::std_in < in,
+		boost::process::std_err > boost::process::null
+	);
+	if (!registerProcess(solverProcess))
+	{
+		solverProcess.terminate();
+		return ReadCallback::Result{false, "Query cancelled."};
+	}
 
+	std::vector<std::string> data;
+	try
+	{
 		in << _query << std::flush;
 		in.pipe().close();
 		in.close();
 
-		std::vector<std::string> data;
 		std::string line;
 		while (!(out.fail() || out.eof()) && std::getline(out, line))
 			if (!line.empty())
 				data.push_back(line);
+	}
+	catch (...)
+	{
+		unregisterProcess();
+		throw;
+	}
+	bool const cancelled = !unregisterProcess();
+
+	solverProcess.wait();
+
+	if (cancelled)
+		return ReadCallback::Result{false, "Query cancelled."};
+	return ReadCallback::Result{true, boost::join(data, "\n")};
+}
+
+std::optional<std::string> SMTSolverCommand::solveInSession(
+	boost::filesystem::path const& _solverBin,
+	std::vector<std::string> const& _arguments,
+	std::string const& _query
+)
+{
+	std::vector<std::string> lines;
+	boost::split(lines, _query, [](char _c) { return _c == '\n'; });
+
+	std::vector<std::string> header;
+	std::vector<std::string> commands;
+	std::vector<std::string> check;
+	for (auto& line: lines)
+		if (line.empty())
+			continue;
+		else if (commands.empty() && check.empty() && isHeaderCommand(line))
+			header.emplace_back(std::move(line));
+		else if (!check.empty() || isCheckCommand(line))
+			check.emplace_back(std::move(line));
+		else
+			commands.emplace_back(std::move(line));
+
+	// Queries that do not check satisfiability or change the solver's configuration after
+	// the first assertion cannot be answered incrementally.
+	if (check.empty() || ranges::any_of(commands, isHeaderCommand) || ranges::any_of(check, isHeaderCommand))
+		return std::nullopt;
+
+	// Sessions are never shared between threads, so that the session of the calling thread
+	// can be used without holding the lock.
+	std::vector<std::string> commandLine = _arguments;
+	commandLine.insert(commandLine.begin(), _solverBin.string());
+	auto const key = std::make_pair(std::this_thread::get_id(), std::move(commandLine));
+	std::unique_ptr<Session> session;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (auto it = m_sessions.find(key); it != m_sessions.end())
+			session = std::move(it->second);
+		m_sessions.erase(key);
+	}
+	if (session && session->header != header)
+		session.reset();
 
-		solverProcess.wait();
+	try
+	{
+		if (!session)
+		{
+			session = std::make_unique<Session>(_solverBin, _arguments);
+			session->header = header;
+			for (auto const& command: header)
+				session->in << command << '\n';
+		}
+		if (!registerProcess(session->process))
+			return std::nullopt;
+		ScopeGuard processGuard([&]() { unregisterProcess(); });
+
+		// Drop the frames that are not a prefix of the new query.
+		size_t commonPrefix = 0;
+		while (
+			commonPrefix < session->commands.size() &&
+			commonPrefix < commands.size() &&
+			session->commands[commonPrefix] == commands[commonPrefix]
+		)
+			++commonPrefix;
+		size_t framesToPop = 0;
+		while (!session->frameStarts.empty() && session->commands.size() > commonPrefix)
+		{
+			session->commands.resize(session->frameStarts.back());
+			session->frameStarts.pop_back();
+			++framesToPop;
+		}
+		solAssert(session->commands.size() <= commonPrefix);
+		if (framesToPop > 0)
+			session->in << "(pop " << framesToPop << ")\n";
 
-		return ReadCallback::Result{true, boost::join(data, "\n")};
+		if (session->commands.size() < commands.size())
+		{
+			session->frameStarts.push_back(session->commands.size());
+			session->in << "(push 1)\n";
+			for (size_t i = session->commands.size(); i < commands.size(); ++i)
+			{
+				session->in << commands[i] << '\n';
+				session->commands.emplace_back(std::move(commands[i]));
+			}
+		}
+
+		session->in << "(push 1)\n";
+		for (auto const& command: check)
+			session->in << command << '\n';
+		session->in << "(pop 1)\n";
+		session->in << "(echo \"" << sessionResponseTerminator << "\")" << std::endl;
+
+		std::vector<std::string> data;
+		std::string line;
+		while (std::getline(session->out, line))
+		{
+			if (!line.empty() && line.back() == '\r')
+				line.pop_back();
+			// Solvers differ in whether they print the quotes of the echoed string.
+			if (line == sessionResponseTerminator || line == '"' + sessionResponseTerminator + '"')
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_sessions[key] = std::move(session);
+				return boost::join(data, "\n");
+			}
+			if (!line.empty())
+				data.push_back(line);
+		}
 	}
 	catch (...)
 	{
-		return ReadCallback::Result{false, "Exception in SMTQuery callback: " + boost::current_exception_diagnostic_information()};
 	}
+
+	// The solver terminated, was cancelled or the pipe broke. The session is in an unknown
+	// state and is discarded.
+	return std::nullopt;
 }
 
 }
@@ -20,18 +20,40 @@
 #include <libsolidity/interface/ReadFile.h>
 
 #include <boost/filesystem.hpp>
+#include <boost/process/child.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace solidity::frontend
 {
 
 /// SMTSolverCommand wraps an SMT solver called via its binary in the OS.
+///
+/// By default every query spawns a new solver process. If sessions are enabled
+/// for the currently selected solver (see @a setSessions), a single solver process
+/// is kept alive per solver command line and queries are sent to it incrementally:
+/// the part of a query that was already asserted by a previous query is kept on the
+/// solver's assertion stack and only the differing suffix is sent inside a new
+/// push/pop frame.
+///
+/// The solver selected via the setters applies to the queries issued by the calling
+/// thread only, so that queries for different solvers can be run concurrently.
 class SMTSolverCommand
 {
 public:
+	SMTSolverCommand();
+	~SMTSolverCommand();
+
 	/// Calls an SMT solver with the given query.
-	frontend::ReadCallback::Result solve(std::string const& _kind, std::string const& _query) const;
+	frontend::ReadCallback::Result solve(std::string const& _kind, std::string const& _query);
 
-	frontend::ReadCallback::Callback solver() const
+	frontend::ReadCallback::Callback solver()
 	{
 		return [this](std::string const& _kind, std::string const& _query) { return solve(_kind, _query); };
 	}
@@ -40,10 +62,59 @@ public:
 	void setCvc5(std::optional<unsigned int> timeoutInMilliseconds);
 	void setZ3(std::optional<unsigned int> timeoutInMilliseconds, bool _preprocessing, bool _computeInvariants);
 
+	/// Enables or disables the persistent incremental solver session for the solver
+	/// selected by the last call to one of the setters above. The setters disable it.
+	/// Only meaningful for solvers that support push/pop, i.e. z3 and cvc5.
+	void setSessions(bool _enabled);
+
+	/// Terminates the solver process currently running a query for @a _thread and makes
+	/// all further queries from that thread fail until a solver is selected again.
+	void cancel(std::thread::id _thread);
+
+	/// Terminates all running solver sessions.
+	void closeSessions();
+
 private:
-	/// The name of the solver's binary.
-	std::string m_solverCmd;
-	std::vector<std::string> m_arguments;
+	struct Session;
+
+	struct Configuration
+	{
+		/// The name of the solver's binary.
+		std::string solverCmd;
+		std::vector<std::string> arguments;
+		bool sessionsEnabled = false;
+		bool cancelled = false;
+	};
+
+	void setConfiguration(Configuration _configuration);
+
+	/// Makes @a _process the one to terminate when the queries of the calling thread are cancelled.
+	/// @returns false if they already are.
+	bool registerProcess(boost::process::child& _process);
+	/// @returns false if the queries of the calling thread were cancelled in the meantime.
+	bool unregisterProcess();
+
+	/// Spawns a new solver process for the query and reads its whole output.
+	frontend::ReadCallback::Result solveInNewProcess(
+		boost::filesystem::path const& _solverBin,
+		std::vector<std::string> const& _arguments,
+		std::string const& _query
+	);
+	/// Sends the query to the session of the calling thread for the given solver command line,
+	/// starting it if necessary. Returns an empty optional if the session failed, in
+	/// which case it has been closed.
+	std::optional<std::string> solveInSession(
+		boost::filesystem::path const& _solverBin,
+		std::vector<std::string> const& _arguments,
+		std::string const& _query
+	);
+
+	std::mutex m_mutex;
+	std::map<std::thread::id, Configuration> m_configurations;
+	/// Solver processes currently answering a query, by the thread that issued it.
+	std::map<std::thread::id, boost::process::child*> m_runningProcesses;
+	/// Running solver sessions, indexed by the thread using them and the solver's command line.
+	std::map<std::pair<std::thread::id, std::vector<std::string>>, std::unique_ptr<Session>> m_sessions;
 };
 
 }
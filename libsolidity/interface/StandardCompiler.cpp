@@ -44,6 +44,7 @@
 
 #include <algorithm>
 #include <optional>
+#include <set>
 
 using namespace solidity;
 using namespace solidity::yul;
@@ -85,6 +86,24 @@ Json formatFatalError(Error::Type _type, std::string const& _message)
 	return output;
 }
 
+/// @returns the output reporting the exception that is currently being handled.
+Json formatCurrentException()
+{
+	try
+	{
+		throw;
+	}
+	catch (UnimplementedFeatureError const& _exception)
+	{
+		solAssert(_exception.comment(), "Unimplemented feature errors must include a message for the user");
+		return formatFatalError(Error::Type::UnimplementedFeatureError, stringOrDefault(_exception.comment()));
+	}
+	catch (...)
+	{
+		return formatFatalError(Error::Type::InternalCompilerError, "Internal exception in StandardCompiler::compile: " +  boost::current_exception_diagnostic_information());
+	}
+}
+
 Json formatSourceLocation(SourceLocation const* location)
 {
 	if (!location || !location->sourceName)
@@ -433,13 +452,13 @@ std::optional<Json> checkAuxiliaryInputKeys(Json const& _input)
 
 std::optional<Json> checkSettingsKeys(Json const& _input)
 {
-	static std::set<std::string> keys{"debug", "evmVersion", "eofVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "stopAfter", "viaIR"};
+	static std::set<std::string> keys{"debug", "evmVersion", "eofVersion", "libraries", "metadata", "modelChecker", "optimizer", "optimizerCache", "outputSelection", "parallelism", "profiling", "remappings", "stopAfter", "viaIR"};
 	return checkKeys(_input, keys, "settings");
 }
 
 std::optional<Json> checkModelCheckerSettingsKeys(Json const& _input)
 {
-	static std::set<std::string> keys{"bmcLoopIterations", "contracts", "divModNoSlacks", "engine", "extCalls", "invariants", "printQuery", "showProvedSafe", "showUnproved", "showUnsupported", "solvers", "targets", "timeout"};
+	static std::set<std::string> keys{"bmcLoopIterations", "contracts", "divModNoSlacks", "engine", "extCalls", "invariants", "jobs", "printQuery", "raceSolvers", "showProvedSafe", "showUnproved", "showUnsupported", "solverSessions", "solvers", "targets", "timeout"};
 	return checkKeys(_input, keys, "modelChecker");
 }
 
@@ -449,6 +468,12 @@ std::optional<Json> checkOptimizerKeys(Json const& _input)
 	return checkKeys(_input, keys, "settings.optimizer");
 }
 
+std::optional<Json> checkOptimizerCacheKeys(Json const& _input)
+{
+	static std::set<std::string> keys{"directory", "sizeLimit"};
+	return checkKeys(_input, keys, "settings.optimizerCache");
+}
+
 std::optional<Json> checkOptimizerDetailsKeys(Json const& _input)
 {
 	static std::set<std::string> keys{"peephole", "inliner", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "constantOptimizer", "yul", "yulDetails", "simpleCounterForLoopUncheckedIncrement"};
@@ -824,6 +849,40 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 		ret.viaIR = settings["viaIR"].get<bool>();
 	}
 
+	if (settings.contains("parallelism"))
+	{
+		if (!settings["parallelism"].is_number_unsigned())
+			return formatFatalError(Error::Type::JSONError, "\"settings.parallelism\" must be an unsigned integer.");
+		ret.parallelism = settings["parallelism"].get<size_t>();
+	}
+
+	if (settings.contains("profiling"))
+	{
+		if (!settings["profiling"].is_boolean())
+			return formatFatalError(Error::Type::JSONError, "\"settings.profiling\" must be a Boolean.");
+		ret.profiling = settings["profiling"].get<bool>();
+	}
+
+	if (settings.contains("optimizerCache"))
+	{
+		Json const& optimizerCache = settings["optimizerCache"];
+		if (!optimizerCache.is_object())
+			return formatFatalError(Error::Type::JSONError, "\"settings.optimizerCache\" must be an object.");
+		if (auto result = checkOptimizerCacheKeys(optimizerCache))
+			return *result;
+
+		if (!optimizerCache.contains("directory") || !optimizerCache["directory"].is_string())
+			return formatFatalError(Error::Type::JSONError, "\"settings.optimizerCache.directory\" must be a string.");
+		ret.optimizerCacheDirectory = optimizerCache["directory"].get<std::string>();
+
+		if (optimizerCache.contains("sizeLimit"))
+		{
+			if (!optimizerCache["sizeLimit"].is_number_unsigned())
+				return formatFatalError(Error::Type::JSONError, "\"settings.optimizerCache.sizeLimit\" must be an unsigned integer.");
+			ret.optimizerCacheSizeLimit = optimizerCache["sizeLimit"].get<size_t>();
+		}
+	}
+
 	if (settings.contains("evmVersion"))
 	{
 		if (!settings["evmVersion"].is_string())
@@ -1097,6 +1156,13 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 		ret.modelCheckerSettings.invariants = invariants;
 	}
 
+	if (modelCheckerSettings.contains("jobs"))
+	{
+		if (!modelCheckerSettings["jobs"].is_number_unsigned())
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.jobs must be an unsigned integer.");
+		ret.modelCheckerSettings.jobs = modelCheckerSettings["jobs"].get<unsigned>();
+	}
+
 	if (modelCheckerSettings.contains("showProvedSafe"))
 	{
 		auto const& showProvedSafe = modelCheckerSettings["showProvedSafe"];
@@ -1121,6 +1187,14 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 		ret.modelCheckerSettings.showUnsupported = showUnsupported.get<bool>();
 	}
 
+	if (modelCheckerSettings.contains("solverSessions"))
+	{
+		auto const& solverSessions = modelCheckerSettings["solverSessions"];
+		if (!solverSessions.is_boolean())
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.solverSessions must be a Boolean value.");
+		ret.modelCheckerSettings.solverSessions = solverSessions.get<bool>();
+	}
+
 	if (modelCheckerSettings.contains("solvers"))
 	{
 		auto const& solversArray = modelCheckerSettings["solvers"];
@@ -1151,6 +1225,14 @@ std::variant<StandardCompiler::InputsAndSettings, Json> StandardCompiler::parseI
 		ret.modelCheckerSettings.printQuery = printQuery.get<bool>();
 	}
 
+	if (modelCheckerSettings.contains("raceSolvers"))
+	{
+		auto const& raceSolvers = modelCheckerSettings["raceSolvers"];
+		if (!raceSolvers.is_boolean())
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.raceSolvers must be a Boolean value.");
+		ret.modelCheckerSettings.raceSolvers = raceSolvers.get<bool>();
+	}
+
 	if (modelCheckerSettings.contains("targets"))
 	{
 		auto const& targetsArray = modelCheckerSettings["targets"];
@@ -1302,11 +1384,15 @@ Json StandardCompiler::importEVMAssembly(StandardCompiler::InputsAndSettings _in
 	return util::removeNullMembers(output);
 }
 
-Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+void StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings, OutputSink const& _output)
 {
 	solAssert(_inputsAndSettings.jsonSources.empty());
 
 	CompilerStack compilerStack(m_readFile);
+	if (m_objectOptimizer)
+		compilerStack.setObjectOptimizer(m_objectOptimizer);
+	if (m_parsedSourceCache)
+		compilerStack.setParsedSourceCache(m_parsedSourceCache);
 
 	StringMap sourceList = std::move(_inputsAndSettings.sources);
 	if (_inputsAndSettings.language == "Solidity")
@@ -1314,6 +1400,13 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
 		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
 	compilerStack.setViaIR(_inputsAndSettings.viaIR);
+	compilerStack.setParallelism(_inputsAndSettings.parallelism);
+	compilerStack.setProfiling(_inputsAndSettings.profiling);
+	if (_inputsAndSettings.optimizerCacheDirectory.has_value())
+		compilerStack.setOptimizerCacheDirectory(
+			*_inputsAndSettings.optimizerCacheDirectory,
+			_inputsAndSettings.optimizerCacheSizeLimit
+		);
 	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
 	compilerStack.setEOFVersion(_inputsAndSettings.eofVersion);
 	compilerStack.setRemappings(std::move(_inputsAndSettings.remappings));
@@ -1432,38 +1525,30 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 	if (compilationFailed || analysisFailed || !parsingSuccess)
 		solAssert(!errors.empty(), "No error reported, but compilation failed.");
 
-	Json output;
-
-	if (errors.size() > 0)
-		output["errors"] = std::move(errors);
-
+	// The members of the output are passed on sorted by their keys: auxiliaryInputRequested,
+	// contracts, errors, profiling and sources.
 	if (!compilerStack.unhandledSMTLib2Queries().empty())
+	{
+		Json smtlib2Queries;
 		for (std::string const& query: compilerStack.unhandledSMTLib2Queries())
-			output["auxiliaryInputRequested"]["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
+			smtlib2Queries["0x" + util::keccak256(query).hex()] = query;
+		_output({"auxiliaryInputRequested", "smtlib2queries"}, std::move(smtlib2Queries));
+	}
 
 	bool const wildcardMatchesExperimental = false;
 
-	output["sources"] = Json::object();
-	unsigned sourceIndex = 0;
-	// NOTE: A case that will pass `parsingSuccess && !analysisFailed` but not `analysisSuccess` is
-	// stopAfter: parsing with no parsing errors.
-	if (parsingSuccess && !analysisFailed)
-		for (std::string const& sourceName: compilerStack.sourceNames())
-		{
-			Json sourceResult;
-			sourceResult["id"] = sourceIndex++;
-			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
-				sourceResult["ast"] = ASTJsonExporter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
-			output["sources"][sourceName] = sourceResult;
-		}
-
-	Json contractsOutput;
+	// Fully qualified contract names do not necessarily sort like pairs of source unit and contract name.
+	std::set<std::pair<std::string, std::string>> sourceAndContractNames;
 	for (std::string const& contractName: analysisSuccess ? compilerStack.contractNames() : std::vector<std::string>())
 	{
 		size_t colon = contractName.rfind(':');
 		solAssert(colon != std::string::npos, "");
-		std::string file = contractName.substr(0, colon);
-		std::string name = contractName.substr(colon + 1);
+		sourceAndContractNames.emplace(contractName.substr(0, colon), contractName.substr(colon + 1));
+	}
+
+	for (auto const& [file, name]: sourceAndContractNames)
+	{
+		std::string const contractName = file + ":" + name;
 
 		// ABI, storage layout, documentation and metadata
 		Json contractData;
@@ -1551,16 +1636,29 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 			contractData["evm"] = evmData;
 
 		if (!contractData.empty())
-		{
-			if (!contractsOutput.contains(file))
-				contractsOutput[file] = Json::object();
-			contractsOutput[file][name] = contractData;
-		}
+			_output({"contracts", file, name}, std::move(contractData));
 	}
-	if (!contractsOutput.empty())
-		output["contracts"] = contractsOutput;
 
-	return output;
+	if (errors.size() > 0)
+		_output({"errors"}, std::move(errors));
+
+	if (compilerStack.profiler())
+		_output({"profiling"}, compilerStack.profiler()->toJson());
+
+	unsigned sourceIndex = 0;
+	// NOTE: A case that will pass `parsingSuccess && !analysisFailed` but not `analysisSuccess` is
+	// stopAfter: parsing with no parsing errors.
+	if (parsingSuccess && !analysisFailed)
+		for (std::string const& sourceName: compilerStack.sourceNames())
+		{
+			Json sourceResult;
+			sourceResult["id"] = sourceIndex++;
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
+				sourceResult["ast"] = ASTJsonExporter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
+			_output({"sources", sourceName}, std::move(sourceResult));
+		}
+	if (sourceIndex == 0)
+		_output({"sources"}, Json::object());
 }
 
 
@@ -1607,6 +1705,15 @@ Json StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		));
 		return output;
 	}
+	if (_inputsAndSettings.profiling)
+	{
+		output["errors"].emplace_back(formatError(
+			Error::Type::JSONError,
+			"general",
+			"Field \"settings.profiling\" cannot be used for Yul."
+		));
+		return output;
+	}
 
 	YulStack stack(
 		_inputsAndSettings.evmVersion,
@@ -1615,7 +1722,9 @@ Json StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		_inputsAndSettings.optimiserSettings,
 		_inputsAndSettings.debugInfoSelection.has_value() ?
 			_inputsAndSettings.debugInfoSelection.value() :
-			DebugInfoSelection::Default()
+			DebugInfoSelection::Default(),
+		nullptr, // _soliditySourceProvider
+		m_objectOptimizer
 	);
 	std::string const& sourceName = _inputsAndSettings.sources.begin()->first;
 	std::string const& sourceContents = _inputsAndSettings.sources.begin()->second;
@@ -1701,35 +1810,50 @@ Json StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 	return output;
 }
 
-Json StandardCompiler::compile(Json const& _input) noexcept
+void StandardCompiler::compile(Json const& _input, OutputSink const& _output)
 {
-	YulStringRepository::reset();
+	YulStringRepository::Scope yulStringScope;
+
+	auto outputMembers = [&](Json _result) {
+		for (auto&& member: _result.items())
+			_output({member.key()}, std::move(member.value()));
+	};
+
+	auto parsed = parseInput(_input);
+	if (std::holds_alternative<Json>(parsed))
+		return outputMembers(std::get<Json>(std::move(parsed)));
+	InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
+	if (m_objectOptimizer)
+		// Only use the on-disk cache if this compilation requests it.
+		m_objectOptimizer->setPersistentCache(nullptr);
+	if (settings.language == "Solidity")
+		compileSolidity(std::move(settings), _output);
+	else if (settings.language == "Yul")
+		outputMembers(compileYul(std::move(settings)));
+	else if (settings.language == "SolidityAST")
+		compileSolidity(std::move(settings), _output);
+	else if (settings.language == "EVMAssembly")
+		outputMembers(importEVMAssembly(std::move(settings)));
+	else
+		outputMembers(formatFatalError(Error::Type::JSONError, "Only \"Solidity\", \"Yul\", \"SolidityAST\" or \"EVMAssembly\" is supported as a language."));
+}
 
+Json StandardCompiler::compile(Json const& _input) noexcept
+{
 	try
 	{
-		auto parsed = parseInput(_input);
-		if (std::holds_alternative<Json>(parsed))
-			return std::get<Json>(std::move(parsed));
-		InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
-		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
-		else if (settings.language == "Yul")
-			return compileYul(std::move(settings));
-		else if (settings.language == "SolidityAST")
-			return compileSolidity(std::move(settings));
-		else if (settings.language == "EVMAssembly")
-			return importEVMAssembly(std::move(settings));
-		else
-			return formatFatalError(Error::Type::JSONError, "Only \"Solidity\", \"Yul\", \"SolidityAST\" or \"EVMAssembly\" is supported as a language.");
-	}
-	catch (UnimplementedFeatureError const& _exception)
-	{
-		solAssert(_exception.comment(), "Unimplemented feature errors must include a message for the user");
-		return formatFatalError(Error::Type::UnimplementedFeatureError, stringOrDefault(_exception.comment()));
+		Json output = Json::object();
+		compile(_input, [&](std::vector<std::string> const& _path, Json _value) {
+			Json* member = &output;
+			for (std::string const& key: _path)
+				member = &(*member)[key];
+			*member = std::move(_value);
+		});
+		return output;
 	}
 	catch (...)
 	{
-		return formatFatalError(Error::Type::InternalCompilerError, "Internal exception in StandardCompiler::compile: " +  boost::current_exception_diagnostic_information());
+		return formatCurrentException();
 	}
 }
 
@@ -1764,6 +1888,86 @@ std::string StandardCompiler::compile(std::string const& _input) noexcept
 	}
 }
 
+bool StandardCompiler::compile(std::string const& _input, std::ostream& _output) noexcept
+{
+	Json input;
+	bool inputValid = false;
+	try
+	{
+		inputValid = util::jsonParseStrict(_input, input);
+	}
+	catch (...)
+	{
+	}
+	if (!inputValid)
+	{
+		// Let the variant above report the error.
+		_output << compile(_input);
+		return true;
+	}
+
+	util::JsonStreamWriter writer(_output, m_jsonPrintingFormat);
+	bool outputStarted = false;
+	// The errors are known before the contracts are output, but come after them.
+	// Hold them back, so that exceptions while producing the contract output can still be reported.
+	std::optional<Json> errors;
+	bool errorsWritten = false;
+	auto writeErrors = [&]() {
+		if (errors)
+			writer.write({"errors"}, *errors);
+		errors.reset();
+		errorsWritten = true;
+	};
+
+	try
+	{
+		compile(input, [&](std::vector<std::string> const& _path, Json _value) {
+			solAssert(!_path.empty());
+			if (_path == std::vector<std::string>{"errors"})
+			{
+				errors = std::move(_value);
+				return;
+			}
+			if (!errorsWritten && _path.front() > "errors")
+				writeErrors();
+			writer.write(_path, _value);
+			outputStarted = true;
+		});
+	}
+	catch (...)
+	{
+		Json fatalError = formatCurrentException();
+		if (!outputStarted)
+		{
+			// Nothing written yet, so the output is the same as without streaming.
+			_output << util::jsonPrint(fatalError, m_jsonPrintingFormat);
+			return true;
+		}
+		if (errorsWritten)
+		{
+			writer.finish();
+			return false;
+		}
+		if (!errors)
+			errors = Json::array();
+		for (Json& error: fatalError["errors"])
+			errors->emplace_back(std::move(error));
+	}
+
+	try
+	{
+		if (!errorsWritten)
+			writeErrors();
+	}
+	catch (...)
+	{
+		writer.finish();
+		return false;
+	}
+	writer.finish();
+	return true;
+}
+
 Json StandardCompiler::formatFunctionDebugData(
 	std::map<std::string, evmasm::LinkerObject::FunctionDebugData> const& _debugInfo
 )
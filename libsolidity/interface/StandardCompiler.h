@@ -28,7 +28,10 @@
 
 #include <liblangutil/DebugInfoSelection.h>
 
+#include <functional>
+#include <memory>
 #include <optional>
+#include <ostream>
 #include <utility>
 #include <variant>
 
@@ -49,10 +52,19 @@ public:
 	/// Creates a new StandardCompiler.
 	/// @param _readFile callback used to read files for import statements. Must return
 	/// and must not emit exceptions.
+	/// @param _objectOptimizer if given, caches the optimized Yul objects of all compilations, so that
+	/// later ones can reuse them. The Yul string repository must not be reset while it is in use.
+	/// @param _parsedSourceCache if given, caches the source units parsed by all compilations, so that
+	/// later ones only parse the sources that changed. The Yul string repository must not be reset
+	/// while it is in use.
 	explicit StandardCompiler(ReadCallback::Callback _readFile = ReadCallback::Callback(),
-		util::JsonFormat const& _format = {}):
+		util::JsonFormat const& _format = {},
+		std::shared_ptr<yul::ObjectOptimizer> _objectOptimizer = nullptr,
+		std::shared_ptr<ParsedSourceCache> _parsedSourceCache = nullptr):
 		m_readFile(std::move(_readFile)),
-		m_jsonPrintingFormat(std::move(_format))
+		m_jsonPrintingFormat(std::move(_format)),
+		m_objectOptimizer(std::move(_objectOptimizer)),
+		m_parsedSourceCache(std::move(_parsedSourceCache))
 	{
 	}
 
@@ -62,6 +74,12 @@ public:
 	/// Parses input as JSON and performs the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
+	/// Like the above, but writes the output to @a _output. The output of each contract and source
+	/// is written as soon as it is produced, so that the whole output is never kept in memory.
+	/// Unlike above, an exception while producing the output of a contract is reported together
+	/// with the output written before it.
+	/// @returns false if the output is incomplete because of an exception after the errors were written.
+	bool compile(std::string const& _input, std::ostream& _output) noexcept;
 
 	static Json formatFunctionDebugData(
 		std::map<std::string, evmasm::LinkerObject::FunctionDebugData> const& _debugInfo
@@ -89,20 +107,33 @@ private:
 		Json outputSelection;
 		ModelCheckerSettings modelCheckerSettings = ModelCheckerSettings{};
 		bool viaIR = false;
+		size_t parallelism = 1;
+		bool profiling = false;
+		std::optional<std::string> optimizerCacheDirectory;
+		size_t optimizerCacheSizeLimit = yul::PersistentObjectCache::defaultSizeLimit;
 	};
 
+	/// Receives the members of the output one after another, sorted by their path of keys.
+	using OutputSink = std::function<void(std::vector<std::string> const& _path, Json _value)>;
+
+	/// Performs the compilation described by @a _input and passes the output to @a _output.
+	void compile(Json const& _input, OutputSink const& _output);
+
 	/// Parses the input json (and potentially invokes the read callback) and either returns
 	/// it in condensed form or an error as a json object.
 	std::variant<InputsAndSettings, Json> parseInput(Json const& _input);
 
 	std::map<std::string, Json> parseAstFromInput(StringMap const& _sources);
 	Json importEVMAssembly(InputsAndSettings _inputsAndSettings);
-	Json compileSolidity(InputsAndSettings _inputsAndSettings);
+	void compileSolidity(InputsAndSettings _inputsAndSettings, OutputSink const& _output);
 	Json compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
 
 	util::JsonFormat m_jsonPrintingFormat;
+
+	std::shared_ptr<yul::ObjectOptimizer> m_objectOptimizer;
+	std::shared_ptr<ParsedSourceCache> m_parsedSourceCache;
 };
 
 }
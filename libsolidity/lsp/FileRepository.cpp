@@ -101,6 +101,23 @@ void FileRepository::setSourceByUri(std::string const& _uri, std::string _source
 	m_sourceCodes[sourceUnitName] = std::move(_source);
 }
 
+void FileRepository::setSourceUnit(std::string const& _sourceUnitName, std::string _source)
+{
+	m_sourceCodes[_sourceUnitName] = std::move(_source);
+}
+
+std::set<std::string> FileRepository::changedSourceUnits(FileRepository const& _previous) const
+{
+	std::set<std::string> changed;
+	for (auto const& [sourceUnitName, source]: m_sourceCodes)
+		if (!_previous.m_sourceCodes.count(sourceUnitName) || _previous.m_sourceCodes.at(sourceUnitName) != source)
+			changed.insert(sourceUnitName);
+	for (auto const& [sourceUnitName, source]: _previous.m_sourceCodes)
+		if (!m_sourceCodes.count(sourceUnitName) && readFromFileSystem(sourceUnitName) != source)
+			changed.insert(sourceUnitName);
+	return changed;
+}
+
 Result<boost::filesystem::path> FileRepository::tryResolvePath(std::string const& _strippedSourceUnitName) const
 {
 	if (
@@ -176,3 +193,18 @@ frontend::ReadCallback::Result FileRepository::readFile(std::string const& _kind
 	}
 }
 
+
+std::optional<std::string> FileRepository::readFromFileSystem(std::string const& _sourceUnitName) const
+{
+	try
+	{
+		Result<boost::filesystem::path> const resolvedPath = tryResolvePath(stripFileUriSchemePrefix(_sourceUnitName));
+		if (!resolvedPath.message().empty())
+			return std::nullopt;
+		return readFileAsString(resolvedPath.get());
+	}
+	catch (...)
+	{
+		return std::nullopt;
+	}
+}
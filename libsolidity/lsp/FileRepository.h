@@ -20,8 +20,10 @@
 #include <libsolidity/interface/FileReader.h>
 #include <libsolutil/Result.h>
 
-#include <string>
 #include <map>
+#include <optional>
+#include <set>
+#include <string>
 
 namespace solidity::lsp
 {
@@ -48,7 +50,16 @@ public:
 	/// Changes the source identified by the LSP client path _uri to _text.
 	void setSourceByUri(std::string const& _uri, std::string _text);
 
+	/// Adds the source unit _sourceUnitName with content _source as if it had been loaded on import.
+	void setSourceUnit(std::string const& _sourceUnitName, std::string _source);
+
 	void setSourceUnits(StringMap _sources);
+
+	/// @returns the names of all source units whose content differs from the one in @a _previous,
+	/// including the ones that were added. Source units only present in @a _previous are
+	/// compared to the file system, since they are loaded again on import.
+	std::set<std::string> changedSourceUnits(FileRepository const& _previous) const;
+
 	frontend::ReadCallback::Result readFile(std::string const& _kind, std::string const& _sourceUnitName);
 	frontend::ReadCallback::Callback reader()
 	{
@@ -58,6 +69,10 @@ public:
 	util::Result<boost::filesystem::path> tryResolvePath(std::string const& _sourceUnitName) const;
 
 private:
+	/// Reads the source unit from the file system without storing it.
+	/// @returns std::nullopt if it cannot be resolved or read.
+	std::optional<std::string> readFromFileSystem(std::string const& _sourceUnitName) const;
+
 	/// Base path without URI scheme.
 	boost::filesystem::path m_basePath;
 
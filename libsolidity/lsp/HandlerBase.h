@@ -45,8 +45,8 @@ public:
 	/// from the JSON-RPC parameters.
 	std::pair<std::string, langutil::LineColumn> extractSourceUnitNameAndLineColumn(Json const& _params) const;
 
-	langutil::CharStreamProvider const& charStreamProvider() const noexcept { return m_server.compilerStack(); }
-	FileRepository& fileRepository() const noexcept { return m_server.fileRepository(); }
+	langutil::CharStreamProvider const& charStreamProvider() const { return m_server.compilerStack(); }
+	FileRepository& fileRepository() const { return m_server.fileRepository(); }
 	Transport& client() const noexcept { return m_server.client(); }
 
 protected:
@@ -37,12 +37,19 @@
 #include <libsolutil/Visitor.h>
 #include <libsolutil/JSON.h>
 
+#include <range/v3/algorithm/any_of.hpp>
+#include <range/v3/range/conversion.hpp>
+#include <range/v3/view/map.hpp>
+
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 
+#include <algorithm>
 #include <ostream>
 #include <string>
+#include <thread>
+#include <utility>
 
 #include <fmt/format.h>
 
@@ -134,26 +141,74 @@ Json semanticTokensLegend()
 LanguageServer::LanguageServer(Transport& _transport):
 	m_client{_transport},
 	m_handlers{
-		{"$/cancelRequest", [](auto, auto) {/*nothing for now as we are synchronous */}},
-		{"cancelRequest", [](auto, auto) {/*nothing for now as we are synchronous */}},
+		{"$/cancelRequest", [this](auto, Json const& args) { if (args.contains("id")) cancelRequest(args["id"]); }},
+		{"cancelRequest", [this](auto, Json const& args) { if (args.contains("id")) cancelRequest(args["id"]); }},
 		{"exit", [this](auto, auto) { m_state = (m_state == State::ShutdownRequested ? State::ExitRequested : State::ExitWithoutShutdown); }},
 		{"initialize", std::bind(&LanguageServer::handleInitialize, this, _1, _2)},
 		{"initialized", std::bind(&LanguageServer::handleInitialized, this, _1, _2)},
 		{"$/setTrace", [this](auto, Json const& args) { setTrace(args["value"]); }},
 		{"shutdown", [this](auto, auto) { m_state = State::ShutdownRequested; }},
-		{"textDocument/definition", GotoDefinition(*this) },
+		{"textDocument/definition", onAnalysisThread(GotoDefinition(*this)) },
 		{"textDocument/didOpen", std::bind(&LanguageServer::handleTextDocumentDidOpen, this, _2)},
 		{"textDocument/didChange", std::bind(&LanguageServer::handleTextDocumentDidChange, this, _2)},
 		{"textDocument/didClose", std::bind(&LanguageServer::handleTextDocumentDidClose, this, _2)},
-		{"textDocument/hover", DocumentHoverHandler(*this) },
-		{"textDocument/rename", RenameSymbol(*this) },
-		{"textDocument/implementation", GotoDefinition(*this) },
-		{"textDocument/semanticTokens/full", std::bind(&LanguageServer::semanticTokensFull, this, _1, _2)},
+		{"textDocument/hover", onAnalysisThread(DocumentHoverHandler(*this)) },
+		{"textDocument/rename", onAnalysisThread(RenameSymbol(*this), true /* _allSourceUnits */) },
+		{"textDocument/implementation", onAnalysisThread(GotoDefinition(*this)) },
+		{"textDocument/semanticTokens/full", onAnalysisThread(std::bind(&LanguageServer::semanticTokensFull, this, _1, _2))},
 		{"workspace/didChangeConfiguration", std::bind(&LanguageServer::handleWorkspaceDidChangeConfiguration, this, _2)},
 	},
-	m_fileRepository("/" /* basePath */, {} /* no search paths */),
-	m_compilerStack{m_fileRepository.reader()}
+	m_fileRepository("/" /* basePath */, {} /* no search paths */)
+{
+}
+
+LanguageServer::AnalysisThread::AnalysisThread()
 {
+	m_thread = std::thread([this]() { run(); });
+}
+
+LanguageServer::AnalysisThread::~AnalysisThread()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_condition.notify_one();
+	m_thread.join();
+}
+
+void LanguageServer::AnalysisThread::post(std::function<void()> _task)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_tasks.emplace_back(std::move(_task));
+	}
+	m_condition.notify_one();
+}
+
+CompilerStack& LanguageServer::AnalysisThread::compilerStack()
+{
+	solAssert(isCurrentThread() && m_compilerStack);
+	return *m_compilerStack;
+}
+
+void LanguageServer::AnalysisThread::run()
+{
+	m_compilerStack = std::make_unique<CompilerStack>(m_fileRepository.reader());
+	while (true)
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_condition.wait(lock, [&]() { return !m_tasks.empty() || m_stopping; });
+			if (m_tasks.empty())
+				break;
+			task = std::move(m_tasks.front());
+			m_tasks.pop_front();
+		}
+		task();
+	}
+	m_compilerStack.reset();
 }
 
 Json LanguageServer::toRange(SourceLocation const& _location)
@@ -189,6 +244,7 @@ void LanguageServer::changeConfiguration(Json const& _settings)
 	}
 
 	m_settingsObject = _settings;
+	m_configurationChanged = true;
 	Json jsonIncludePaths = _settings.contains("include-paths") ? _settings["include-paths"] : Json::object();
 
 	if (!jsonIncludePaths.empty())
@@ -214,7 +270,7 @@ void LanguageServer::changeConfiguration(Json const& _settings)
 	}
 }
 
-std::vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject() const
+std::vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject(fs::path const& _basePath)
 {
 	std::vector<fs::path> collectedPaths{};
 
@@ -222,9 +278,9 @@ std::vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject
 	// open for a future PR to enable such a feature to be optionally enabled (default disabled).
 	// Note: Newer versions of boost have deprecated symlink_option::recurse
 #if (BOOST_VERSION < 107200)
-	auto directoryIterator = fs::recursive_directory_iterator(m_fileRepository.basePath(), fs::symlink_option::recurse);
+	auto directoryIterator = fs::recursive_directory_iterator(_basePath, fs::symlink_option::recurse);
 #else
-	auto directoryIterator = fs::recursive_directory_iterator(m_fileRepository.basePath(), fs::directory_options::follow_directory_symlink);
+	auto directoryIterator = fs::recursive_directory_iterator(_basePath, fs::directory_options::follow_directory_symlink);
 #endif
 	for (fs::directory_entry const& dirEntry: directoryIterator)
 		if (
@@ -236,52 +292,175 @@ std::vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject
 	return collectedPaths;
 }
 
-void LanguageServer::compile()
+bool LanguageServer::compile(CompilationInput const& _input)
 {
 	// For files that are not open, we have to take changes on disk into account,
-	// so we just remove all non-open files.
-
-	FileRepository oldRepository(m_fileRepository.basePath(), m_fileRepository.includePaths());
-	std::swap(oldRepository, m_fileRepository);
+	// so we start from scratch and only take over the open files.
+	FileRepository& files = fileRepository();
+	files = FileRepository(_input.documents.basePath(), _input.documents.includePaths());
 
 	// Load all solidity files from project.
-	if (m_fileLoadStrategy == FileLoadStrategy::ProjectDirectory)
-		for (auto const& projectFile: allSolidityFilesFromProject())
+	if (_input.fileLoadStrategy == FileLoadStrategy::ProjectDirectory)
+		for (auto const& projectFile: allSolidityFilesFromProject(files.basePath()))
 		{
 			lspDebug(fmt::format("adding project file: {}", projectFile.generic_string()));
-			m_fileRepository.setSourceByUri(
-				m_fileRepository.sourceUnitNameToUri(projectFile.generic_string()),
+			files.setSourceByUri(
+				files.sourceUnitNameToUri(projectFile.generic_string()),
 				util::readFileAsString(projectFile)
 			);
 		}
 
 	// Overwrite all files as opened by the client, including the ones which might potentially have changes.
-	for (std::string const& fileName: m_openFiles)
-		m_fileRepository.setSourceByUri(
+	for (std::string const& fileName: _input.openFiles)
+		files.setSourceByUri(
 			fileName,
-			oldRepository.sourceUnits().at(oldRepository.uriToSourceUnitName(fileName))
+			_input.documents.sourceUnits().at(_input.documents.uriToSourceUnitName(fileName))
 		);
 
-	// TODO: optimize! do not recompile if nothing has changed (file(s) not flagged dirty).
+	StringMap const sources = files.sourceUnits();
+	std::set<std::string> sourceUnitNames;
+	for (std::string const& sourceUnitName: sources | ranges::views::keys)
+		sourceUnitNames.insert(sourceUnitName);
+
+	m_analyzedSourceUnits.clear();
+	if (_input.configurationChanged)
+		// Imports might resolve differently now.
+		m_compiledSourceUnits.reset();
+
+	if (m_analysisSuccessful && m_compiledSourceUnits == sourceUnitNames)
+	{
+		// The files that are not open anymore are compared to their content on disk.
+		std::set<std::string> const changedSourceUnits = files.changedSourceUnits(m_compiledFiles);
+		// Nothing changed since the last compilation. Keep its results, unless the requests
+		// are still answered from an older one.
+		if (changedSourceUnits.empty() && m_analysisPublished)
+			return false;
+		if (compileAffectedSourceUnits(sources, changedSourceUnits))
+		{
+			m_compiledFiles = files;
+			return true;
+		}
+		if (compilationCancelled())
+			return false;
+	}
 
-	m_compilerStack.reset(false);
-	m_compilerStack.setSources(m_fileRepository.sourceUnits());
-	m_compilerStack.compile(CompilerStack::State::AnalysisSuccessful);
+	if (!compileAllSourceUnits(sources))
+		return false;
+	m_compiledSourceUnits = std::move(sourceUnitNames);
+	m_compiledFiles = files;
+	return true;
 }
 
-void LanguageServer::compileAndUpdateDiagnostics()
+bool LanguageServer::compileAffectedSourceUnits(
+	StringMap const& _sources,
+	std::set<std::string> const& _changedSourceUnits
+)
 {
-	compile();
+	// The ASTs cannot be reused across compilations, but only the source units that
+	// import a changed source unit, directly or indirectly, need to be analysed again.
+	std::set<std::string> affected = _changedSourceUnits;
+	for (bool grown = true; grown;)
+	{
+		grown = false;
+		for (auto const& [sourceUnitName, imports]: m_sourceUnitImports)
+			if (
+				!affected.count(sourceUnitName) &&
+				ranges::any_of(imports, [&](std::string const& _import) { return affected.count(_import) > 0; })
+			)
+			{
+				affected.insert(sourceUnitName);
+				grown = true;
+			}
+	}
 
-	// These are the source units we will sent diagnostics to the client for sure,
-	// even if it is just to clear previous diagnostics.
-	std::map<std::string, Json> diagnosticsBySourceUnit;
-	for (std::string const& sourceUnitName: m_fileRepository.sourceUnits() | ranges::views::keys)
-		diagnosticsBySourceUnit[sourceUnitName] = Json::array();
-	for (std::string const& sourceUnitName: m_nonemptyDiagnostics)
-		diagnosticsBySourceUnit[sourceUnitName] = Json::array();
+	StringMap affectedSources;
+	for (auto const& [sourceUnitName, source]: _sources)
+		if (affected.count(sourceUnitName))
+			affectedSources.emplace(sourceUnitName, source);
+	if (affectedSources.empty() || affectedSources.size() == _sources.size())
+		return false;
+
+	if (!analyzeSources(affectedSources))
+		return false;
+	// Errors stop the analysis of all source units, so the diagnostics of the unaffected
+	// ones would not match those of a full compilation.
+	if (compilerStack().state() < CompilerStack::State::AnalysisSuccessful)
+		return false;
+
+	for (std::string const& sourceUnitName: compilerStack().sourceNames())
+	{
+		m_sourceUnitImports.erase(sourceUnitName);
+		m_diagnostics.erase(sourceUnitName);
+	}
+	recordAnalysisResults();
+	m_analyzedSourceUnits = compilerStack().sourceNames() | ranges::to<std::set<std::string>>;
+
+	// Keep the unchanged files that are still imported by an unaffected source unit and
+	// forget about the ones that are not imported anymore.
+	std::set<std::string> reachable;
+	std::vector<std::string> toVisit = _sources | ranges::views::keys | ranges::to<std::vector<std::string>>;
+	while (!toVisit.empty())
+	{
+		std::string sourceUnitName = std::move(toVisit.back());
+		toVisit.pop_back();
+		if (!reachable.insert(sourceUnitName).second)
+			continue;
+		if (!fileRepository().sourceUnits().count(sourceUnitName))
+			fileRepository().setSourceUnit(sourceUnitName, m_compiledFiles.sourceUnits().at(sourceUnitName));
+		for (std::string const& import: m_sourceUnitImports.at(sourceUnitName))
+			toVisit.push_back(import);
+	}
+	for (auto it = m_sourceUnitImports.begin(); it != m_sourceUnitImports.end();)
+		if (reachable.count(it->first))
+			++it;
+		else
+		{
+			m_diagnostics.erase(it->first);
+			it = m_sourceUnitImports.erase(it);
+		}
+
+	m_partiallyCompiled = true;
+	return true;
+}
+
+bool LanguageServer::compileAllSourceUnits(StringMap const& _sources)
+{
+	if (!analyzeSources(_sources))
+		return false;
+
+	m_sourceUnitImports.clear();
+	m_diagnostics.clear();
+	recordAnalysisResults();
+	m_analyzedSourceUnits = compilerStack().sourceNames() | ranges::to<std::set<std::string>>;
+	m_partiallyCompiled = false;
+	return true;
+}
+
+bool LanguageServer::analyzeSources(StringMap const& _sources)
+{
+	CompilerStack& stack = currentAnalysisThread().compilerStack();
+	stack.reset(false);
+	stack.setSources(_sources);
+	bool const parsed = stack.parse();
+	if (compilationCancelled())
+		return false;
+	if (parsed)
+		stack.analyze();
+	return !compilationCancelled();
+}
+
+void LanguageServer::recordAnalysisResults()
+{
+	m_analysisSuccessful = compilerStack().state() >= CompilerStack::State::AnalysisSuccessful;
+	if (m_analysisSuccessful)
+		for (std::string const& sourceUnitName: compilerStack().sourceNames())
+		{
+			std::set<std::string>& imports = m_sourceUnitImports[sourceUnitName];
+			for (SourceUnit const* importedSourceUnit: compilerStack().ast(sourceUnitName).referencedSourceUnits())
+				imports.insert(*importedSourceUnit->location().sourceName);
+		}
 
-	for (std::shared_ptr<Error const> const& error: m_compilerStack.errors())
+	for (std::shared_ptr<Error const> const& error: compilerStack().errors())
 	{
 		SourceLocation const* location = error->sourceLocation();
 		if (!location || !location->sourceName)
@@ -307,13 +486,85 @@ void LanguageServer::compileAndUpdateDiagnostics()
 				jsonDiag["relatedInformation"].emplace_back(jsonRelated);
 			}
 
-		diagnosticsBySourceUnit[*location->sourceName].emplace_back(jsonDiag);
+		m_diagnostics[*location->sourceName].emplace_back(std::move(jsonDiag));
+	}
+}
+
+bool LanguageServer::compileAndUpdateDiagnostics(CompilationInput const& _input)
+{
+	bool const compiled = compile(_input);
+	if (compilationCancelled())
+		// The diagnostics would be outdated already, the change schedules another compilation.
+		return false;
+	publishDiagnostics();
+	if (!compiled)
+		return false;
+
+	std::optional<StringMap>& pendingSources = currentAnalysisThread().pendingSources();
+	pendingSources.reset();
+	if (m_partiallyCompiled)
+	{
+		// The requests are answered from the partial analysis. The source units it does not
+		// hold are only analysed once a request needs them, see completeAnalysis().
+		solAssert(m_compiledSourceUnits);
+		pendingSources.emplace();
+		for (std::string const& sourceUnitName: *m_compiledSourceUnits)
+			pendingSources->emplace(sourceUnitName, m_compiledFiles.sourceUnits().at(sourceUnitName));
+	}
+
+	bool anyAnalysisPublished = false;
+	{
+		std::lock_guard<std::mutex> lock(m_inboxMutex);
+		anyAnalysisPublished = m_publishedAnalysis != nullptr;
+	}
+	// Requests are rather answered from an older analysis than from a failed one.
+	m_analysisPublished = m_analysisSuccessful || !anyAnalysisPublished;
+	return m_analysisPublished;
+}
+
+void LanguageServer::completeAnalysis(Json const& _args, bool _allSourceUnits)
+{
+	std::optional<StringMap>& pendingSources = currentAnalysisThread().pendingSources();
+	if (!pendingSources)
+		return;
+
+	if (!_allSourceUnits && _args.contains("textDocument") && _args["textDocument"].contains("uri"))
+	{
+		std::string const sourceUnitName = fileRepository().uriToSourceUnitName(_args["textDocument"]["uri"].get<std::string>());
+		if (util::contains(compilerStack().sourceNames(), sourceUnitName))
+			return;
 	}
 
+	// The analysis of the affected source units succeeded, so the one of all source units
+	// does as well and leads to the diagnostics published already.
+	CompilerStack& stack = currentAnalysisThread().compilerStack();
+	stack.reset(false);
+	stack.setSources(*std::exchange(pendingSources, std::nullopt));
+	if (stack.parse())
+		stack.analyze();
+}
+
+void LanguageServer::publishDiagnostics()
+{
+	// These are the source units we will sent diagnostics to the client for sure,
+	// even if it is just to clear previous diagnostics.
+	std::map<std::string, Json> diagnosticsBySourceUnit;
+	for (std::string const& sourceUnitName: m_compiledFiles.sourceUnits() | ranges::views::keys)
+		diagnosticsBySourceUnit[sourceUnitName] = Json::array();
+	for (std::string const& sourceUnitName: m_nonemptyDiagnostics)
+		diagnosticsBySourceUnit[sourceUnitName] = Json::array();
+
+	for (auto const& [sourceUnitName, diagnostics]: m_diagnostics)
+		for (Json const& diagnostic: diagnostics)
+			diagnosticsBySourceUnit[sourceUnitName].emplace_back(diagnostic);
+
 	if (m_client.traceValue() != TraceValue::Off)
 	{
 		Json extra;
 		extra["openFileCount"] = Json(diagnosticsBySourceUnit.size());
+		extra["analyzedFiles"] = Json::array();
+		for (std::string const& sourceUnitName: m_analyzedSourceUnits)
+			extra["analyzedFiles"].emplace_back(m_compiledFiles.sourceUnitNameToUri(sourceUnitName));
 		m_client.trace("Number of currently open files: " + std::to_string(diagnosticsBySourceUnit.size()), extra);
 	}
 
@@ -321,7 +572,7 @@ void LanguageServer::compileAndUpdateDiagnostics()
 	for (auto&& [sourceUnitName, diagnostics]: diagnosticsBySourceUnit)
 	{
 		Json params;
-		params["uri"] = m_fileRepository.sourceUnitNameToUri(sourceUnitName);
+		params["uri"] = m_compiledFiles.sourceUnitNameToUri(sourceUnitName);
 		if (!diagnostics.empty())
 			m_nonemptyDiagnostics.insert(sourceUnitName);
 		params["diagnostics"] = std::move(diagnostics);
@@ -331,44 +582,307 @@ void LanguageServer::compileAndUpdateDiagnostics()
 
 bool LanguageServer::run()
 {
-	while (m_state != State::ExitRequested && m_state != State::ExitWithoutShutdown && !m_client.closed())
+	for (auto& analysisThread: m_analysisThreads)
+		analysisThread = std::make_unique<AnalysisThread>();
+	std::thread receiver([this]() { receiveMessages(); });
+
+	while (m_state != State::ExitRequested && m_state != State::ExitWithoutShutdown)
 	{
-		MessageID id;
-		try
-		{
-			std::optional<Json> const jsonMessage = m_client.receive();
-			if (!jsonMessage)
-				continue;
+		std::optional<Json> const jsonMessage = nextMessage();
+		if (jsonMessage)
+			handleMessage(*jsonMessage);
+		else if (m_diagnosticsOutdated)
+			startCompilation();
+		else
+			break;
+	}
 
-			if ((*jsonMessage).contains("method") && (*jsonMessage)["method"].is_string())
-			{
-				std::string const methodName = (*jsonMessage)["method"].get<std::string>();
-				if ((*jsonMessage).contains("id"))
-					id = (*jsonMessage)["id"];
-				lspDebug(fmt::format("received method call: {}", methodName));
+	// Receiving stops after the exit notification or when the transport was closed.
+	receiver.join();
+	// The running compilation passes the requests waiting for it on to the other thread.
+	{
+		std::unique_lock<std::mutex> lock(m_inboxMutex);
+		m_inboxCondition.wait(lock, [&]() { return !m_compilationRunning; });
+	}
+	// Answers the queued requests before stopping.
+	for (auto& analysisThread: m_analysisThreads)
+		analysisThread.reset();
+	return m_state == State::ExitRequested;
+}
 
-				if (auto handler = util::valueOrDefault(m_handlers, methodName))
-					handler(id, (*jsonMessage)["params"]);
-				else
-					m_client.error(id, ErrorCode::MethodNotFound, "Unknown method " + methodName);
+void LanguageServer::handleMessage(Json const& _message)
+{
+	MessageID id;
+	try
+	{
+		if (_message.contains("method") && _message["method"].is_string())
+		{
+			std::string const methodName = _message["method"].get<std::string>();
+			if (_message.contains("id"))
+			{
+				id = _message["id"];
+				if (requestCancelled(id))
+				{
+					m_client.error(id, ErrorCode::RequestCancelled, "Request cancelled.");
+					return;
+				}
 			}
+			lspDebug(fmt::format("received method call: {}", methodName));
+
+			if (auto handler = util::valueOrDefault(m_handlers, methodName))
+				invokeHandler(handler, id, _message["params"]);
 			else
-				m_client.error({}, ErrorCode::ParseError, "\"method\" has to be a string.");
+				m_client.error(id, ErrorCode::MethodNotFound, "Unknown method " + methodName);
 		}
-		catch (Json::exception const&)
+		else
+			m_client.error({}, ErrorCode::ParseError, "\"method\" has to be a string.");
+	}
+	catch (Json::exception const&)
+	{
+		m_client.error(id, ErrorCode::InvalidParams, "JSON object access error. Most likely due to a badly formatted JSON request message."s);
+	}
+}
+
+void LanguageServer::invokeHandler(MessageHandler const& _handler, MessageID const& _id, Json const& _args)
+{
+	try
+	{
+		_handler(_id, _args);
+	}
+	catch (Json::exception const&)
+	{
+		m_client.error(_id, ErrorCode::InvalidParams, "JSON object access error. Most likely due to a badly formatted JSON request message."s);
+	}
+	catch (RequestError const& error)
+	{
+		m_client.error(_id, error.code(), error.comment() ? *error.comment() : ""s);
+	}
+	catch (...)
+	{
+		m_client.error(_id, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
+	}
+}
+
+LanguageServer::MessageHandler LanguageServer::onAnalysisThread(MessageHandler _handler, bool _allSourceUnits)
+{
+	return [this, handler = std::move(_handler), _allSourceUnits](MessageID _id, Json const& _args) {
+		std::function<void()> request = [this, handler, _allSourceUnits, _id, _args]() {
+			if (requestCancelled(_id))
+				m_client.error(_id, ErrorCode::RequestCancelled, "Request cancelled.");
+			else
+				invokeHandler(
+					[&](MessageID, Json const&) {
+						completeAnalysis(_args, _allSourceUnits);
+						handler(_id, _args);
+					},
+					_id,
+					_args
+				);
+		};
+
+		std::optional<std::string> uri;
+		if (!_allSourceUnits && _args.contains("textDocument") && _args["textDocument"].contains("uri"))
+			uri = _args["textDocument"]["uri"].get<std::string>();
+
+		// Requests are answered from the last successful analysis unless the documents they
+		// refer to changed since. Otherwise they wait for the compilation of the changes.
+		std::lock_guard<std::mutex> lock(m_inboxMutex);
+		if (m_publishedAnalysis && !m_compilationRunning && !documentsChanged(uri, m_publishedDocumentVersions))
+			m_publishedAnalysis->post(std::move(request));
+		else
+			m_deferredRequests.push_back({_id, std::move(uri), std::move(request)});
+	};
+}
+
+bool LanguageServer::documentsChanged(std::optional<std::string> const& _uri, DocumentVersions const& _versions) const
+{
+	if (!_uri)
+		return m_documentVersions != _versions;
+
+	auto const versionIn = [&](DocumentVersions const& _documentVersions) {
+		auto it = _documentVersions.find(*_uri);
+		return it == _documentVersions.end() ? 0u : it->second;
+	};
+	return versionIn(m_documentVersions) != versionIn(_versions);
+}
+
+void LanguageServer::documentChanged(std::string const& _uri)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_inboxMutex);
+		++m_documentVersions[_uri];
+	}
+	scheduleCompilation();
+}
+
+void LanguageServer::cancelRequest(MessageID const& _id)
+{
+	std::unique_lock<std::mutex> lock(m_inboxMutex);
+	auto const deferredRequest = std::find_if(
+		m_deferredRequests.begin(),
+		m_deferredRequests.end(),
+		[&](auto const& _request) { return _request.id == _id; }
+	);
+	if (deferredRequest != m_deferredRequests.end())
+	{
+		m_deferredRequests.erase(deferredRequest);
+		m_cancelledRequests.erase(_id);
+		lock.unlock();
+		m_client.error(_id, ErrorCode::RequestCancelled, "Request cancelled.");
+	}
+	else if (m_publishedAnalysis)
+		// The request might still be queued on the analysis thread, which then handles
+		// the cancellation after it.
+		m_publishedAnalysis->post([this, _id]() { requestCancelled(_id); });
+	else
+		// The cancelled request was handled before its cancellation, so only forget about the latter.
+		m_cancelledRequests.erase(_id);
+}
+
+LanguageServer::AnalysisThread& LanguageServer::currentAnalysisThread()
+{
+	for (auto const& analysisThread: m_analysisThreads)
+		if (analysisThread && analysisThread->isCurrentThread())
+			return *analysisThread;
+	solAssert(false, "Analysis accessed outside of the analysis threads.");
+}
+
+FileRepository& LanguageServer::fileRepository()
+{
+	return currentAnalysisThread().fileRepository();
+}
+
+CompilerStack const& LanguageServer::compilerStack()
+{
+	return currentAnalysisThread().compilerStack();
+}
+
+void LanguageServer::receiveMessages()
+{
+	bool exitRequested = false;
+	while (!exitRequested && !m_client.closed())
+	{
+		std::optional<Json> jsonMessage;
+		try
+		{
+			jsonMessage = m_client.receive();
+		}
+		catch (...)
 		{
-			m_client.error(id, ErrorCode::InvalidParams, "JSON object access error. Most likely due to a badly formatted JSON request message."s);
+			m_client.error({}, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
 		}
-		catch (RequestError const& error)
+		if (!jsonMessage)
+			continue;
+
+		Json const method = jsonMessage->value("method", Json{});
+		exitRequested = (method == "exit");
+
+		std::lock_guard<std::mutex> lock(m_inboxMutex);
+		// Cancellations take effect right away, even if the cancelled request is queued already.
+		if (method == "$/cancelRequest" && jsonMessage->contains("params") && (*jsonMessage)["params"].contains("id"))
+			m_cancelledRequests.insert((*jsonMessage)["params"]["id"]);
+		m_inbox.emplace_back(std::move(*jsonMessage));
+		m_inboxCondition.notify_one();
+	}
+
+	std::lock_guard<std::mutex> lock(m_inboxMutex);
+	m_inputClosed = true;
+	m_inboxCondition.notify_one();
+}
+
+std::optional<Json> LanguageServer::nextMessage()
+{
+	std::unique_lock<std::mutex> lock(m_inboxMutex);
+	auto const messageQueuedOrInputClosed = [&]() { return !m_inbox.empty() || m_inputClosed; };
+	if (m_diagnosticsOutdated)
+	{
+		// The compilation cancelled by the change has to stop before compiling again.
+		m_inboxCondition.wait(lock, [&]() { return !m_inbox.empty() || !m_compilationRunning; });
+		if (!m_compilationRunning)
+			m_inboxCondition.wait_until(lock, m_lastDocumentChange + CompilationDelay, messageQueuedOrInputClosed);
+	}
+	else
+		m_inboxCondition.wait(lock, messageQueuedOrInputClosed);
+
+	if (m_inbox.empty())
+		return std::nullopt;
+	Json message = std::move(m_inbox.front());
+	m_inbox.pop_front();
+	return message;
+}
+
+bool LanguageServer::requestCancelled(MessageID const& _id)
+{
+	std::lock_guard<std::mutex> lock(m_inboxMutex);
+	return m_cancelledRequests.erase(_id) > 0;
+}
+
+void LanguageServer::scheduleCompilation()
+{
+	m_diagnosticsOutdated = true;
+	m_lastDocumentChange = std::chrono::steady_clock::now();
+	m_compilationCancelled = true;
+}
+
+void LanguageServer::startCompilation()
+{
+	m_diagnosticsOutdated = false;
+	m_compilationCancelled = false;
+	AnalysisThread* analysisThread = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(m_inboxMutex);
+		m_compilationRunning = true;
+		// The other thread may still answer requests from the last successful analysis.
+		analysisThread = m_analysisThreads[m_publishedAnalysis == m_analysisThreads[0].get() ? 1 : 0].get();
+	}
+
+	CompilationInput input{m_fileRepository, m_documentVersions, m_openFiles, m_fileLoadStrategy, std::exchange(m_configurationChanged, false)};
+	analysisThread->post([this, analysisThread, input = std::move(input)]() {
+		bool publishAnalysis = false;
+		bool analysisUpToDate = false;
+		try
 		{
-			m_client.error(id, error.code(), error.comment() ? *error.comment() : ""s);
+			publishAnalysis = compileAndUpdateDiagnostics(input);
+			analysisUpToDate = !compilationCancelled() && m_analysisPublished;
 		}
 		catch (...)
 		{
-			m_client.error(id, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
+			m_client.error({}, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
+			// The cached results might be incomplete.
+			m_compiledSourceUnits.reset();
 		}
-	}
-	return m_state == State::ExitRequested;
+
+		std::vector<MessageID> outdatedRequests;
+		{
+			std::lock_guard<std::mutex> lock(m_inboxMutex);
+			if (publishAnalysis)
+				m_publishedAnalysis = analysisThread;
+			if (analysisUpToDate)
+				m_publishedDocumentVersions = input.documentVersions;
+			if (m_publishedAnalysis)
+			{
+				std::vector<DeferredRequest> deferredRequests;
+				for (auto& deferredRequest: m_deferredRequests)
+					if (!documentsChanged(deferredRequest.uri, m_publishedDocumentVersions))
+						m_publishedAnalysis->post(std::move(deferredRequest.request));
+					else if (documentsChanged(deferredRequest.uri, input.documentVersions))
+						// The request waits for the compilation scheduled by the later change.
+						deferredRequests.emplace_back(std::move(deferredRequest));
+					else
+						// The changed documents were compiled, but the requests are still
+						// answered from an older analysis.
+						outdatedRequests.emplace_back(deferredRequest.id);
+				m_deferredRequests = std::move(deferredRequests);
+			}
+			m_compilationRunning = false;
+			m_inboxCondition.notify_one();
+		}
+		for (MessageID const& id: outdatedRequests)
+			if (requestCancelled(id))
+				m_client.error(id, ErrorCode::RequestCancelled, "Request cancelled.");
+			else
+				m_client.error(id, ErrorCode::ContentModified, "Document changed since its last successful analysis.");
+	});
 }
 
 void LanguageServer::requireServerInitialized()
@@ -432,7 +946,7 @@ void LanguageServer::handleInitialize(MessageID _id, Json const& _args)
 void LanguageServer::handleInitialized(MessageID, Json const&)
 {
 	if (m_fileLoadStrategy == FileLoadStrategy::ProjectDirectory)
-		compileAndUpdateDiagnostics();
+		scheduleCompilation();
 }
 
 void LanguageServer::semanticTokensFull(MessageID _id, Json const& _args)
@@ -441,12 +955,15 @@ void LanguageServer::semanticTokensFull(MessageID _id, Json const& _args)
 	{
 		auto uri = _args["textDocument"]["uri"];
 
-		compile();
-
-		auto const sourceName = m_fileRepository.uriToSourceUnitName(uri.get<std::string>());
-		SourceUnit const& ast = m_compilerStack.ast(sourceName);
-		m_compilerStack.charStream(sourceName);
-		Json data = SemanticTokensBuilder().build(ast, m_compilerStack.charStream(sourceName));
+		auto const sourceName = fileRepository().uriToSourceUnitName(uri.get<std::string>());
+		if (!fileRepository().sourceUnits().count(sourceName))
+		{
+			// The document was not compiled yet.
+			m_client.reply(_id, Json{});
+			return;
+		}
+		SourceUnit const& ast = compilerStack().ast(sourceName);
+		Json data = SemanticTokensBuilder().build(ast, compilerStack().charStream(sourceName));
 
 		Json reply;
 		reply["data"] = data;
@@ -496,7 +1013,7 @@ void LanguageServer::handleTextDocumentDidOpen(Json const& _args)
 		std::string uri = _args["textDocument"]["uri"].get<std::string>();
 		m_openFiles.insert(uri);
 		m_fileRepository.setSourceByUri(uri, std::move(text));
-		compileAndUpdateDiagnostics();
+		documentChanged(uri);
 	}
 }
 
@@ -543,7 +1060,7 @@ void LanguageServer::handleTextDocumentDidChange(Json const& _args)
 				}
 			}
 
-		compileAndUpdateDiagnostics();
+		documentChanged(uri);
 	}
 }
 
@@ -562,7 +1079,7 @@ void LanguageServer::handleTextDocumentDidClose(Json const& _args)
 		std::string uri = _args["textDocument"]["uri"].get<std::string>();
 		m_openFiles.erase(uri);
 
-		compileAndUpdateDiagnostics();
+		documentChanged(uri);
 	}
 }
 
@@ -573,14 +1090,14 @@ ASTNode const* LanguageServer::astNodeAtSourceLocation(std::string const& _sourc
 
 std::tuple<ASTNode const*, int> LanguageServer::astNodeAndOffsetAtSourceLocation(std::string const& _sourceUnitName, LineColumn const& _filePos)
 {
-	if (m_compilerStack.state() < CompilerStack::AnalysisSuccessful)
+	if (!fileRepository().sourceUnits().count(_sourceUnitName))
 		return {nullptr, -1};
-	if (!m_fileRepository.sourceUnits().count(_sourceUnitName))
+	if (compilerStack().state() < CompilerStack::AnalysisSuccessful)
 		return {nullptr, -1};
 
-	std::optional<int> sourcePos = m_compilerStack.charStream(_sourceUnitName).translateLineColumnToPosition(_filePos);
+	std::optional<int> sourcePos = compilerStack().charStream(_sourceUnitName).translateLineColumnToPosition(_filePos);
 	if (!sourcePos)
 		return {nullptr, -1};
 
-	return {locateInnermostASTNode(*sourcePos, m_compilerStack.ast(_sourceUnitName)), *sourcePos};
+	return {locateInnermostASTNode(*sourcePos, compilerStack().ast(_sourceUnitName)), *sourcePos};
 }
@@ -24,10 +24,19 @@
 
 #include <libsolutil/JSON.h>
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace solidity::lsp
@@ -64,10 +73,14 @@ public:
 	/// @param _transport Customizable transport layer.
 	explicit LanguageServer(Transport& _transport);
 
-	/// Re-compiles the project and updates the diagnostics pushed to the client.
-	void compileAndUpdateDiagnostics();
+	/// Time to wait after the last change to a document before compiling again, so that
+	/// changes in quick succession only trigger a single compilation.
+	static constexpr std::chrono::milliseconds CompilationDelay{100};
 
 	/// Loops over incoming messages via the transport layer until shutdown condition is met.
+	/// Messages are received on a separate thread and handled on the calling thread, while
+	/// the project is compiled and the requests referring to its analysis are answered on
+	/// the analysis threads.
 	///
 	/// The standard shutdown condition is when the maximum number of consecutive failures
 	/// has been exceeded.
@@ -75,13 +88,72 @@ public:
 	/// @return boolean indicating normal or abnormal termination.
 	bool run();
 
-	FileRepository& fileRepository() noexcept { return m_fileRepository; }
+	/// @returns the files of the analysis the current request is answered from.
+	/// May only be called on an analysis thread.
+	FileRepository& fileRepository();
 	Transport& client() noexcept { return m_client; }
 	std::tuple<frontend::ASTNode const*, int> astNodeAndOffsetAtSourceLocation(std::string const& _sourceUnitName, langutil::LineColumn const& _filePos);
 	frontend::ASTNode const* astNodeAtSourceLocation(std::string const& _sourceUnitName, langutil::LineColumn const& _filePos);
-	frontend::CompilerStack const& compilerStack() const noexcept { return m_compilerStack; }
+	/// @returns the compiler stack of the analysis the current request is answered from.
+	/// May only be called on an analysis thread.
+	frontend::CompilerStack const& compilerStack();
 
 private:
+	using MessageHandler = std::function<void(MessageID, Json const&)>;
+
+	/**
+	 * Thread with its own compiler stack. Compilations as well as the requests answered from
+	 * their results run on it, since the types of an analysis belong to the type provider of
+	 * the thread that created them and there can only be one compiler stack per thread.
+	 */
+	class AnalysisThread
+	{
+	public:
+		AnalysisThread();
+		/// Runs the queued tasks before stopping the thread.
+		~AnalysisThread();
+
+		/// Queues @a _task to run after the tasks queued before.
+		void post(std::function<void()> _task);
+		bool isCurrentThread() const { return std::this_thread::get_id() == m_thread.get_id(); }
+
+		/// Files the compiler stack reads from.
+		FileRepository& fileRepository() noexcept { return m_fileRepository; }
+		frontend::CompilerStack& compilerStack();
+		/// Sources of the complete analysis if the compiler stack only holds the source units
+		/// affected by the last changes. Set until the analysis is completed on demand.
+		std::optional<StringMap>& pendingSources() noexcept { return m_pendingSources; }
+
+	private:
+		void run();
+
+		FileRepository m_fileRepository{"/" /* basePath */, {} /* no search paths */};
+		/// Created and destroyed on the thread itself.
+		std::unique_ptr<frontend::CompilerStack> m_compilerStack;
+		std::optional<StringMap> m_pendingSources;
+		std::deque<std::function<void()>> m_tasks;
+		bool m_stopping = false;
+		/// Guards m_tasks and m_stopping.
+		std::mutex m_mutex;
+		std::condition_variable m_condition;
+		std::thread m_thread;
+	};
+
+	/// Number of changes to each document (names in URI form) since the server started.
+	using DocumentVersions = std::map<std::string, unsigned>;
+
+	/// State of the documents a compilation starts from.
+	struct CompilationInput
+	{
+		FileRepository documents;
+		DocumentVersions documentVersions;
+		std::set<std::string> openFiles;
+		FileLoadStrategy fileLoadStrategy;
+		/// Whether the configuration changed since the last compilation, so that imports
+		/// might resolve differently.
+		bool configurationChanged;
+	};
+
 	/// Checks if the server is initialized (to be used by messages that need it to be initialized).
 	/// Reports an error and returns false if not.
 	void requireServerInitialized();
@@ -96,15 +168,76 @@ private:
 	void handleGotoDefinition(MessageID _id, Json const& _args);
 	void semanticTokensFull(MessageID _id, Json const& _args);
 
+	/// Handles a message on the thread handling the messages.
+	void handleMessage(Json const& _message);
+	/// Runs @a _handler and reports errors to the client.
+	void invokeHandler(MessageHandler const& _handler, MessageID const& _id, Json const& _args);
+	/// @returns a handler running @a _handler on the analysis thread holding the last successful
+	/// analysis. Requests arriving while a compilation runs or referring to documents that
+	/// changed since that analysis wait for the compilation of the changes. If it fails, they
+	/// are answered with ErrorCode::ContentModified.
+	/// @param _allSourceUnits whether the handler needs the analysis of all source units rather
+	/// than only the one of the document it refers to.
+	MessageHandler onAnalysisThread(MessageHandler _handler, bool _allSourceUnits = false);
+	/// Analyses all source units on the current analysis thread if it only holds the source
+	/// units affected by the last changes and the request with @a _args needs others.
+	void completeAnalysis(Json const& _args, bool _allSourceUnits);
+	/// Answers the request @a _id right away if it waits for a compilation.
+	void cancelRequest(MessageID const& _id);
+	/// @returns true if the document @a _uri, or any document if not set, differs from its
+	/// version in @a _versions. Requires m_inboxMutex to be held or to run on the thread
+	/// handling the messages.
+	bool documentsChanged(std::optional<std::string> const& _uri, DocumentVersions const& _versions) const;
+	/// Increases the version of the document @a _uri and schedules a compilation.
+	void documentChanged(std::string const& _uri);
+	/// @returns the analysis thread the current task runs on.
+	AnalysisThread& currentAnalysisThread();
+
+	/// Receives messages from the client and queues them until the transport is closed or
+	/// the client asks the server to exit.
+	void receiveMessages();
+	/// Waits for the next queued message, but at most until a scheduled compilation is due.
+	/// @returns std::nullopt if no message arrived in time or the transport was closed.
+	std::optional<Json> nextMessage();
+	/// @returns true if the request @a _id was cancelled by the client before it was handled.
+	bool requestCancelled(MessageID const& _id);
+	/// Compiles the project once no further changes arrived for CompilationDelay and cancels
+	/// the compilation that is running, since its results would be outdated.
+	void scheduleCompilation();
+	/// Starts compiling the current documents on the analysis thread that does not hold the
+	/// last successful analysis.
+	void startCompilation();
+	/// @returns true if a document changed since the running compilation started.
+	bool compilationCancelled() const { return m_compilationCancelled; }
+
 	/// Invoked when the server user-supplied configuration changes (initiated by the client).
 	void changeConfiguration(Json const&);
 
+	/// Compiles @a _input and updates the diagnostics pushed to the client. Runs on an analysis thread.
+	/// @returns true if the requests are to be answered from the analysis of this compilation.
+	bool compileAndUpdateDiagnostics(CompilationInput const& _input);
 	/// Compile everything until after analysis phase.
-	void compile();
+	/// Skips the compilation if no source unit has changed since the last one and only
+	/// re-analyses the source units that are affected by the changes if possible.
+	/// @returns true if the sources were compiled and the compilation was not cancelled.
+	bool compile(CompilationInput const& _input);
+	/// Compiles only the source units in @a _sources that are affected by changes to the
+	/// source units @a _changedSourceUnits.
+	/// @returns false if the analysis results would differ from those of a full compilation
+	/// or if the compilation was cancelled.
+	bool compileAffectedSourceUnits(StringMap const& _sources, std::set<std::string> const& _changedSourceUnits);
+	/// Compiles @a _sources until after analysis phase and replaces all cached analysis results.
+	/// @returns false if the compilation was cancelled.
+	bool compileAllSourceUnits(StringMap const& _sources);
+	/// Parses and analyses @a _sources, unless the compilation is cancelled after parsing.
+	/// @returns false if the compilation was cancelled.
+	bool analyzeSources(StringMap const& _sources);
+	/// Stores the imports and diagnostics of the source units analysed by the compiler stack.
+	void recordAnalysisResults();
+	/// Sends the diagnostics of the last compilation to the client.
+	void publishDiagnostics();
 
-	std::vector<boost::filesystem::path> allSolidityFilesFromProject() const;
-
-	using MessageHandler = std::function<void(MessageID, Json const&)>;
+	static std::vector<boost::filesystem::path> allSolidityFilesFromProject(boost::filesystem::path const& _basePath);
 
 	Json toRange(langutil::SourceLocation const& _location);
 	Json toJson(langutil::SourceLocation const& _location);
@@ -119,15 +252,79 @@ private:
 
 	/// Set of files (names in URI form) known to be open by the client.
 	std::set<std::string> m_openFiles;
-	/// Set of source unit names for which we sent diagnostics to the client in the last iteration.
-	std::set<std::string> m_nonemptyDiagnostics;
+	/// Documents as edited by the client. Compilations work on a copy.
 	FileRepository m_fileRepository;
 	FileLoadStrategy m_fileLoadStrategy = FileLoadStrategy::ProjectDirectory;
-
-	frontend::CompilerStack m_compilerStack;
+	/// Whether the configuration changed since the last compilation started.
+	bool m_configurationChanged = false;
 
 	/// User-supplied custom configuration settings (such as EVM version).
 	Json m_settingsObject;
+
+	// Results of the compilations, only accessed by the compilation running on one of the
+	// analysis threads.
+
+	/// Set of source unit names for which we sent diagnostics to the client in the last iteration.
+	std::set<std::string> m_nonemptyDiagnostics;
+	/// Files of the last compilation, including the ones loaded on import.
+	FileRepository m_compiledFiles{"/" /* basePath */, {} /* no search paths */};
+	/// Names of the source units passed to the compiler stack for the last compilation, i.e.
+	/// excluding the ones loaded on import. Not set if the cached results are outdated.
+	std::optional<std::set<std::string>> m_compiledSourceUnits;
+	/// Whether the analysis of the source units was successful in the last compilation.
+	bool m_analysisSuccessful = false;
+	/// Whether the last compilation only covered the source units affected by a change.
+	bool m_partiallyCompiled = false;
+	/// Whether the requests are answered from an analysis of the files of the last compilation.
+	bool m_analysisPublished = false;
+	/// Source units analysed by the last call to compile(). Empty if it kept the previous results.
+	std::set<std::string> m_analyzedSourceUnits;
+	/// Source units imported directly by each source unit, as of their last analysis.
+	std::map<std::string, std::set<std::string>> m_sourceUnitImports;
+	/// Diagnostics of each source unit, as of their last analysis.
+	std::map<std::string, std::vector<Json>> m_diagnostics;
+
+	/// Messages received from the client that have not been handled yet.
+	std::deque<Json> m_inbox;
+	/// IDs of requests cancelled by the client whose cancellation has not been handled yet.
+	std::set<MessageID> m_cancelledRequests;
+	/// Whether no more messages will be received from the client.
+	bool m_inputClosed = false;
+	/// Whether a compilation is running on one of the analysis threads.
+	bool m_compilationRunning = false;
+	/// Thread holding the analysis the requests are answered from.
+	/// Not set until the first compilation finished.
+	AnalysisThread* m_publishedAnalysis = nullptr;
+	/// Current version of each document. Only changed by the thread handling the messages.
+	DocumentVersions m_documentVersions;
+	/// Versions of the documents the published analysis belongs to.
+	DocumentVersions m_publishedDocumentVersions;
+	/// Request waiting for a compilation.
+	struct DeferredRequest
+	{
+		MessageID id;
+		/// Document the request refers to. Not set if it refers to all documents.
+		std::optional<std::string> uri;
+		std::function<void()> request;
+	};
+	/// Requests waiting for the running compilation or for the one compiling the latest
+	/// version of the documents they refer to.
+	std::vector<DeferredRequest> m_deferredRequests;
+	/// Guards m_inbox, m_cancelledRequests, m_inputClosed, m_compilationRunning,
+	/// m_publishedAnalysis, m_documentVersions, m_publishedDocumentVersions and m_deferredRequests.
+	std::mutex m_inboxMutex;
+	std::condition_variable m_inboxCondition;
+
+	/// Whether a document changed since the last compilation started.
+	bool m_diagnosticsOutdated = false;
+	std::chrono::steady_clock::time_point m_lastDocumentChange;
+	/// Set when a document changes, so that the running compilation stops after its current stage.
+	std::atomic<bool> m_compilationCancelled{false};
+
+	/// Threads taking turns in compiling: One of them answers the requests from the last
+	/// successful analysis, while the other one compiles the current documents.
+	/// Only exist while the server runs.
+	std::array<std::unique_ptr<AnalysisThread>, 2> m_analysisThreads;
 };
 
 }
@@ -20,9 +20,11 @@
 #include <libsolutil/Exceptions.h>
 #include <libsolutil/JSON.h>
 
+#include <atomic>
 #include <functional>
 #include <iosfwd>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -50,6 +52,8 @@ enum class ErrorCode
 
 	// Defined by the protocol.
 	ServerNotInitialized = -32002,
+	RequestCancelled = -32800,
+	ContentModified = -32801,
 	RequestFailed = -32803
 };
 
@@ -91,6 +95,8 @@ private:
  *
  * The transport layer API is abstracted to make LSP more testable as well as
  * this way it could be possible to support other transports (HTTP for example) easily.
+ *
+ * Messages may be received on a different thread than the one sending messages.
  */
 class Transport
 {
@@ -110,7 +116,10 @@ public:
 	void setTrace(TraceValue _value) noexcept { m_logTrace = _value; }
 
 private:
-	TraceValue m_logTrace = TraceValue::Off;
+	/// Set while handling the messages, but read by the compilations as well.
+	std::atomic<TraceValue> m_logTrace{TraceValue::Off};
+	/// Serializes writing of whole messages.
+	std::mutex m_sendMutex;
 
 protected:
 	/// Reads from the transport and parses the headers until the beginning
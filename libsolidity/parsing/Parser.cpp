@@ -76,7 +76,7 @@ public:
 		solAssert(m_location.sourceName, "");
 		if (m_location.end < 0)
 			markEndPosition();
-		return std::make_shared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...);
+		return m_parser.registerNode(std::make_shared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...));
 	}
 
 	SourceLocation const& location() const noexcept { return m_location; }
@@ -183,6 +183,21 @@ ASTPointer<SourceUnit> Parser::parse(CharStream& _charStream)
 	}
 }
 
+void Parser::assignIDs(std::vector<std::weak_ptr<ASTNode>> const& _nodes, int64_t _offset)
+{
+	solAssert(_offset >= 0);
+	for (size_t i = 0; i < _nodes.size(); ++i)
+		if (ASTPointer<ASTNode> node = _nodes[i].lock())
+			node->m_id = static_cast<size_t>(_offset) + i + 1;
+}
+
+void Parser::clearAnnotations(std::vector<std::weak_ptr<ASTNode>> const& _nodes)
+{
+	for (std::weak_ptr<ASTNode> const& weakNode: _nodes)
+		if (ASTPointer<ASTNode> node = weakNode.lock())
+			node->clearAnnotation();
+}
+
 void Parser::parsePragmaVersion(SourceLocation const& _location, std::vector<Token> const& _tokens, std::vector<std::string> const& _literals)
 {
 	SemVerMatchExpressionParser parser(_tokens, _literals);
@@ -1478,7 +1493,7 @@ ASTPointer<InlineAssembly> Parser::parseInlineAssembly(ASTPointer<ASTString> con
 		BOOST_THROW_EXCEPTION(FatalError());
 
 	location.end = nativeLocationOf(ast->root()).end;
-	return std::make_shared<InlineAssembly>(nextID(), location, _docString, dialect, std::move(flags), ast);
+	return registerNode(std::make_shared<InlineAssembly>(nextID(), location, _docString, dialect, std::move(flags), ast));
 }
 
 ASTPointer<IfStatement> Parser::parseIfStatement(ASTPointer<ASTString> const& _docString)
@@ -52,6 +52,19 @@ public:
 
 	/// Returns the maximal AST node ID assigned so far
 	int64_t maxID() const { return m_currentNodeID; }
+
+	/// @returns all AST nodes created so far in the order of their creation, including the ones
+	/// that did not end up in an AST.
+	std::vector<std::weak_ptr<ASTNode>> const& nodes() const { return m_nodes; }
+
+	/// Assigns the IDs @a _offset + 1, @a _offset + 2, ... to @a _nodes, the nodes created by a
+	/// parser in the order of their creation. Source units parsed by separate parsers are numbered
+	/// as if a single parser had parsed them one after the other by using the maximal ID of the
+	/// previous one as the offset of the next one.
+	static void assignIDs(std::vector<std::weak_ptr<ASTNode>> const& _nodes, int64_t _offset);
+	/// Discards the annotations of @a _nodes, so that a source unit analyzed by an earlier
+	/// compilation can be analyzed again.
+	static void clearAnnotations(std::vector<std::weak_ptr<ASTNode>> const& _nodes);
 private:
 	class ASTNodeFactory;
 
@@ -215,6 +228,13 @@ private:
 
 	/// Returns the next AST node ID
 	int64_t nextID() { return ++m_currentNodeID; }
+	/// Records @a _node, so that its ID can be assigned again later, and returns it.
+	template <class NodeType>
+	ASTPointer<NodeType> registerNode(ASTPointer<NodeType> _node)
+	{
+		m_nodes.emplace_back(_node);
+		return _node;
+	}
 
 	std::pair<LookAheadInfo, IndexAccessedPath> tryParseIndexAccessedPath();
 	/// Performs limited look-ahead to distinguish between variable declaration and expression statement.
@@ -252,6 +272,8 @@ private:
 	std::optional<uint8_t> m_eofVersion;
 	/// Counter for the next AST node ID
 	int64_t m_currentNodeID = 0;
+	/// All AST nodes created so far, including the ones that did not end up in an AST.
+	std::vector<std::weak_ptr<ASTNode>> m_nodes;
 	/// Flag that indicates whether experimental mode is enabled in the current source unit
 	bool m_experimentalSolidityEnabledInCurrentSourceUnit = false;
 };
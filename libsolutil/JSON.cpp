@@ -138,6 +138,83 @@ std::string jsonPrint(Json const& _input, JsonFormat const& _format)
 	return dumped;
 }
 
+void JsonStreamWriter::write(std::vector<std::string> const& _path, Json const& _value)
+{
+	assertThrow(!m_finished, Exception, "JSON stream already finished.");
+	assertThrow(!_path.empty(), Exception, "Only members of the root object can be written.");
+
+	bool const pretty = m_format.format == JsonFormat::Pretty;
+	// Serialise first, so that nothing is written if this fails.
+	std::string value = jsonPrint(_value, m_format);
+	if (pretty)
+		boost::replace_all(value, "\n", "\n" + indentation(_path.size()));
+
+	if (m_lastKeys.empty())
+	{
+		m_stream << "{";
+		m_lastKeys.emplace_back();
+	}
+
+	// Close the objects that are not on the path.
+	size_t commonDepth = 0;
+	while (
+		commonDepth + 1 < m_lastKeys.size() &&
+		commonDepth + 1 < _path.size() &&
+		m_lastKeys[commonDepth] == _path[commonDepth]
+	)
+		++commonDepth;
+	while (m_lastKeys.size() > commonDepth + 1)
+		closeObject();
+
+	for (size_t depth = commonDepth; depth < _path.size(); ++depth)
+	{
+		writeKey(_path[depth]);
+		if (depth + 1 < _path.size())
+		{
+			m_stream << "{";
+			m_lastKeys.emplace_back();
+		}
+	}
+	m_stream << value;
+}
+
+void JsonStreamWriter::finish()
+{
+	assertThrow(!m_finished, Exception, "JSON stream already finished.");
+	if (m_lastKeys.empty())
+		m_stream << "{}";
+	while (!m_lastKeys.empty())
+		closeObject();
+	m_finished = true;
+}
+
+void JsonStreamWriter::writeKey(std::string const& _key)
+{
+	std::optional<std::string>& lastKey = m_lastKeys.back();
+	assertThrow(!lastKey || *lastKey < _key, Exception, "JSON members not written in order.");
+
+	if (lastKey)
+		m_stream << ",";
+	if (m_format.format == JsonFormat::Pretty)
+		m_stream << "\n" << indentation(m_lastKeys.size()) << jsonPrint(_key, m_format) << ": ";
+	else
+		m_stream << jsonPrint(_key, m_format) << ":";
+	lastKey = _key;
+}
+
+void JsonStreamWriter::closeObject()
+{
+	m_lastKeys.pop_back();
+	if (m_format.format == JsonFormat::Pretty)
+		m_stream << "\n" << indentation(m_lastKeys.size());
+	m_stream << "}";
+}
+
+std::string JsonStreamWriter::indentation(size_t _depth) const
+{
+	return std::string(_depth * m_format.indent, ' ');
+}
+
 bool jsonParseStrict(std::string const& _input, Json& _json, std::string* _errs /* = nullptr */)
 {
 	try
@@ -30,6 +30,8 @@
 #include <string_view>
 #include <optional>
 #include <limits>
+#include <ostream>
+#include <vector>
 
 namespace solidity
 {
@@ -71,6 +73,35 @@ std::string jsonCompactPrint(Json const& _input);
 /// Serialise the JSON object (@a _input) using specified format (@a _format)
 std::string jsonPrint(Json const& _input, JsonFormat const& _format);
 
+/// Serialises a JSON object member by member, so that the whole object never has to be kept in memory.
+/// Each member is given by its path of keys from the root. The objects along that path are opened and
+/// closed as needed. Members have to be given in the order in which they appear in the serialised
+/// object, i.e. sorted by key on every level. The result is then the same as that of jsonPrint().
+class JsonStreamWriter
+{
+public:
+	JsonStreamWriter(std::ostream& _stream, JsonFormat const& _format): m_stream(_stream), m_format(_format) {}
+
+	/// Writes @a _value as the member at @a _path, which must not be empty.
+	/// Nothing is written if serialising @a _value fails.
+	void write(std::vector<std::string> const& _path, Json const& _value);
+	/// Closes all open objects. No members can be written afterwards.
+	void finish();
+
+private:
+	/// Writes the separator and indentation for a new member of the innermost open object and its key.
+	void writeKey(std::string const& _key);
+	void closeObject();
+	std::string indentation(size_t _depth) const;
+
+	std::ostream& m_stream;
+	JsonFormat m_format;
+	/// The last key written on each level of the currently open objects, starting with the root.
+	/// All but the last one are the keys of the open objects.
+	std::vector<std::optional<std::string>> m_lastKeys;
+	bool m_finished = false;
+};
+
 /// Parse a JSON string (@a _input) with enabled strict-mode and writes resulting JSON object to (@a _json)
 /// \param _input JSON input string
 /// \param _json [out] resulting JSON object
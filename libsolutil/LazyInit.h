@@ -79,6 +79,12 @@ public:
 		return m_value.value();
 	}
 
+	/// Discards the stored value, so that the next call to "init" computes it again.
+	void reset()
+	{
+		m_value.reset();
+	}
+
 private:
 	/// Although not quite logically const, this is marked const for pragmatic reasons. It doesn't change the platonic
 	/// value of the object (which is something that is initialized to some computed value on first use).
@@ -24,40 +24,172 @@
 #include <iostream>
 #include <vector>
 
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+#include <sys/resource.h>
+#endif
+
 using namespace std::chrono;
 using namespace solidity;
 
-#ifdef PROFILE_OPTIMIZER_STEPS
+namespace
+{
+
+thread_local util::Profiler* g_activeProfiler = nullptr;
+thread_local std::string g_activeContract;
+
+/// @returns the resident set size high-water mark of the process in bytes or zero if it cannot be determined.
+size_t rssHighWaterMark()
+{
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+	rusage usage{};
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+#if defined(__APPLE__)
+	return static_cast<size_t>(usage.ru_maxrss);
+#else
+	// Given in kilobytes on Linux and BSDs.
+	return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+	return 0;
+#endif
+}
 
-util::Profiler::Probe::Probe(std::string _scopeName):
-	m_scopeName(std::move(_scopeName)),
-	m_startTime(steady_clock::now())
+Json metricsToJson(std::map<std::string, util::Profiler::Metrics> const& _metrics)
 {
+	Json result = Json::object();
+	for (auto&& [scopeName, scopeMetrics]: _metrics)
+	{
+		result[scopeName]["calls"] = scopeMetrics.callCount;
+		result[scopeName]["microseconds"] = scopeMetrics.durationInMicroseconds.count();
+		result[scopeName]["rssHighWaterGrowth"] = scopeMetrics.rssHighWaterGrowth;
+	}
+	return result;
+}
+
+}
+
+util::Profiler::Probe::Probe(std::string_view _scopeName):
+	m_profiler(g_activeProfiler)
+{
+#ifdef PROFILE_OPTIMIZER_STEPS
+	m_recording = true;
+#else
+	m_recording = m_profiler != nullptr;
+#endif
+	if (!m_recording)
+		return;
+
+	m_contract = g_activeContract;
+	m_scopeName = _scopeName;
+	m_startRSSHighWater = rssHighWaterMark();
+	m_startTime = steady_clock::now();
 }
 
 util::Profiler::Probe::~Probe()
 {
+	if (!m_recording)
+		return;
+
 	steady_clock::time_point endTime = steady_clock::now();
+	size_t endRSSHighWater = rssHighWaterMark();
+
+	Metrics metrics;
+	metrics.durationInMicroseconds = duration_cast<microseconds>(endTime - m_startTime);
+	metrics.callCount = 1;
+	metrics.rssHighWaterGrowth = std::max(endRSSHighWater, m_startRSSHighWater) - m_startRSSHighWater;
+
+	if (m_profiler)
+		m_profiler->record(m_contract, m_scopeName, metrics);
+#ifdef PROFILE_OPTIMIZER_STEPS
+	Profiler::singleton().record(m_contract, m_scopeName, metrics);
+#endif
+}
+
+util::Profiler::Activation::Activation(Profiler* _profiler, std::string _contract):
+	m_previousProfiler(g_activeProfiler),
+	m_previousContract(std::move(g_activeContract))
+{
+	g_activeProfiler = _profiler;
+	g_activeContract = std::move(_contract);
+}
+
+util::Profiler::Activation::~Activation()
+{
+	g_activeProfiler = m_previousProfiler;
+	g_activeContract = std::move(m_previousContract);
+}
+
+util::Profiler* util::Profiler::active()
+{
+	return g_activeProfiler;
+}
 
-	auto [metricsIt, inserted] = Profiler::singleton().m_metrics.try_emplace(m_scopeName, Metrics{0us, 0});
-	metricsIt->second.durationInMicroseconds += duration_cast<microseconds>(endTime - m_startTime);
-	++metricsIt->second.callCount;
+std::string const& util::Profiler::activeContract()
+{
+	return g_activeContract;
 }
 
-util::Profiler::~Profiler()
+std::map<std::string, std::map<std::string, util::Profiler::Metrics>> util::Profiler::metrics() const
 {
-	outputPerformanceMetrics();
+	std::lock_guard lock(m_mutex);
+	return m_metrics;
+}
+
+Json util::Profiler::toJson() const
+{
+	Json result;
+	result["contracts"] = Json::object();
+	result["general"] = Json::object();
+	for (auto&& [contract, contractMetrics]: metrics())
+		if (contract.empty())
+			result["general"] = metricsToJson(contractMetrics);
+		else
+			result["contracts"][contract] = metricsToJson(contractMetrics);
+	return result;
+}
+
+void util::Profiler::record(std::string const& _contract, std::string const& _scopeName, Metrics const& _metrics)
+{
+	std::lock_guard lock(m_mutex);
+	Metrics& metrics = m_metrics[_contract][_scopeName];
+	metrics.durationInMicroseconds += _metrics.durationInMicroseconds;
+	metrics.callCount += _metrics.callCount;
+	metrics.rssHighWaterGrowth += _metrics.rssHighWaterGrowth;
+}
+
+#ifdef PROFILE_OPTIMIZER_STEPS
+
+namespace
+{
+
+/// Prints the metrics gathered by the profiler singleton on exit.
+struct ProfilerSingleton
+{
+	~ProfilerSingleton() { profiler.outputPerformanceMetrics(); }
+
+	util::Profiler profiler;
+};
+
 }
 
 util::Profiler& util::Profiler::singleton()
 {
-	static Profiler profiler;
-	return profiler;
+	static ProfilerSingleton singleton;
+	return singleton.profiler;
 }
 
-void util::Profiler::outputPerformanceMetrics()
+void util::Profiler::outputPerformanceMetrics() const
 {
-	std::vector<std::pair<std::string, Metrics>> sortedMetrics(m_metrics.begin(), m_metrics.end());
+	std::map<std::string, Metrics> metricsPerScope;
+	for (auto&& [contract, contractMetrics]: metrics())
+		for (auto&& [scopeName, scopeMetrics]: contractMetrics)
+		{
+			metricsPerScope[scopeName].durationInMicroseconds += scopeMetrics.durationInMicroseconds;
+			metricsPerScope[scopeName].callCount += scopeMetrics.callCount;
+		}
+
+	std::vector<std::pair<std::string, Metrics>> sortedMetrics(metricsPerScope.begin(), metricsPerScope.end());
 	std::sort(
 		sortedMetrics.begin(),
 		sortedMetrics.end(),
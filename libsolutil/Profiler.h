@@ -18,64 +18,105 @@
 
 #pragma once
 
+#include <libsolutil/JSON.h>
+
 #include <chrono>
 #include <map>
-#include <optional>
+#include <mutex>
 #include <string>
+#include <string_view>
 
-#ifdef PROFILE_OPTIMIZER_STEPS
 #define PROFILER_PROBE(_scopeName, _variable) solidity::util::Profiler::Probe _variable(_scopeName);
-#else
-#define PROFILER_PROBE(_scopeName, _variable) void(0);
-#endif
 
 namespace solidity::util
 {
 
-#ifdef PROFILE_OPTIMIZER_STEPS
-
-/// Simpler profiler class that gathers metrics during program execution and prints them out on exit.
-///
-/// To gather metrics, create a Probe instance and let it live until the end of the scope.
-/// The probe will register its creation and destruction time and store the results in the profiler
-/// singleton.
+/// Simple profiler class that gathers the wall time, the number of calls and the growth of the
+/// resident set size high-water mark of the process during named scopes of program execution.
 ///
-/// Use the PROFILER_PROBE macro to create probes conditionally, in a way that will not affect performance
-/// unless profiling is enabled at compilation time via PROFILE_OPTIMIZER_STEPS CMake option.
+/// To gather metrics, create a Probe instance (e.g. via the PROFILER_PROBE macro) and let it live
+/// until the end of the scope. The probe records its results in the profiler that is active on the
+/// current thread (see Activation) and attributes them to the contract the profiler was activated for.
+/// Probes do nothing if no profiler is active, unless profiling is enabled at compilation time via
+/// the PROFILE_OPTIMIZER_STEPS CMake option. In that case all probes also record their results in
+/// the profiler singleton, which prints them out on exit.
 ///
 /// Scopes are identified by the name supplied to the probe. Using the same name multiple times
 /// will result in metrics for those scopes being aggregated together as if they were the same scope.
 class Profiler
 {
 public:
+	struct Metrics
+	{
+		std::chrono::microseconds durationInMicroseconds{0};
+		size_t callCount = 0;
+		/// Sum of the growth of the resident set size high-water mark (the peak resident memory)
+		/// of the process during the calls, in bytes. This is not the memory allocated by the scope:
+		/// it is zero for scopes that stay below the peak reached earlier, and it includes the memory
+		/// used by other threads meanwhile. Always zero on platforms where it cannot be measured.
+		size_t rssHighWaterGrowth = 0;
+	};
+
 	class Probe
 	{
 	public:
-		Probe(std::string _scopeName);
+		explicit Probe(std::string_view _scopeName);
 		~Probe();
 
+		Probe(Probe const&) = delete;
+		Probe& operator=(Probe const&) = delete;
+
 	private:
+		bool m_recording = false;
+		Profiler* m_profiler = nullptr;
+		std::string m_contract;
 		std::string m_scopeName;
 		std::chrono::steady_clock::time_point m_startTime;
+		size_t m_startRSSHighWater = 0;
 	};
 
-	static Profiler& singleton();
+	/// Makes @a _profiler the profiler that probes on the current thread record to, until destroyed.
+	/// @a _profiler can be null, in which case probes do not record anything.
+	/// @a _contract is the name of the contract to attribute the metrics to, if any.
+	class Activation
+	{
+	public:
+		explicit Activation(Profiler* _profiler, std::string _contract = {});
+		~Activation();
 
-private:
-	~Profiler();
+		Activation(Activation const&) = delete;
+		Activation& operator=(Activation const&) = delete;
 
-	struct Metrics
-	{
-		std::chrono::microseconds durationInMicroseconds;
-		size_t callCount;
+	private:
+		Profiler* m_previousProfiler;
+		std::string m_previousContract;
 	};
 
-	/// Summarizes gathered metric and prints a report to standard error output.
-	void outputPerformanceMetrics();
+	/// @returns the profiler that is active on the current thread, if any.
+	static Profiler* active();
+	/// @returns the name of the contract the active profiler of the current thread was activated for.
+	static std::string const& activeContract();
 
-	std::map<std::string, Metrics> m_metrics;
-};
+	/// @returns the metrics of each scope, for each contract. Metrics not attributed to any contract
+	/// are stored under the empty contract name.
+	std::map<std::string, std::map<std::string, Metrics>> metrics() const;
+
+	/// @returns the metrics as JSON, with the metrics not attributed to any contract under "general"
+	/// and the others under "contracts".
+	Json toJson() const;
+
+#ifdef PROFILE_OPTIMIZER_STEPS
+	static Profiler& singleton();
 
+	/// Summarizes gathered metric and prints a report to standard error output.
+	void outputPerformanceMetrics() const;
 #endif
 
+private:
+	void record(std::string const& _contract, std::string const& _scopeName, Metrics const& _metrics);
+
+	mutable std::mutex m_mutex;
+	std::map<std::string, std::map<std::string, Metrics>> m_metrics;
+};
+
 }
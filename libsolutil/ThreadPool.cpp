@@ -0,0 +1,149 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/ThreadPool.h>
+
+#include <libsolutil/Profiler.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <algorithm>
+#include <atomic>
+
+using namespace solidity;
+using namespace solidity::util;
+
+ThreadPool::ThreadPool(size_t _threadCount)
+{
+	m_workers.reserve(_threadCount);
+	for (size_t i = 0; i < _threadCount; ++i)
+		m_workers.emplace_back([this]() { work(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_shuttingDown = true;
+	}
+	m_taskAvailable.notify_all();
+	for (std::thread& worker: m_workers)
+		worker.join();
+}
+
+size_t ThreadPool::threadCountForJobs(size_t _jobs)
+{
+	if (_jobs == 0)
+		_jobs = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+	return _jobs == 1 ? 0 : _jobs;
+}
+
+void ThreadPool::runAll(std::vector<std::function<void()>> _tasks)
+{
+	if (m_workers.empty() || _tasks.size() < 2)
+	{
+		for (auto const& task: _tasks)
+			task();
+		return;
+	}
+
+	// A task is run by whichever thread claims it first. The workers only touch the task if they
+	// claim it and the calling thread waits for all claimed tasks, so the data referenced by the
+	// task stays valid. Tasks that are still queued once everything is done are skipped.
+	struct SharedTask
+	{
+		std::function<void()> function;
+		std::atomic<bool> claimed = false;
+		std::promise<void> done;
+	};
+	auto runTask = [](SharedTask& _task) {
+		if (_task.claimed.exchange(true))
+			return;
+		try
+		{
+			_task.function();
+			_task.done.set_value();
+		}
+		catch (...)
+		{
+			_task.done.set_exception(std::current_exception());
+		}
+	};
+
+	std::vector<std::shared_ptr<SharedTask>> tasks;
+	std::vector<std::future<void>> results;
+	Profiler* profiler = Profiler::active();
+	std::string const& contract = Profiler::activeContract();
+	for (auto& function: _tasks)
+	{
+		auto& task = tasks.emplace_back(std::make_shared<SharedTask>());
+		task->function = [profiler, contract, function = std::move(function)]() {
+			Profiler::Activation profilerActivation(profiler, contract);
+			function();
+		};
+		results.emplace_back(task->done.get_future());
+	}
+
+	// The calling thread starts with the first task, so it is not offered to the workers.
+	for (size_t i = 1; i < tasks.size(); ++i)
+		enqueue([task = tasks[i], runTask]() { runTask(*task); });
+	for (auto const& task: tasks)
+		runTask(*task);
+
+	std::exception_ptr firstException;
+	for (auto& result: results)
+		try
+		{
+			result.get();
+		}
+		catch (...)
+		{
+			if (!firstException)
+				firstException = std::current_exception();
+		}
+	if (firstException)
+		std::rethrow_exception(firstException);
+}
+
+void ThreadPool::enqueue(std::function<void()> _task)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		solAssert(!m_shuttingDown, "Task submitted to a thread pool that is shutting down.");
+		m_tasks.push(std::move(_task));
+	}
+	m_taskAvailable.notify_one();
+}
+
+void ThreadPool::work()
+{
+	while (true)
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_taskAvailable.wait(lock, [this]() { return m_shuttingDown || !m_tasks.empty(); });
+			// Remaining tasks are still executed during shutdown so that no future is left unfulfilled.
+			if (m_tasks.empty())
+				return;
+			task = std::move(m_tasks.front());
+			m_tasks.pop();
+		}
+		task();
+	}
+}
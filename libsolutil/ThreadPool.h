@@ -0,0 +1,96 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Simple fixed-size pool of worker threads.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Pool of worker threads executing submitted tasks in submission order.
+ *
+ * Tasks are started in the order in which they were submitted, which means that a task may
+ * safely wait for the result of any task submitted before it without risking a deadlock.
+ * A pool created with zero threads executes every task immediately in the submitting thread.
+ * The destructor waits until all submitted tasks have finished.
+ */
+class ThreadPool
+{
+public:
+	explicit ThreadPool(size_t _threadCount);
+	~ThreadPool();
+
+	ThreadPool(ThreadPool const&) = delete;
+	ThreadPool& operator=(ThreadPool const&) = delete;
+
+	/// Schedules @a _task for execution.
+	/// @returns a future that holds the result or the exception thrown by the task.
+	template<typename Task>
+	std::future<std::invoke_result_t<Task>> submit(Task&& _task)
+	{
+		using Result = std::invoke_result_t<Task>;
+		auto packagedTask = std::make_shared<std::packaged_task<Result()>>(std::forward<Task>(_task));
+		std::future<Result> result = packagedTask->get_future();
+		if (m_workers.empty())
+			(*packagedTask)();
+		else
+			enqueue([packagedTask]() { (*packagedTask)(); });
+		return result;
+	}
+
+	/// @returns the number of worker threads.
+	size_t size() const { return m_workers.size(); }
+
+	/// Runs all @a _tasks concurrently, using the worker threads as well as the calling thread, and
+	/// returns once all of them have finished. Rethrows the exception of the first task that failed.
+	/// In contrast to waiting for submitted tasks, this is safe to call from a task running in the
+	/// same pool: the calling thread executes every task that no worker has started yet and only
+	/// waits for the ones that are already running.
+	/// The tasks run with the profiler activation of the calling thread.
+	void runAll(std::vector<std::function<void()>> _tasks);
+
+	/// @returns the number of threads to use for a user-supplied degree of parallelism @a _jobs,
+	/// where zero stands for the number of hardware threads available. Since the calling thread is
+	/// expected to wait for the results, a single job translates into a pool without threads.
+	static size_t threadCountForJobs(size_t _jobs);
+
+private:
+	void enqueue(std::function<void()> _task);
+	void work();
+
+	std::vector<std::thread> m_workers;
+	std::queue<std::function<void()>> m_tasks;
+	std::mutex m_mutex;
+	std::condition_variable m_taskAvailable;
+	bool m_shuttingDown = false;
+};
+
+}
@@ -26,14 +26,311 @@
 
 #include <libsolutil/Assertions.h>
 
-#include <regex>
+#include <algorithm>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string_view>
+#include <unordered_map>
 
 using namespace solidity::util;
 
+namespace
+{
+
+/// Sequence of template elements covering the characters [begin, end) of the template text.
+struct Segment;
+
+struct Element
+{
+	enum class Kind { Text, Parameter, List, Condition };
+
+	Kind kind;
+	/// Position of the literal text in the template for Kind::Text.
+	size_t begin = 0;
+	size_t end = 0;
+	/// Name of the parameter, list or condition. Names of conditional value parameters start with "+".
+	std::string name;
+	/// Body of a list or the part of a condition used if it is true.
+	std::vector<Segment> body;
+	/// Part of a condition used if it is false.
+	std::vector<Segment> elseBody;
+};
+
+struct Segment
+{
+	size_t begin = 0;
+	size_t end = 0;
+	std::vector<Element> elements;
+};
+
+bool isParameterCharacter(char _c)
+{
+	return
+		('a' <= _c && _c <= 'z') ||
+		('A' <= _c && _c <= 'Z') ||
+		('0' <= _c && _c <= '9') ||
+		_c == '_' || _c == '$' || _c == '-';
+}
+
+/// @returns the end of the longest run of parameter characters starting at @a _pos, but not after @a _end.
+size_t parameterEnd(std::string const& _text, size_t _pos, size_t _end)
+{
+	while (_pos < _end && isParameterCharacter(_text[_pos]))
+		++_pos;
+	return _pos;
+}
+
+/// @returns the position of the first occurrence of @a _tag in [_begin, _end) or std::string::npos.
+size_t findTag(std::string const& _text, std::string const& _tag, size_t _begin, size_t _end)
+{
+	size_t pos = _text.find(_tag, _begin);
+	return (pos != std::string::npos && pos + _tag.size() <= _end) ? pos : std::string::npos;
+}
+
+/// Throws if the template contains a tag starting with one of "<#", "<?", "<!", "</" that is not
+/// immediately closed by ">" after its name.
+void checkTemplateValid(std::string const& _text)
+{
+	for (size_t pos = _text.find('<'); pos != std::string::npos; pos = _text.find('<', pos + 1))
+	{
+		size_t nameBegin = pos + 1;
+		if (nameBegin >= _text.size() || std::string_view("#?!/").find(_text[nameBegin]) == std::string_view::npos)
+			continue;
+		++nameBegin;
+		if (nameBegin < _text.size() && _text[nameBegin] == '+')
+			++nameBegin;
+		size_t nameEnd = parameterEnd(_text, nameBegin, _text.size());
+		assertThrow(
+			nameEnd == nameBegin || (nameEnd < _text.size() && _text[nameEnd] == '>'),
+			WhiskersError,
+			"Template contains an invalid/unclosed tag " + _text.substr(pos, nameEnd + 1 - pos)
+		);
+	}
+}
+
+Segment parseSegment(std::string const& _text, size_t _begin, size_t _end);
+
+/// Tries to parse a parameter, list or condition starting with the "<" at @a _pos.
+/// Text that does not form a complete element is not an error, it is just copied when rendering.
+/// @returns the element and the position after it.
+std::optional<std::pair<Element, size_t>> parseElement(std::string const& _text, size_t _pos, size_t _end)
+{
+	size_t nameBegin = _pos + 1;
+	if (nameBegin >= _end)
+		return std::nullopt;
+
+	char kind = _text[nameBegin];
+	if (isParameterCharacter(kind))
+	{
+		size_t nameEnd = parameterEnd(_text, nameBegin, _end);
+		if (nameEnd < _end && _text[nameEnd] == '>')
+			return {{Element{Element::Kind::Parameter, 0, 0, _text.substr(nameBegin, nameEnd - nameBegin), {}, {}}, nameEnd + 1}};
+		return std::nullopt;
+	}
+	else if (kind != '#' && kind != '?')
+		return std::nullopt;
+
+	++nameBegin;
+	// Names of conditional value parameters start with "+".
+	size_t parameterBegin = (kind == '?' && nameBegin < _end && _text[nameBegin] == '+') ? nameBegin + 1 : nameBegin;
+	size_t nameEnd = parameterEnd(_text, parameterBegin, _end);
+	if (nameEnd == parameterBegin || nameEnd >= _end || _text[nameEnd] != '>')
+		return std::nullopt;
+
+	std::string name = _text.substr(nameBegin, nameEnd - nameBegin);
+	size_t bodyBegin = nameEnd + 1;
+	std::string closingTag = "</" + name + ">";
+	size_t closingPos = findTag(_text, closingTag, bodyBegin, _end);
+
+	if (kind == '#')
+	{
+		if (closingPos == std::string::npos)
+			return std::nullopt;
+		return {{
+			Element{Element::Kind::List, 0, 0, std::move(name), {parseSegment(_text, bodyBegin, closingPos)}, {}},
+			closingPos + closingTag.size()
+		}};
+	}
+
+	// The condition ends at the first closing tag, unless an else tag comes first.
+	std::string elseTag = "<!" + name + ">";
+	size_t elsePos = findTag(_text, elseTag, bodyBegin, closingPos == std::string::npos ? _end : closingPos);
+	if (elsePos != std::string::npos)
+	{
+		size_t elseBegin = elsePos + elseTag.size();
+		closingPos = findTag(_text, closingTag, elseBegin, _end);
+		if (closingPos == std::string::npos)
+			return std::nullopt;
+		return {{
+			Element{
+				Element::Kind::Condition,
+				0,
+				0,
+				std::move(name),
+				{parseSegment(_text, bodyBegin, elsePos)},
+				{parseSegment(_text, elseBegin, closingPos)}
+			},
+			closingPos + closingTag.size()
+		}};
+	}
+	if (closingPos == std::string::npos)
+		return std::nullopt;
+	return {{
+		Element{Element::Kind::Condition, 0, 0, std::move(name), {parseSegment(_text, bodyBegin, closingPos)}, {Segment{closingPos, closingPos, {}}}},
+		closingPos + closingTag.size()
+	}};
+}
+
+Segment parseSegment(std::string const& _text, size_t _begin, size_t _end)
+{
+	Segment segment{_begin, _end, {}};
+	size_t textBegin = _begin;
+	size_t pos = _text.find('<', _begin);
+	while (pos < _end)
+	{
+		if (auto element = parseElement(_text, pos, _end))
+		{
+			if (textBegin < pos)
+				segment.elements.push_back(Element{Element::Kind::Text, textBegin, pos, {}, {}, {}});
+			segment.elements.push_back(std::move(element->first));
+			textBegin = element->second;
+			pos = _text.find('<', textBegin);
+		}
+		else
+			pos = _text.find('<', pos + 1);
+	}
+	if (textBegin < _end)
+		segment.elements.push_back(Element{Element::Kind::Text, textBegin, _end, {}, {}, {}});
+	return segment;
+}
+
+/// Collects the names of all tags "<name>", "<#name>", "<?name>" and "</name>" (including the prefix).
+std::set<std::string, std::less<>> collectTags(std::string const& _text)
+{
+	std::set<std::string, std::less<>> tags;
+	for (size_t pos = _text.find('<'); pos != std::string::npos; pos = _text.find('<', pos + 1))
+	{
+		size_t nameBegin = pos + 1;
+		if (nameBegin < _text.size() && std::string_view("#?/").find(_text[nameBegin]) != std::string_view::npos)
+			++nameBegin;
+		size_t nameEnd = parameterEnd(_text, nameBegin, _text.size());
+		if (nameEnd != nameBegin && nameEnd < _text.size() && _text[nameEnd] == '>')
+			tags.insert(_text.substr(pos + 1, nameEnd - pos - 1));
+	}
+	return tags;
+}
+
+struct RenderContext
+{
+	std::string const& text;
+	Whiskers::StringMap const& parameters;
+	/// Parameters of the current list element, if inside a list.
+	Whiskers::StringMap const* listElement;
+	std::map<std::string, bool> const& conditions;
+	/// List parameters, not available inside a list.
+	Whiskers::StringListMap const* listParameters;
+};
+
+void renderSegment(Segment const& _segment, RenderContext const& _context, std::string& _output)
+{
+	for (Element const& element: _segment.elements)
+		switch (element.kind)
+		{
+		case Element::Kind::Text:
+			_output.append(_context.text, element.begin, element.end - element.begin);
+			break;
+		case Element::Kind::Parameter:
+		{
+			if (_context.listElement)
+				if (auto value = _context.listElement->find(element.name); value != _context.listElement->end())
+				{
+					_output += value->second;
+					break;
+				}
+			auto value = _context.parameters.find(element.name);
+			assertThrow(
+				value != _context.parameters.end(),
+				WhiskersError,
+				"Value for tag " + element.name + " not provided.\n" +
+				"Template:\n" +
+				_context.text.substr(_segment.begin, _segment.end - _segment.begin)
+			);
+			_output += value->second;
+			break;
+		}
+		case Element::Kind::List:
+		{
+			assertThrow(
+				_context.listParameters && _context.listParameters->count(element.name),
+				WhiskersError, "List parameter " + element.name + " not set."
+			);
+			for (Whiskers::StringMap const& listElement: _context.listParameters->at(element.name))
+			{
+				for (auto const& parameter: listElement)
+					assertThrow(
+						!_context.parameters.count(parameter.first),
+						WhiskersError,
+						"Parameter collision"
+					);
+				renderSegment(
+					element.body.front(),
+					RenderContext{_context.text, _context.parameters, &listElement, _context.conditions, nullptr},
+					_output
+				);
+			}
+			break;
+		}
+		case Element::Kind::Condition:
+		{
+			bool conditionValue = false;
+			if (element.name[0] == '+')
+			{
+				std::string tag = element.name.substr(1);
+				auto listElementValue = _context.listElement ? _context.listElement->find(tag) : Whiskers::StringMap::const_iterator{};
+				if (_context.listElement && listElementValue != _context.listElement->end())
+					conditionValue = !listElementValue->second.empty();
+				else if (_context.parameters.count(tag))
+					conditionValue = !_context.parameters.at(tag).empty();
+				else if (_context.listParameters && _context.listParameters->count(tag))
+					conditionValue = !_context.listParameters->at(tag).empty();
+				else
+					assertThrow(false, WhiskersError, "Tag " + tag + " used as condition but was not set.");
+			}
+			else
+			{
+				assertThrow(
+					_context.conditions.count(element.name),
+					WhiskersError, "Condition parameter " + element.name + " not set."
+				);
+				conditionValue = _context.conditions.at(element.name);
+			}
+			renderSegment(conditionValue ? element.body.front() : element.elseBody.front(), _context, _output);
+			break;
+		}
+		}
+}
+
+}
+
+struct Whiskers::Template
+{
+	explicit Template(std::string _text):
+		text(std::move(_text))
+	{
+		checkTemplateValid(text);
+		root = parseSegment(text, 0, text.size());
+		tags = collectTags(text);
+	}
+
+	std::string text;
+	Segment root;
+	std::set<std::string, std::less<>> tags;
+};
+
 Whiskers::Whiskers(std::string _template):
-	m_template(std::move(_template))
+	m_template(parsedTemplate(std::move(_template)))
 {
-	checkTemplateValid();
 }
 
 Whiskers& Whiskers::operator()(std::string _parameter, std::string _value)
@@ -71,25 +368,20 @@ Whiskers& Whiskers::operator()(
 
 std::string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_conditions, m_listParameters);
-}
-
-void Whiskers::checkTemplateValid() const
-{
-	std::regex validTemplate("<[#?!\\/]\\+{0,1}[a-zA-Z0-9_$-]+(?:[^a-zA-Z0-9_$>-]|$)");
-	std::smatch match;
-	assertThrow(
-		!regex_search(m_template, match, validTemplate),
-		WhiskersError,
-		"Template contains an invalid/unclosed tag " + match.str()
+	std::string result;
+	result.reserve(m_template->text.size());
+	renderSegment(
+		m_template->root,
+		RenderContext{m_template->text, m_parameters, nullptr, m_conditions, &m_listParameters},
+		result
 	);
+	return result;
 }
 
 void Whiskers::checkParameterValid(std::string const& _parameter) const
 {
-	static std::regex validParam("^" + paramRegex() + "$");
 	assertThrow(
-		regex_match(_parameter, validParam),
+		!_parameter.empty() && std::all_of(_parameter.begin(), _parameter.end(), isParameterCharacter),
 		WhiskersError,
 		"Parameter" + _parameter + " contains invalid characters."
 	);
@@ -117,127 +409,31 @@ void Whiskers::checkParameterUnknown(std::string const& _parameter) const
 void Whiskers::checkTemplateContainsTags(std::string const& _parameter, std::vector<std::string> const& _prefixes) const
 {
 	for (auto const& prefix: _prefixes)
-	{
-		std::string tag{"<" + prefix + _parameter + ">"};
 		assertThrow(
-			m_template.find(tag) != std::string::npos,
+			m_template->tags.count(prefix + _parameter),
 			WhiskersError,
-			"Tag '" + tag + "' not found in template:\n" + m_template
+			"Tag '<" + prefix + _parameter + ">' not found in template:\n" + m_template->text
 		);
-	}
 }
 
-namespace
-{
-template<class ReplaceCallback>
-std::string regex_replace(
-	std::string const& _source,
-	std::regex const& _pattern,
-	ReplaceCallback _replace,
-	std::regex_constants::match_flag_type _flags = std::regex_constants::match_default
-)
+std::shared_ptr<Whiskers::Template const> Whiskers::parsedTemplate(std::string _template)
 {
-	std::sregex_iterator curMatch(_source.begin(), _source.end(), _pattern, _flags);
-	std::sregex_iterator matchEnd;
-	std::string::const_iterator lastMatchedPos(_source.cbegin());
-	std::string result;
-	while (curMatch != matchEnd)
-	{
-		result.append(curMatch->prefix().first, curMatch->prefix().second);
-		result.append(_replace(*curMatch));
-		lastMatchedPos = (*curMatch)[0].second;
-		++curMatch;
-	}
-	result.append(lastMatchedPos, _source.cend());
-	return result;
-}
-}
+	// Most templates are string literals in the code generators, so the number of distinct
+	// templates is small. The limit only guards against unbounded growth.
+	static size_t constexpr maxCachedTemplates = 8192;
+	static std::mutex mutex;
+	// The keys refer to the text of the cached templates.
+	static std::unordered_map<std::string_view, std::shared_ptr<Template const>> cache;
 
-std::string Whiskers::replace(
-	std::string const& _template,
-	StringMap const& _parameters,
-	std::map<std::string, bool> const& _conditions,
-	std::map<std::string, std::vector<StringMap>> const& _listParameters
-)
-{
-	static std::regex listOrTag(
-		"<(" + paramRegex() + ")>|"
-		"<#(" + paramRegex() + ")>((?:.|\\r|\\n)*?)</\\2>|"
-		"<\\?(\\+?" + paramRegex() + ")>((?:.|\\r|\\n)*?)(<!\\4>((?:.|\\r|\\n)*?))?</\\4>"
-	);
-	return regex_replace(_template, listOrTag, [&](std::match_results<std::string::const_iterator> _match) -> std::string
 	{
-		std::string tagName(_match[1]);
-		std::string listName(_match[2]);
-		std::string conditionName(_match[4]);
-		if (!tagName.empty())
-		{
-			assertThrow(
-				_parameters.count(tagName),
-				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
-				"Template:\n" +
-				_template
-			);
-			return _parameters.at(tagName);
-		}
-		else if (!listName.empty())
-		{
-			std::string templ(_match[3]);
-			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
-			);
-			std::string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
-		}
-		else
-		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
-			bool conditionValue = false;
-			if (conditionName[0] == '+')
-			{
-				std::string tag = conditionName.substr(1);
-
-				if (_parameters.count(tag))
-					conditionValue = !_parameters.at(tag).empty();
-				else if (_listParameters.count(tag))
-					conditionValue = !_listParameters.at(tag).empty();
-				else
-					assertThrow(false, WhiskersError, "Tag " + tag + " used as condition but was not set.");
-			}
-			else
-			{
-				assertThrow(
-					_conditions.count(conditionName),
-					WhiskersError, "Condition parameter " + conditionName + " not set."
-				);
-				conditionValue = _conditions.at(conditionName);
-			}
-			return replace(
-				conditionValue ? _match[5] : _match[7],
-				_parameters,
-				_conditions,
-				_listParameters
-			);
-		}
-	});
-}
+		std::lock_guard<std::mutex> lock(mutex);
+		if (auto cached = cache.find(_template); cached != cache.end())
+			return cached->second;
+	}
 
-Whiskers::StringMap Whiskers::joinMaps(
-	Whiskers::StringMap const& _a,
-	Whiskers::StringMap const& _b
-)
-{
-	Whiskers::StringMap ret = _a;
-	for (auto const& x: _b)
-		assertThrow(
-			ret.insert(x).second,
-			WhiskersError,
-			"Parameter collision"
-		);
-	return ret;
+	auto parsed = std::make_shared<Template const>(std::move(_template));
+	std::lock_guard<std::mutex> lock(mutex);
+	if (cache.size() >= maxCachedTemplates)
+		cache.clear();
+	return cache.emplace(parsed->text, parsed).first->second;
 }
-
@@ -26,8 +26,9 @@
 
 #include <libsolutil/Exceptions.h>
 
-#include <string>
 #include <map>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace solidity::util
@@ -67,6 +68,9 @@ DEV_SIMPLE_EXCEPTION(WhiskersError);
  *    Works similar to a conditional parameter where the checked condition is
  *    that the string or list parameter called "name" is non-empty or contains
  *    no elements respectively.
+ *
+ * Each distinct template text is validated and parsed only once. The parsed templates are shared
+ * by all instances (also across threads) and rendered in a single pass over the parsed elements.
  */
 class Whiskers
 {
@@ -90,31 +94,24 @@ public:
 	std::string render() const;
 
 private:
+	struct Template;
+
 	// Prevent implicit cast to bool
 	Whiskers& operator()(std::string _parameter, long long);
-	void checkTemplateValid() const;
 	void checkParameterValid(std::string const& _parameter) const;
 	void checkParameterUnknown(std::string const& _parameter) const;
 
-	/// Checks whether the string stored in `m_template` contains all the tags specified.
+	/// Checks whether the template contains all the tags specified.
 	/// @param _parameter name of the parameter. This name is used to construct the tag(s).
 	/// @param _prefixes a vector of strings, where each element is used to compose the tag
 	///        like `"<" + element + _parameter + ">"`. Each element of _prefixes is used as a prefix of the tag name.
 	void checkTemplateContainsTags(std::string const& _parameter, std::vector<std::string> const& _prefixes) const;
 
-	static std::string replace(
-		std::string const& _template,
-		StringMap const& _parameters,
-		std::map<std::string, bool> const& _conditions,
-		StringListMap const& _listParameters = StringListMap()
-	);
-
-	static std::string paramRegex() { return "[a-zA-Z0-9_$-]+"; }
-
-	/// Joins the two maps throwing an exception if two keys are equal.
-	static StringMap joinMaps(StringMap const& _a, StringMap const& _b);
+	/// @returns the parsed template for @a _template, validating and parsing it only if it
+	/// has not been parsed before.
+	static std::shared_ptr<Template const> parsedTemplate(std::string _template);
 
-	std::string m_template;
+	std::shared_ptr<Template const> m_template;
 	StringMap m_parameters;
 	std::map<std::string, bool> m_conditions;
 	StringListMap m_listParameters;
@@ -20,6 +20,7 @@
 
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/AsmAnalysis.h>
+#include <libyul/AsmParser.h>
 #include <libyul/AsmPrinter.h>
 #include <libyul/AST.h>
 #include <libyul/Exceptions.h>
@@ -28,9 +29,12 @@
 #include <libyul/optimiser/ASTCopier.h>
 #include <libyul/optimiser/Suite.h>
 
+#include <liblangutil/CharStream.h>
 #include <liblangutil/DebugInfoSelection.h>
+#include <liblangutil/ErrorReporter.h>
 
 #include <libsolutil/Keccak256.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <boost/algorithm/string.hpp>
 
@@ -54,40 +58,61 @@ Dialect const& yul::languageToDialect(Language _language, EVMVersion _version, s
 	util::unreachable();
 }
 
-void ObjectOptimizer::optimize(Object& _object, Settings const& _settings)
+void ObjectOptimizer::optimize(Object& _object, Settings const& _settings, util::ThreadPool* _threadPool)
 {
 	yulAssert(_object.subId == std::numeric_limits<size_t>::max(), "Not a top-level object.");
 
-	optimize(_object, _settings, true /* _isCreation */);
+	// The optimization of an object does not depend on the code of its sub-objects, so all of them
+	// can be optimized concurrently. Sub-objects still come first, so that, when run sequentially,
+	// an object can reuse the cached results of a sub-object with the same code.
+	std::vector<std::function<void()>> tasks;
+	collectOptimizationTasks(_object, _settings, true /* _isCreation */, tasks);
+	if (_threadPool)
+		_threadPool->runAll(std::move(tasks));
+	else
+		for (auto const& task: tasks)
+			task();
 }
 
-void ObjectOptimizer::optimize(Object& _object, Settings const& _settings, bool _isCreation)
+void ObjectOptimizer::collectOptimizationTasks(
+	Object& _object,
+	Settings const& _settings,
+	bool _isCreation,
+	std::vector<std::function<void()>>& _tasks
+)
 {
-	yulAssert(_object.code());
-	yulAssert(_object.debugData);
-
 	for (auto& subNode: _object.subObjects)
 		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
 		{
 			bool isCreation = !boost::ends_with(subObject->name, "_deployed");
-			optimize(
+			collectOptimizationTasks(
 				*subObject,
 				_settings,
-				isCreation
+				isCreation,
+				_tasks
 			);
 		}
 
+	_tasks.emplace_back([this, &_object, &_settings, _isCreation]() {
+		optimizeCode(_object, _settings, _isCreation);
+	});
+}
+
+void ObjectOptimizer::optimizeCode(Object& _object, Settings const& _settings, bool _isCreation)
+{
+	yulAssert(_object.code());
+	yulAssert(_object.debugData);
+
 	Dialect const& dialect = languageToDialect(_settings.language, _settings.evmVersion, _settings.eofVersion);
 	std::unique_ptr<GasMeter> meter;
 	if (EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&dialect))
 		meter = std::make_unique<GasMeter>(*evmDialect, _isCreation, _settings.expectedExecutionsPerDeployment);
 
 	std::optional<h256> cacheKey = calculateCacheKey(_object.code()->root(), *_object.debugData, _settings, _isCreation);
-	if (cacheKey.has_value() && m_cachedObjects.count(*cacheKey) != 0)
-	{
-		overwriteWithOptimizedObject(*cacheKey, _object);
+	if (cacheKey.has_value() && overwriteWithOptimizedObject(*cacheKey, _object))
+		return;
+	if (cacheKey.has_value() && overwriteWithPersistentlyCachedObject(*cacheKey, _object, dialect))
 		return;
-	}
 
 	OptimiserSuite::run(
 		dialect,
@@ -101,21 +126,34 @@ void ObjectOptimizer::optimize(Object& _object, Settings const& _settings, bool
 	);
 
 	if (cacheKey.has_value())
+	{
 		storeOptimizedObject(*cacheKey, _object, dialect);
+		storePersistentlyCachedObject(*cacheKey, _object);
+	}
 }
 
 void ObjectOptimizer::storeOptimizedObject(util::h256 _cacheKey, Object const& _optimizedObject, Dialect const& _dialect)
 {
-	m_cachedObjects[_cacheKey] = CachedObject{
+	CachedObject cachedObject{
 		std::make_shared<Block>(ASTCopier{}.translate(_optimizedObject.code()->root())),
 		&_dialect,
 	};
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_cachedObjects[_cacheKey] = std::move(cachedObject);
 }
 
-void ObjectOptimizer::overwriteWithOptimizedObject(util::h256 _cacheKey, Object& _object) const
+bool ObjectOptimizer::overwriteWithOptimizedObject(util::h256 _cacheKey, Object& _object) const
 {
-	yulAssert(m_cachedObjects.count(_cacheKey) != 0);
-	CachedObject const& cachedObject = m_cachedObjects.at(_cacheKey);
+	CachedObject cachedObject;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto it = m_cachedObjects.find(_cacheKey);
+		if (it == m_cachedObjects.end())
+			return false;
+		// Cached ASTs are immutable, so it is safe to copy them without holding the lock.
+		cachedObject = it->second;
+	}
 
 	yulAssert(cachedObject.optimizedAST);
 	_object.setCode(std::make_shared<AST>(ASTCopier{}.translate(*cachedObject.optimizedAST)));
@@ -132,6 +170,55 @@ void ObjectOptimizer::overwriteWithOptimizedObject(util::h256 _cacheKey, Object&
 	);
 
 	// NOTE: Source name index is included in the key so it must be identical. No need to store and restore it.
+	return true;
+}
+
+bool ObjectOptimizer::overwriteWithPersistentlyCachedObject(
+	util::h256 _cacheKey,
+	Object& _object,
+	Dialect const& _dialect
+)
+{
+	yulAssert(_object.debugData);
+	if (!m_persistentCache || !_object.debugData->sourceNames.has_value())
+		return false;
+
+	std::optional<std::string> code = m_persistentCache->load(_cacheKey);
+	if (!code.has_value())
+		return false;
+
+	// The entry may have been corrupted or written by an incompatible compiler build.
+	// It is treated as a cache miss unless it is valid code.
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	CharStream charStream(std::move(*code), "");
+	std::shared_ptr<AST> ast = Parser(errorReporter, _dialect, _object.debugData->sourceNames).parse(charStream);
+	if (!ast || errorReporter.hasErrors())
+		return false;
+
+	auto analysisInfo = std::make_shared<AsmAnalysisInfo>();
+	AsmAnalyzer analyzer(*analysisInfo, errorReporter, _dialect, {}, _object.qualifiedDataNames());
+	if (!analyzer.analyze(ast->root()))
+		return false;
+
+	_object.setCode(std::move(ast));
+	_object.analysisInfo = std::move(analysisInfo);
+	storeOptimizedObject(_cacheKey, _object, _dialect);
+	return true;
+}
+
+void ObjectOptimizer::storePersistentlyCachedObject(util::h256 _cacheKey, Object const& _optimizedObject) const
+{
+	yulAssert(_optimizedObject.debugData);
+	if (!m_persistentCache || !_optimizedObject.debugData->sourceNames.has_value())
+		return;
+
+	// Uses the same debug info as the cache key so that parsing the entry restores the source locations.
+	AsmPrinter asmPrinter(
+		_optimizedObject.debugData->sourceNames,
+		DebugInfoSelection::All()
+	);
+	m_persistentCache->store(_cacheKey, asmPrinter(_optimizedObject.code()->root()));
 }
 
 std::optional<h256> ObjectOptimizer::calculateCacheKey(
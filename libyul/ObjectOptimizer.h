@@ -20,15 +20,24 @@
 
 #include <libyul/ASTForward.h>
 #include <libyul/Object.h>
+#include <libyul/PersistentObjectCache.h>
 
 #include <liblangutil/EVMVersion.h>
 
 #include <libsolutil/FixedHash.h>
 
+#include <functional>
+
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 
+namespace solidity::util
+{
+class ThreadPool;
+}
+
 namespace solidity::yul
 {
 
@@ -48,6 +57,10 @@ Dialect const& languageToDialect(Language _language, langutil::EVMVersion _versi
 /// Caching is performed at the granularity of individual ASTs rather than whole object trees,
 /// which means that reuse is possible even within a single hierarchy, e.g. when creation and
 /// deployed objects have common dependencies.
+///
+/// Optionally, the optimized code can also be stored in a @a PersistentObjectCache, which allows
+/// reusing it in later compiler runs. This is only done for objects that specify their source names
+/// (e.g. via the @use-src comment), because otherwise the source locations could not be restored.
 class ObjectOptimizer
 {
 public:
@@ -68,22 +81,50 @@ public:
 	/// Recursively optimizes a Yul object with given settings, reusing cached ASTs where possible
 	/// or caching the result otherwise. The object is modified in-place.
 	/// Automatically accounts for the difference between creation and deployed objects.
+	/// If @a _threadPool is given, the object and all its sub-objects are optimized concurrently.
+	/// The result does not depend on it.
 	/// @warning Does not ensure that nativeLocations in the resulting AST match the optimized code.
-	void optimize(Object& _object, Settings const& _settings);
+	void optimize(Object& _object, Settings const& _settings, util::ThreadPool* _threadPool = nullptr);
 
-	size_t size() const { return m_cachedObjects.size(); }
+	/// Sets the on-disk cache that is consulted when an object is not found in memory.
+	/// Must not be called while objects are being optimized.
+	void setPersistentCache(std::shared_ptr<PersistentObjectCache> _persistentCache)
+	{
+		m_persistentCache = std::move(_persistentCache);
+	}
+
+	size_t size() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_cachedObjects.size();
+	}
 
 private:
 	struct CachedObject
 	{
 		std::shared_ptr<Block const> optimizedAST;
-		Dialect const* dialect;
+		Dialect const* dialect = nullptr;
 	};
 
-	void optimize(Object& _object, Settings const& _settings, bool _isCreation);
+	/// Adds tasks that optimize @a _object and its sub-objects to @a _tasks, sub-objects first.
+	void collectOptimizationTasks(
+		Object& _object,
+		Settings const& _settings,
+		bool _isCreation,
+		std::vector<std::function<void()>>& _tasks
+	);
+	/// Optimizes the code of @a _object, but none of its sub-objects.
+	void optimizeCode(Object& _object, Settings const& _settings, bool _isCreation);
 
 	void storeOptimizedObject(util::h256 _cacheKey, Object const& _optimizedObject, Dialect const& _dialect);
-	void overwriteWithOptimizedObject(util::h256 _cacheKey, Object& _object) const;
+	/// Replaces the code of @a _object with the cached one if there is an entry for @a _cacheKey.
+	/// @returns false if there was no such entry.
+	bool overwriteWithOptimizedObject(util::h256 _cacheKey, Object& _object) const;
+	/// Replaces the code of @a _object with the one from the persistent cache if it has a valid
+	/// entry for @a _cacheKey and stores it in memory as well.
+	/// @returns false if there was no such entry.
+	bool overwriteWithPersistentlyCachedObject(util::h256 _cacheKey, Object& _object, Dialect const& _dialect);
+	void storePersistentlyCachedObject(util::h256 _cacheKey, Object const& _optimizedObject) const;
 
 	static std::optional<util::h256> calculateCacheKey(
 		Block const& _ast,
@@ -93,6 +134,8 @@ private:
 	);
 
 	std::map<util::h256, CachedObject> m_cachedObjects;
+	std::mutex mutable m_mutex;
+	std::shared_ptr<PersistentObjectCache> m_persistentCache;
 };
 
 }
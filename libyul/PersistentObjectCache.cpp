@@ -0,0 +1,155 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/PersistentObjectCache.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Keccak256.h>
+
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <tuple>
+#include <vector>
+
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace fs = boost::filesystem;
+
+std::string const PersistentObjectCache::entryExtension = ".yul";
+
+PersistentObjectCache::PersistentObjectCache(
+	fs::path _directory,
+	std::string const& _compilerVersion,
+	size_t _sizeLimit
+):
+	m_directory(std::move(_directory)),
+	m_versionHash(keccak256(_compilerVersion)),
+	m_sizeLimit(_sizeLimit)
+{
+}
+
+std::optional<std::string> PersistentObjectCache::load(h256 const& _key)
+{
+	fs::path const path = entryPath(_key);
+	std::ifstream file(path.string(), std::ios::binary);
+	if (!file)
+		return std::nullopt;
+
+	std::string code{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+	if (file.bad())
+		return std::nullopt;
+
+	// Mark the entry as recently used.
+	boost::system::error_code error;
+	fs::last_write_time(path, std::time(nullptr), error);
+	return code;
+}
+
+void PersistentObjectCache::store(h256 const& _key, std::string const& _code)
+{
+	boost::system::error_code error;
+	fs::create_directories(m_directory, error);
+	if (error)
+		return;
+
+	fs::path const target = entryPath(_key);
+	fs::path temporary = target;
+	temporary += fs::unique_path(".%%%%-%%%%-%%%%-%%%%.tmp", error);
+	if (error)
+		return;
+
+	{
+		std::ofstream file(temporary.string(), std::ios::binary | std::ios::trunc);
+		file << _code;
+		file.close();
+		if (!file)
+		{
+			fs::remove(temporary, error);
+			return;
+		}
+	}
+
+	// Renaming is atomic, so concurrent readers see either no entry or the complete one.
+	fs::rename(temporary, target, error);
+	if (error)
+	{
+		fs::remove(temporary, error);
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_estimatedSize.has_value())
+		*m_estimatedSize += _code.size();
+	if (!m_estimatedSize.has_value() || *m_estimatedSize > m_sizeLimit)
+		evict(target);
+}
+
+fs::path PersistentObjectCache::entryPath(h256 const& _key) const
+{
+	bytes rawKey = _key.asBytes();
+	rawKey += m_versionHash.asBytes();
+	return m_directory / (keccak256(rawKey).hex() + entryExtension);
+}
+
+void PersistentObjectCache::evict(fs::path const& _newEntry)
+{
+	std::vector<std::tuple<std::time_t, fs::path, size_t>> entries;
+	size_t totalSize = 0;
+
+	boost::system::error_code iterationError;
+	for (
+		fs::directory_iterator it(m_directory, iterationError);
+		!iterationError && it != fs::directory_iterator();
+		it.increment(iterationError)
+	)
+	{
+		fs::path const& path = it->path();
+		if (path.extension() != entryExtension)
+			continue;
+
+		boost::system::error_code error;
+		uintmax_t size = fs::file_size(path, error);
+		if (error)
+			continue;
+		std::time_t lastUse = fs::last_write_time(path, error);
+		if (error)
+			continue;
+
+		entries.emplace_back(lastUse, path, static_cast<size_t>(size));
+		totalSize += static_cast<size_t>(size);
+	}
+
+	std::sort(entries.begin(), entries.end());
+	for (auto const& [lastUse, path, size]: entries)
+	{
+		if (totalSize <= m_sizeLimit)
+			break;
+		if (path == _newEntry)
+			continue;
+		boost::system::error_code error;
+		fs::remove(path, error);
+		if (!error)
+			totalSize -= size;
+	}
+
+	m_estimatedSize = totalSize;
+}
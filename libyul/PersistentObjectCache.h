@@ -0,0 +1,82 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Directory that stores optimized Yul code between compiler runs.
+ */
+
+#pragma once
+
+#include <libsolutil/FixedHash.h>
+
+#include <boost/filesystem.hpp>
+
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace solidity::yul
+{
+
+/// Content-addressed on-disk cache for the code of optimized Yul objects.
+///
+/// Entries are files named after the hash of the cache key and the compiler version, so that
+/// a directory can be shared by different compiler versions and by concurrently running compiler
+/// processes. New entries are written to a temporary file and then renamed, so other processes
+/// never observe incomplete files. Accessing an entry updates its modification time and the
+/// least recently used entries are removed once the total size of the cache exceeds the limit.
+///
+/// The cache is best effort: file system errors are ignored and treated as cache misses.
+class PersistentObjectCache
+{
+public:
+	static constexpr size_t defaultSizeLimit = size_t(1) << 30;
+
+	PersistentObjectCache(
+		boost::filesystem::path _directory,
+		std::string const& _compilerVersion,
+		size_t _sizeLimit = defaultSizeLimit
+	);
+
+	/// @returns the code stored for @a _key or nullopt if there is no such entry.
+	std::optional<std::string> load(util::h256 const& _key);
+	/// Stores @a _code under @a _key and evicts old entries if the size limit is exceeded.
+	void store(util::h256 const& _key, std::string const& _code);
+
+	boost::filesystem::path const& directory() const { return m_directory; }
+	size_t sizeLimit() const { return m_sizeLimit; }
+
+private:
+	static std::string const entryExtension;
+
+	boost::filesystem::path entryPath(util::h256 const& _key) const;
+	/// Removes the least recently used entries until the total size is below the limit.
+	/// The entry at @a _newEntry is kept since modification times have a limited resolution.
+	/// Requires m_mutex to be held.
+	void evict(boost::filesystem::path const& _newEntry);
+
+	boost::filesystem::path const m_directory;
+	util::h256 const m_versionHash;
+	size_t const m_sizeLimit;
+
+	std::mutex m_mutex;
+	/// Total size of the entries. Only an estimate since other processes may use the same directory.
+	/// Unknown until the directory has been scanned for the first time.
+	std::optional<size_t> m_estimatedSize;
+};
+
+}
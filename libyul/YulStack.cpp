@@ -85,7 +85,7 @@ bool YulStack::parseAndAnalyze(std::string const& _sourceName, std::string const
 	return analyzeParsed();
 }
 
-void YulStack::optimize()
+void YulStack::optimize(util::ThreadPool* _threadPool)
 {
 	yulAssert(m_stackState >= AnalysisSuccessful, "Analysis was not successful.");
 	yulAssert(m_parserResult);
@@ -135,7 +135,8 @@ void YulStack::optimize()
 				yulOptimiserSteps,
 				yulOptimiserCleanupSteps,
 				m_optimiserSettings.expectedExecutionsPerDeployment
-			}
+			},
+			_threadPool
 		);
 
 		// Optimizer does not maintain correct native source locations in the AST.
@@ -204,7 +205,14 @@ void YulStack::compileEVM(AbstractAssembly& _assembly, bool _optimize) const
 			break;
 	}
 
-	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _optimize, m_eofVersion);
+	EVMObjectCompiler::compile(
+		*m_parserResult,
+		_assembly,
+		*dialect,
+		_optimize,
+		m_eofVersion,
+		m_optimiserSettings.experimentalSSACFGCodeTransform
+	);
 }
 
 void YulStack::reparse()
@@ -302,7 +310,7 @@ YulStack::assembleWithDeployed(std::optional<std::string_view> _deployName)
 }
 
 std::pair<std::shared_ptr<evmasm::Assembly>, std::shared_ptr<evmasm::Assembly>>
-YulStack::assembleEVMWithDeployed(std::optional<std::string_view> _deployName)
+YulStack::assembleEVMWithDeployed(std::optional<std::string_view> _deployName, util::ThreadPool* _threadPool)
 {
 	yulAssert(m_stackState >= AnalysisSuccessful);
 	yulAssert(m_parserResult, "");
@@ -323,7 +331,7 @@ YulStack::assembleEVMWithDeployed(std::optional<std::string_view> _deployName)
 	{
 		compileEVM(adapter, optimize);
 
-		assembly.optimise(evmasm::Assembly::OptimiserSettings::translateSettings(m_optimiserSettings, m_evmVersion));
+		assembly.optimise(evmasm::Assembly::OptimiserSettings::translateSettings(m_optimiserSettings, m_evmVersion), _threadPool);
 
 		std::optional<size_t> subIndex;
 
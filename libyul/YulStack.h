@@ -48,6 +48,11 @@ namespace solidity::langutil
 class Scanner;
 }
 
+namespace solidity::util
+{
+class ThreadPool;
+}
+
 namespace solidity::yul
 {
 class AbstractAssembly;
@@ -112,7 +117,8 @@ public:
 
 	/// Run the optimizer suite. Can only be used with Yul or strict assembly.
 	/// If the settings (see constructor) disabled the optimizer, nothing is done here.
-	void optimize();
+	/// If @a _threadPool is given, the objects are optimized concurrently.
+	void optimize(util::ThreadPool* _threadPool = nullptr);
 
 	/// Run the assembly step (should only be called after parseAndAnalyze).
 	MachineAssemblyObject assemble(Machine _machine);
@@ -128,10 +134,12 @@ public:
 
 	/// Run the assembly step (should only be called after parseAndAnalyze).
 	/// Similar to @a assemblyWithDeployed, but returns EVM assembly objects.
+	/// If @a _threadPool is given, the sub-assemblies are optimized concurrently.
 	/// Only available for EVM.
 	std::pair<std::shared_ptr<evmasm::Assembly>, std::shared_ptr<evmasm::Assembly>>
 	assembleEVMWithDeployed(
-		std::optional<std::string_view> _deployName = {}
+		std::optional<std::string_view> _deployName = {},
+		util::ThreadPool* _threadPool = nullptr
 	);
 
 	/// @returns the errors generated during parsing, analysis (and potentially assembly).
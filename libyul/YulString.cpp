@@ -0,0 +1,72 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/YulString.h>
+
+#include <liblangutil/Exceptions.h>
+
+using namespace solidity::yul;
+
+YulStringRepository::Scope::Scope()
+{
+	YulStringRepository& repository = instance();
+	std::lock_guard<std::mutex> lock(repository.m_scopeMutex);
+	if (repository.m_activeScopes++ == 0)
+		repository.clear();
+}
+
+YulStringRepository::Scope::~Scope()
+{
+	YulStringRepository& repository = instance();
+	std::lock_guard<std::mutex> lock(repository.m_scopeMutex);
+	solAssert(repository.m_activeScopes > 0);
+	--repository.m_activeScopes;
+}
+
+void YulStringRepository::reset()
+{
+	YulStringRepository& repository = instance();
+	std::lock_guard<std::mutex> lock(repository.m_scopeMutex);
+	if (repository.m_activeScopes == 0)
+		repository.clear();
+}
+
+YulStringRepository::ResetCallback::ResetCallback(std::function<void()> _fun)
+{
+	YulStringRepository& repository = instance();
+	std::lock_guard<std::mutex> lock(repository.m_resetCallbacksMutex);
+	repository.m_resetCallbacks.emplace_back(std::move(_fun));
+}
+
+void YulStringRepository::clear()
+{
+	// The callbacks are run without holding the lock, since they may create
+	// dialects which in turn register further callbacks.
+	std::vector<std::function<void()>> callbacks;
+	{
+		std::lock_guard<std::mutex> lock(m_resetCallbacksMutex);
+		callbacks = m_resetCallbacks;
+	}
+	for (auto const& callback: callbacks)
+		callback();
+	for (Shard& shard: m_shards)
+	{
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		shard.strings.clear();
+	}
+}
@@ -23,8 +23,9 @@
 
 #include <fmt/format.h>
 
+#include <array>
 #include <unordered_map>
-#include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <functional>
@@ -34,17 +35,34 @@ namespace solidity::yul
 
 /// Repository for YulStrings.
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
-/// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
-/// non-deterministic) and a deterministic string hash.
+/// A Handle consists of a pointer to the owned string (which depends on the insertion order of
+/// YulStrings and is potentially non-deterministic) and a deterministic string hash.
+///
+/// The strings are distributed over a fixed number of shards by their hash, each guarded by its own
+/// mutex, so that YulStrings can be created concurrently from multiple threads. The strings are never
+/// moved while the repository is not reset, so accessing the string of a handle does not need any locking.
 class YulStringRepository
 {
 public:
 	struct Handle
 	{
-		size_t id;
+		std::string const* string;
 		std::uint64_t hash;
 	};
 
+	/// Marks a region, usually a compilation, during which the YulStrings it creates have to stay valid.
+	/// The repository is reset when a scope is entered and no other scope is active.
+	/// Explicit calls to reset() are ignored while any scope is active, so that concurrent
+	/// compilations do not invalidate each other's strings.
+	class Scope
+	{
+	public:
+		Scope();
+		~Scope();
+		Scope(Scope const&) = delete;
+		Scope& operator=(Scope const&) = delete;
+	};
+
 	static YulStringRepository& instance()
 	{
 		static YulStringRepository inst;
@@ -54,23 +72,23 @@ public:
 	Handle stringToHandle(std::string const& _string)
 	{
 		if (_string.empty())
-			return { 0, emptyHash() };
+			return { &emptyString(), emptyHash() };
 		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
+		Shard& shard = m_shards[h >> (64 - shardBits)];
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		auto range = shard.strings.equal_range(h);
 		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
-
-		return Handle{id, h};
+			if (it->second == _string)
+				return Handle{&it->second, h};
+		// Element addresses in unordered containers are stable under rehashing.
+		auto it = shard.strings.emplace_hint(range.second, h, _string);
+		return Handle{&it->second, h};
 	}
-	std::string const& idToString(size_t _id) const { return *m_strings.at(_id); }
 
 	static std::uint64_t hash(std::string const& v)
 	{
-		// FNV hash - can be replaced by a better one, e.g. xxhash64
+		// FNV hash. The hash determines the iteration order of containers keyed by YulStrings,
+		// and thus the optimiser output, so it cannot be changed without affecting the bytecode.
 		std::uint64_t hash = emptyHash();
 		for (char c: v)
 		{
@@ -81,45 +99,52 @@ public:
 		return hash;
 	}
 	static constexpr std::uint64_t emptyHash() { return 14695981039346656037u; }
-	/// Clear the repository.
+	/// The string referenced by all empty YulStrings. It is not owned by the repository and survives resets.
+	static std::string const& emptyString()
+	{
+		static std::string const empty;
+		return empty;
+	}
+	/// Clear the repository, unless a Scope is active.
 	/// Use with care - there cannot be any dangling YulString references.
 	/// If references need to be cleared manually, register the callback via
 	/// resetCallback.
-	static void reset()
-	{
-		for (auto const& cb: resetCallbacks())
-			cb();
-		instance() = YulStringRepository{};
-	}
+	static void reset();
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
 	struct ResetCallback
 	{
-		ResetCallback(std::function<void()> _fun)
-		{
-			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
-		}
+		ResetCallback(std::function<void()> _fun);
 	};
 
 private:
+	/// Number of bits of the string hash used to select the shard.
+	static constexpr unsigned shardBits = 6;
+
+	struct Shard
+	{
+		std::mutex mutex;
+		std::unordered_multimap<std::uint64_t, std::string> strings;
+	};
+
 	YulStringRepository() = default;
 	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
 	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
 
-	static std::vector<std::function<void()>>& resetCallbacks()
-	{
-		static std::vector<std::function<void()>> callbacks;
-		return callbacks;
-	}
+	/// Runs the reset callbacks and removes all strings. Requires m_scopeMutex to be held.
+	void clear();
+
+	std::array<Shard, size_t(1) << shardBits> m_shards;
+
+	std::mutex m_scopeMutex;
+	size_t m_activeScopes = 0;
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	std::mutex m_resetCallbacksMutex;
+	std::vector<std::function<void()>> m_resetCallbacks;
 };
 
 /// Wrapper around handles into the YulString repository.
-/// Equality of two YulStrings is determined by comparing their ID.
+/// Equality of two YulStrings is determined by comparing their string pointers.
 /// The <-operator depends on the string hash and is not consistent
 /// with string comparisons (however, it is still deterministic).
 class YulString
@@ -134,32 +159,29 @@ public:
 
 	/// This is not consistent with the string <-operator!
 	/// First compares the string hashes. If they are equal
-	/// it checks for identical IDs (only identical strings have
-	/// identical IDs and identical strings do not compare as "less").
+	/// it checks for identical string pointers (only identical strings have
+	/// identical pointers and identical strings do not compare as "less").
 	/// If the hashes are identical and the strings are distinct, it
 	/// falls back to string comparison.
 	bool operator<(YulString const& _other) const
 	{
 		if (m_handle.hash < _other.m_handle.hash) return true;
 		if (_other.m_handle.hash < m_handle.hash) return false;
-		if (m_handle.id == _other.m_handle.id) return false;
+		if (m_handle.string == _other.m_handle.string) return false;
 		return str() < _other.str();
 	}
-	/// Equality is determined based on the string ID.
-	bool operator==(YulString const& _other) const { return m_handle.id == _other.m_handle.id; }
-	bool operator!=(YulString const& _other) const { return m_handle.id != _other.m_handle.id; }
+	/// Equality is determined based on the string pointer.
+	bool operator==(YulString const& _other) const { return m_handle.string == _other.m_handle.string; }
+	bool operator!=(YulString const& _other) const { return m_handle.string != _other.m_handle.string; }
 
-	bool empty() const { return m_handle.id == 0; }
-	std::string const& str() const
-	{
-		return YulStringRepository::instance().idToString(m_handle.id);
-	}
+	bool empty() const { return m_handle.string->empty(); }
+	std::string const& str() const { return *m_handle.string; }
 
 	uint64_t hash() const { return m_handle.hash; }
 
 private:
-	/// Handle of the string. Assumes that the empty string has ID zero.
-	YulStringRepository::Handle m_handle{ 0, YulStringRepository::emptyHash() };
+	/// Handle of the string. Assumes that all empty strings share the same pointer.
+	YulStringRepository::Handle m_handle{ &YulStringRepository::emptyString(), YulStringRepository::emptyHash() };
 };
 
 inline YulString operator "" _yulname(char const* _string, std::size_t _size)
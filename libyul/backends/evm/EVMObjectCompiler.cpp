@@ -24,6 +24,7 @@
 #include <libyul/backends/evm/EVMCodeTransform.h>
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/backends/evm/OptimizedEVMCodeTransform.h>
+#include <libyul/backends/evm/SSACFGEVMCodeTransform.h>
 
 #include <libyul/optimiser/FunctionCallFinder.h>
 
@@ -39,10 +40,11 @@ void EVMObjectCompiler::compile(
 	AbstractAssembly& _assembly,
 	EVMDialect const& _dialect,
 	bool _optimize,
-	std::optional<uint8_t> _eofVersion
+	std::optional<uint8_t> _eofVersion,
+	bool _experimentalSSACFGCodeTransform
 )
 {
-	EVMObjectCompiler compiler(_assembly, _dialect, _eofVersion);
+	EVMObjectCompiler compiler(_assembly, _dialect, _eofVersion, _experimentalSSACFGCodeTransform);
 	compiler.run(_object, _optimize);
 }
 
@@ -59,7 +61,14 @@ void EVMObjectCompiler::run(Object const& _object, bool _optimize)
 			auto subAssemblyAndID = m_assembly.createSubAssembly(isCreation, subObject->name);
 			context.subIDs[subObject->name] = subAssemblyAndID.second;
 			subObject->subId = subAssemblyAndID.second;
-			compile(*subObject, *subAssemblyAndID.first, m_dialect, _optimize, m_eofVersion);
+			compile(
+				*subObject,
+				*subAssemblyAndID.first,
+				m_dialect,
+				_optimize,
+				m_eofVersion,
+				m_experimentalSSACFGCodeTransform
+			);
 		}
 		else
 		{
@@ -80,14 +89,23 @@ void EVMObjectCompiler::run(Object const& _object, bool _optimize)
 		);
 	if (_optimize && m_dialect.evmVersion().canOverchargeGasForCall())
 	{
-		auto stackErrors = OptimizedEVMCodeTransform::run(
-			m_assembly,
-			*_object.analysisInfo,
-			_object.code()->root(),
-			m_dialect,
-			context,
-			OptimizedEVMCodeTransform::UseNamedLabels::ForFirstFunctionOfEachName
-		);
+		auto stackErrors = (m_experimentalSSACFGCodeTransform && !m_eofVersion.has_value()) ?
+			SSACFGEVMCodeTransform::run(
+				m_assembly,
+				*_object.analysisInfo,
+				_object.code()->root(),
+				m_dialect,
+				context,
+				OptimizedEVMCodeTransform::UseNamedLabels::ForFirstFunctionOfEachName
+			) :
+			OptimizedEVMCodeTransform::run(
+				m_assembly,
+				*_object.analysisInfo,
+				_object.code()->root(),
+				m_dialect,
+				context,
+				OptimizedEVMCodeTransform::UseNamedLabels::ForFirstFunctionOfEachName
+			);
 		if (!stackErrors.empty())
 		{
 			std::vector<FunctionCall const*> memoryGuardCalls = findFunctionCalls(
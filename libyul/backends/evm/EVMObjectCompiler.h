@@ -38,11 +38,20 @@ public:
 		AbstractAssembly& _assembly,
 		EVMDialect const& _dialect,
 		bool _optimize,
-		std::optional<uint8_t> _eofVersion
+		std::optional<uint8_t> _eofVersion,
+		bool _experimentalSSACFGCodeTransform = false
 	);
 private:
-	EVMObjectCompiler(AbstractAssembly& _assembly, EVMDialect const& _dialect, std::optional<uint8_t> _eofVersion):
-		m_assembly(_assembly), m_dialect(_dialect), m_eofVersion(_eofVersion)
+	EVMObjectCompiler(
+		AbstractAssembly& _assembly,
+		EVMDialect const& _dialect,
+		std::optional<uint8_t> _eofVersion,
+		bool _experimentalSSACFGCodeTransform
+	):
+		m_assembly(_assembly),
+		m_dialect(_dialect),
+		m_eofVersion(_eofVersion),
+		m_experimentalSSACFGCodeTransform(_experimentalSSACFGCodeTransform)
 	{}
 
 	void run(Object const& _object, bool _optimize);
@@ -50,6 +59,9 @@ private:
 	AbstractAssembly& m_assembly;
 	EVMDialect const& m_dialect;
 	std::optional<uint8_t> m_eofVersion;
+	/// Use SSACFGEVMCodeTransform instead of OptimizedEVMCodeTransform for optimized code
+	/// that does not target EOF.
+	bool m_experimentalSSACFGCodeTransform = false;
 };
 
 }
@@ -0,0 +1,252 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/backends/evm/SSACFGConstantPropagation.h>
+
+#include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/optimiser/SimplificationRules.h>
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+
+#include <libsolutil/Visitor.h>
+
+#include <range/v3/view/reverse.hpp>
+
+#include <algorithm>
+#include <iterator>
+
+using namespace solidity;
+using namespace solidity::yul;
+
+SSACFGConstantPropagation::SSACFGConstantPropagation(Dialect const& _dialect, SSACFG const& _cfg):
+	m_dialect(_dialect),
+	m_cfg(_cfg),
+	m_values(_cfg.numValues()),
+	m_uses(_cfg.numValues()),
+	m_phiUses(_cfg.numValues()),
+	m_executableBlocks(_cfg.numBlocks(), false),
+	m_executableEdges(_cfg.numBlocks())
+{
+	for (size_t valueIdValue = 0; valueIdValue < m_cfg.numValues(); ++valueIdValue)
+		std::visit(util::GenericVisitor{
+			[&](SSACFG::LiteralValue const& _literal) {
+				m_values[valueIdValue] = {LatticeValue::Kind::Constant, _literal.value};
+			},
+			[&](SSACFG::UnreachableValue const&) {
+				m_values[valueIdValue].kind = LatticeValue::Kind::Overdefined;
+			},
+			[](auto const&) {}
+		}, m_cfg.valueInfo(SSACFG::ValueId{valueIdValue}));
+	// the arguments of a function are not defined by any operation and can have any value
+	for (auto const& argument: m_cfg.arguments)
+		m_values[std::get<1>(argument).value].kind = LatticeValue::Kind::Overdefined;
+
+	for (size_t blockIdValue = 0; blockIdValue < m_cfg.numBlocks(); ++blockIdValue)
+	{
+		SSACFG::BlockId const blockId{blockIdValue};
+		auto const& block = m_cfg.block(blockId);
+		m_executableEdges[blockIdValue].resize(block.entries.size(), false);
+		for (auto const& phi: block.phis)
+		{
+			auto const* phiInfo = std::get_if<SSACFG::PhiValue>(&m_cfg.valueInfo(phi));
+			yulAssert(phiInfo && phiInfo->arguments.size() == block.entries.size());
+			for (auto const& argument: phiInfo->arguments)
+				m_phiUses[argument.value].push_back(phi);
+		}
+		for (size_t index = 0; index < block.operations.size(); ++index)
+			for (auto const& input: block.operations[index].inputs)
+				m_uses[input.value].push_back(Use{blockId, index});
+		if (auto const* conditionalJump = std::get_if<SSACFG::BasicBlock::ConditionalJump>(&block.exit))
+			m_uses[conditionalJump->condition.value].push_back(Use{blockId, block.operations.size()});
+		else if (auto const* jumpTable = std::get_if<SSACFG::BasicBlock::JumpTable>(&block.exit))
+			m_uses[jumpTable->value.value].push_back(Use{blockId, block.operations.size()});
+	}
+
+	m_executableBlocks[m_cfg.entry.value] = true;
+	m_blockWorklist.push_back(m_cfg.entry);
+	while (!m_blockWorklist.empty() || !m_valueWorklist.empty())
+		if (!m_blockWorklist.empty())
+		{
+			SSACFG::BlockId const blockId = m_blockWorklist.back();
+			m_blockWorklist.pop_back();
+			auto const& block = m_cfg.block(blockId);
+			for (auto const& phi: block.phis)
+				visitPhi(phi);
+			for (size_t index = 0; index < block.operations.size(); ++index)
+				visitOperation(blockId, index);
+			visitExit(blockId);
+		}
+		else
+		{
+			SSACFG::ValueId const value = m_valueWorklist.back();
+			m_valueWorklist.pop_back();
+			for (auto const& phi: m_phiUses[value.value])
+				if (m_executableBlocks[std::get<SSACFG::PhiValue>(m_cfg.valueInfo(phi)).block.value])
+					visitPhi(phi);
+			for (auto const& use: m_uses[value.value])
+				if (m_executableBlocks[use.block.value])
+				{
+					if (use.operation < m_cfg.block(use.block).operations.size())
+						visitOperation(use.block, use.operation);
+					else
+						visitExit(use.block);
+				}
+		}
+}
+
+std::optional<u256> SSACFGConstantPropagation::constant(SSACFG::ValueId _value) const
+{
+	LatticeValue const& value = m_values[_value.value];
+	if (value.kind == LatticeValue::Kind::Constant)
+		return value.value;
+	return std::nullopt;
+}
+
+void SSACFGConstantPropagation::markEdgeExecutable(SSACFG::BlockId _source, SSACFG::BlockId _target)
+{
+	auto const& target = m_cfg.block(_target);
+	auto it = target.entries.find(_source);
+	yulAssert(it != target.entries.end());
+	auto&& executableEdge = m_executableEdges[_target.value][static_cast<size_t>(std::distance(target.entries.begin(), it))];
+	if (executableEdge)
+		return;
+	executableEdge = true;
+
+	if (!m_executableBlocks[_target.value])
+	{
+		m_executableBlocks[_target.value] = true;
+		m_blockWorklist.push_back(_target);
+	}
+	else
+		// the phis of the target now have to take the arguments coming from the new edge into account
+		for (auto const& phi: target.phis)
+			visitPhi(phi);
+}
+
+void SSACFGConstantPropagation::visitPhi(SSACFG::ValueId _phi)
+{
+	auto const& phiInfo = std::get<SSACFG::PhiValue>(m_cfg.valueInfo(_phi));
+	auto const& executableEdges = m_executableEdges[phiInfo.block.value];
+	LatticeValue result;
+	for (size_t index = 0; index < phiInfo.arguments.size(); ++index)
+		if (executableEdges[index])
+			result = meet(result, m_values[phiInfo.arguments[index].value]);
+	setValue(_phi, result);
+}
+
+void SSACFGConstantPropagation::visitOperation(SSACFG::BlockId _block, size_t _operation)
+{
+	auto const& operation = m_cfg.block(_block).operations[_operation];
+	LatticeValue const result = evaluate(operation);
+	for (auto const& output: operation.outputs)
+		setValue(output, result);
+}
+
+void SSACFGConstantPropagation::visitExit(SSACFG::BlockId _block)
+{
+	auto const& block = m_cfg.block(_block);
+	std::visit(util::GenericVisitor{
+		[&](SSACFG::BasicBlock::Jump const& _jump) {
+			markEdgeExecutable(_block, _jump.target);
+		},
+		[&](SSACFG::BasicBlock::ConditionalJump const& _conditionalJump) {
+			LatticeValue const& condition = m_values[_conditionalJump.condition.value];
+			if (condition.kind == LatticeValue::Kind::Overdefined)
+			{
+				markEdgeExecutable(_block, _conditionalJump.nonZero);
+				markEdgeExecutable(_block, _conditionalJump.zero);
+			}
+			else if (condition.kind == LatticeValue::Kind::Constant)
+				markEdgeExecutable(_block, condition.value != 0 ? _conditionalJump.nonZero : _conditionalJump.zero);
+		},
+		[&](SSACFG::BasicBlock::JumpTable const& _jumpTable) {
+			LatticeValue const& value = m_values[_jumpTable.value.value];
+			if (value.kind == LatticeValue::Kind::Overdefined)
+				block.forEachExit([&](SSACFG::BlockId _target) { markEdgeExecutable(_block, _target); });
+			else if (value.kind == LatticeValue::Kind::Constant)
+			{
+				auto it = _jumpTable.cases.find(value.value);
+				markEdgeExecutable(_block, it != _jumpTable.cases.end() ? it->second : _jumpTable.defaultCase);
+			}
+		},
+		[](auto const&) {}
+	}, block.exit);
+}
+
+void SSACFGConstantPropagation::setValue(SSACFG::ValueId _value, LatticeValue _latticeValue)
+{
+	LatticeValue& value = m_values[_value.value];
+	// values can only be lowered, which guarantees termination
+	LatticeValue const lowered = meet(value, _latticeValue);
+	if (lowered == value)
+		return;
+	value = lowered;
+	m_valueWorklist.push_back(_value);
+}
+
+SSACFGConstantPropagation::LatticeValue SSACFGConstantPropagation::evaluate(SSACFG::Operation const& _operation) const
+{
+	static LatticeValue const overdefined{LatticeValue::Kind::Overdefined, 0};
+	auto const* builtinCall = std::get_if<SSACFG::BuiltinCall>(&_operation.kind);
+	if (!builtinCall || _operation.outputs.size() != 1)
+		return overdefined;
+	BuiltinFunction const& builtin = builtinCall->builtin.get();
+	if (
+		!builtin.sideEffects.movable ||
+		std::any_of(
+			builtin.literalArguments.begin(),
+			builtin.literalArguments.end(),
+			[](std::optional<LiteralKind> const& _literalKind) { return _literalKind.has_value(); }
+		)
+	)
+		return overdefined;
+
+	bool undefined = false;
+	for (auto const& input: _operation.inputs)
+		if (m_values[input.value].kind == LatticeValue::Kind::Overdefined)
+			return overdefined;
+		else if (m_values[input.value].kind == LatticeValue::Kind::Undefined)
+			undefined = true;
+	if (undefined)
+		return {};
+
+	// the inputs of the operation are its arguments in reverse order
+	FunctionCall call{{}, Identifier{{}, YulName{builtin.name}}, {}};
+	for (auto const& input: _operation.inputs | ranges::views::reverse)
+		call.arguments.emplace_back(Literal{{}, LiteralKind::Number, LiteralValue{m_values[input.value].value}});
+	Expression expression{std::move(call)};
+	while (auto const* match = SimplificationRules::findFirstMatch(
+		expression,
+		m_dialect,
+		[](YulName) -> AssignedValue const* { return nullptr; }
+	))
+		expression = match->action().toExpression({}, evmVersionFromDialect(m_dialect));
+
+	if (Literal const* literal = std::get_if<Literal>(&expression))
+		return {LatticeValue::Kind::Constant, literal->value.value()};
+	return overdefined;
+}
+
+SSACFGConstantPropagation::LatticeValue SSACFGConstantPropagation::meet(LatticeValue const& _lhs, LatticeValue const& _rhs)
+{
+	if (_lhs.kind == LatticeValue::Kind::Undefined)
+		return _rhs;
+	if (_rhs.kind == LatticeValue::Kind::Undefined || _lhs == _rhs)
+		return _lhs;
+	return {LatticeValue::Kind::Overdefined, 0};
+}
@@ -0,0 +1,90 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <libyul/backends/evm/SSAControlFlowGraph.h>
+
+#include <libsolutil/Numeric.h>
+
+#include <optional>
+#include <vector>
+
+namespace solidity::yul
+{
+struct Dialect;
+
+/// Sparse conditional constant propagation on an SSA CFG following [1].
+///
+/// Values are only considered on control flow edges that can be taken, i.e. the arguments of phi functions
+/// coming from blocks that are never executed are ignored and conditional jumps on constant conditions only
+/// make one of their targets executable. Operations are evaluated using the simplification rules of the
+/// optimiser, if all their inputs are constant and they are movable builtins without literal arguments.
+///
+/// [1] Wegman, Mark N., and F. Kenneth Zadeck. "Constant propagation with conditional branches."
+/// ACM Transactions on Programming Languages and Systems 13.2 (1991): 181-210.
+class SSACFGConstantPropagation
+{
+public:
+	SSACFGConstantPropagation(Dialect const& _dialect, SSACFG const& _cfg);
+
+	/// @returns the value of @a _value, if it is the same constant whenever it is defined.
+	std::optional<u256> constant(SSACFG::ValueId _value) const;
+	/// @returns false, if the block @a _block is never executed.
+	bool executable(SSACFG::BlockId _block) const { return m_executableBlocks[_block.value]; }
+
+private:
+	/// Element of the lattice of the analysis. Values start out as undefined (i.e. not defined on any
+	/// executable path yet) and can only be lowered to a constant and then to overdefined.
+	struct LatticeValue
+	{
+		enum class Kind { Undefined, Constant, Overdefined };
+		Kind kind = Kind::Undefined;
+		u256 value;
+		bool operator==(LatticeValue const& _other) const { return kind == _other.kind && value == _other.value; }
+	};
+	/// Use of a value by the operation with index @a operation of @a block, or by the exit of @a block,
+	/// if @a operation is the number of operations of @a block.
+	struct Use
+	{
+		SSACFG::BlockId block;
+		size_t operation;
+	};
+
+	void markEdgeExecutable(SSACFG::BlockId _source, SSACFG::BlockId _target);
+	void visitPhi(SSACFG::ValueId _phi);
+	void visitOperation(SSACFG::BlockId _block, size_t _operation);
+	void visitExit(SSACFG::BlockId _block);
+	void setValue(SSACFG::ValueId _value, LatticeValue _latticeValue);
+	/// @returns the result of the operation @a _operation given the current values of its inputs.
+	LatticeValue evaluate(SSACFG::Operation const& _operation) const;
+	static LatticeValue meet(LatticeValue const& _lhs, LatticeValue const& _rhs);
+
+	Dialect const& m_dialect;
+	SSACFG const& m_cfg;
+	std::vector<LatticeValue> m_values;
+	std::vector<std::vector<Use>> m_uses;
+	std::vector<std::vector<SSACFG::ValueId>> m_phiUses;
+	std::vector<bool> m_executableBlocks;
+	/// For each block, whether the edge from the respective entry (in the order of BasicBlock::entries) can be taken.
+	std::vector<std::vector<bool>> m_executableEdges;
+	std::vector<SSACFG::BlockId> m_blockWorklist;
+	std::vector<SSACFG::ValueId> m_valueWorklist;
+};
+
+}
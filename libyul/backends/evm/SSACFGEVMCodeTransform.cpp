@@ -0,0 +1,562 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/backends/evm/SSACFGEVMCodeTransform.h>
+
+#include <libyul/backends/evm/ControlFlow.h>
+#include <libyul/backends/evm/SSAControlFlowGraphBuilder.h>
+#include <libyul/backends/evm/StackHelpers.h>
+
+#include <libevmasm/Instruction.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Visitor.h>
+
+#include <range/v3/view/map.hpp>
+#include <range/v3/view/reverse.hpp>
+
+#include <deque>
+#include <set>
+
+using namespace solidity;
+using namespace solidity::yul;
+
+std::vector<StackTooDeepError> SSACFGEVMCodeTransform::run(
+	AbstractAssembly& _assembly,
+	AsmAnalysisInfo& _analysisInfo,
+	Block const& _block,
+	EVMDialect const& _dialect,
+	BuiltinContext& _builtinContext,
+	OptimizedEVMCodeTransform::UseNamedLabels _useNamedLabelsForFunctions
+)
+{
+	using UseNamedLabels = OptimizedEVMCodeTransform::UseNamedLabels;
+	std::unique_ptr<ControlFlow> controlFlow = SSAControlFlowGraphBuilder::build(_analysisInfo, _dialect, _block);
+	ControlFlowLiveness liveness(*controlFlow);
+
+	std::map<Scope::Function const*, AbstractAssembly::LabelID> functionLabels;
+	std::set<YulName> assignedFunctionNames;
+	for (auto const& [function, cfg]: controlFlow->functionGraphMapping)
+	{
+		bool nameAlreadySeen = !assignedFunctionNames.insert(function->name).second;
+		if (_useNamedLabelsForFunctions == UseNamedLabels::YesAndForceUnique)
+			yulAssert(!nameAlreadySeen);
+		bool useNamedLabel = _useNamedLabelsForFunctions != UseNamedLabels::Never && !nameAlreadySeen;
+		functionLabels[function] = useNamedLabel ?
+			_assembly.namedLabel(
+				function->name.str(),
+				function->numArguments,
+				function->numReturns,
+				cfg->debugData ? cfg->debugData->astID : std::nullopt
+			) :
+			_assembly.newLabelId();
+	}
+
+	std::vector<StackTooDeepError> stackErrors;
+	auto generateGraph = [&](SSACFG const& _cfg, SSACFGLiveness const& _liveness) {
+		SSACFGEVMCodeTransform transform(_assembly, _builtinContext, functionLabels, _cfg, _liveness);
+		transform.generate();
+		stackErrors += std::move(transform.m_stackErrors);
+	};
+	generateGraph(*controlFlow->mainGraph, *liveness.mainLiveness);
+	for (size_t index = 0; index < controlFlow->functionGraphs.size(); ++index)
+		generateGraph(*controlFlow->functionGraphs[index], *liveness.functionLiveness[index]);
+	return stackErrors;
+}
+
+SSACFGEVMCodeTransform::SSACFGEVMCodeTransform(
+	AbstractAssembly& _assembly,
+	BuiltinContext& _builtinContext,
+	std::map<Scope::Function const*, AbstractAssembly::LabelID> const& _functionLabels,
+	SSACFG const& _cfg,
+	SSACFGLiveness const& _liveness
+):
+	m_assembly(_assembly),
+	m_builtinContext(_builtinContext),
+	m_functionLabels(_functionLabels),
+	m_cfg(_cfg),
+	m_liveness(_liveness),
+	m_blockLayouts(_cfg.numBlocks()),
+	m_blockLabels(_cfg.numBlocks()),
+	m_generated(_cfg.numBlocks(), false)
+{
+}
+
+void SSACFGEVMCodeTransform::generate()
+{
+	yulAssert(m_stack.empty() && m_assembly.stackHeight() == 0);
+
+	// Create the function entry layout, i.e. the return label below the arguments with the first argument on top.
+	if (m_cfg.function)
+	{
+		if (m_cfg.canContinue)
+			m_stack.emplace_back(FunctionReturnLabelSlot{*m_cfg.function});
+		for (auto const& parameter: m_cfg.arguments | ranges::views::reverse)
+			m_stack.emplace_back(std::get<1>(parameter));
+		m_assembly.setStackHeight(static_cast<int>(m_stack.size()));
+		m_assembly.setSourceLocation(originLocationOf(m_cfg));
+		m_assembly.appendLabel(m_functionLabels.at(m_cfg.function));
+	}
+	m_blockLayouts[m_cfg.entry.value] = m_stack;
+
+	std::optional<SSACFG::BlockId> next = m_cfg.entry;
+	while (true)
+	{
+		while (next)
+			next = (*this)(*next);
+		if (m_pending.empty())
+			break;
+
+		PendingTarget pending = std::move(m_pending.back());
+		m_pending.pop_back();
+		if (pending.stub)
+		{
+			m_stack = std::move(pending.stubLayout);
+			m_assembly.setStackHeight(static_cast<int>(m_stack.size()));
+			m_assembly.appendLabel(*pending.stub);
+			next = jump(pending.debugData, pending.source, pending.target);
+		}
+		else if (!m_generated[pending.target.value])
+		{
+			m_stack = *m_blockLayouts[pending.target.value];
+			m_assembly.setStackHeight(static_cast<int>(m_stack.size()));
+			next = pending.target;
+		}
+	}
+
+	m_stack.clear();
+	m_assembly.setStackHeight(0);
+}
+
+std::optional<SSACFG::BlockId> SSACFGEVMCodeTransform::operator()(SSACFG::BlockId _block)
+{
+	// Assert that this is the first visit of the block and mark as generated.
+	yulAssert(!m_generated[_block.value]);
+	m_generated[_block.value] = true;
+
+	auto const& block = m_cfg.block(_block);
+	auto const& layout = m_blockLayouts[_block.value];
+	yulAssert(layout && layout->size() == m_stack.size());
+	yulAssert(m_assembly.stackHeight() == static_cast<int>(m_stack.size()));
+	// Replaces the arguments of the phi functions by the phi functions themselves.
+	m_stack = *layout;
+
+	m_assembly.setSourceLocation(originLocationOf(block));
+	// Blocks with multiple predecessors and targets of conditional jumps are jumped to.
+	if (m_blockLabels[_block.value] || block.entries.size() + (_block == m_cfg.entry ? 1 : 0) > 1)
+		m_assembly.appendLabel(blockLabel(_block));
+
+	auto const& operationsLiveOut = m_liveness.operationsLiveOut(_block);
+	for (size_t index = 0; index < block.operations.size(); ++index)
+		(*this)(block.operations[index], operationsLiveOut[index]);
+
+	m_assembly.setSourceLocation(originLocationOf(block));
+	return std::visit(util::GenericVisitor{
+		[&](SSACFG::BasicBlock::MainExit const&) -> std::optional<SSACFG::BlockId>
+		{
+			m_assembly.appendInstruction(evmasm::Instruction::STOP);
+			return std::nullopt;
+		},
+		[&](SSACFG::BasicBlock::Jump const& _jump) -> std::optional<SSACFG::BlockId>
+		{
+			return jump(_jump.debugData, _block, _jump.target);
+		},
+		[&](SSACFG::BasicBlock::ConditionalJump const& _conditionalJump) -> std::optional<SSACFG::BlockId>
+		{
+			yulAssert(_conditionalJump.nonZero != _conditionalJump.zero);
+
+			// Retain everything needed by either of the targets and put the condition on top.
+			Layout sharedLayout = retainLive(m_stack, m_liveness.liveOut(_block));
+			Layout conditionLayout = sharedLayout;
+			conditionLayout.emplace_back(_conditionalJump.condition);
+			createStackLayout(_conditionalJump.debugData, conditionLayout);
+
+			SSACFG::BlockId nonZero = _conditionalJump.nonZero;
+			auto& nonZeroLayout = m_blockLayouts[nonZero.value];
+			if (!nonZeroLayout && m_cfg.block(nonZero).phis.empty())
+			{
+				// Enter the non-zero target directly with the shared layout.
+				auto const& liveIn = m_liveness.liveIn(nonZero);
+				nonZeroLayout = sharedLayout;
+				for (auto& slot: *nonZeroLayout)
+					if (auto const* value = std::get_if<SSACFG::ValueId>(&slot); value && !liveIn.count(*value))
+						slot = JunkSlot{};
+				m_assembly.appendJumpToIf(blockLabel(nonZero));
+				m_pending.push_back({_block, nonZero, _conditionalJump.debugData, std::nullopt, {}});
+			}
+			else
+			{
+				// The shuffling to the entry layout of the non-zero target is emitted separately.
+				AbstractAssembly::LabelID stub = m_assembly.newLabelId();
+				m_assembly.appendJumpToIf(stub);
+				m_pending.push_back({_block, nonZero, _conditionalJump.debugData, stub, sharedLayout});
+			}
+			m_stack.pop_back();
+
+			return jump(_conditionalJump.debugData, _block, _conditionalJump.zero);
+		},
+		[&](SSACFG::BasicBlock::JumpTable const&) -> std::optional<SSACFG::BlockId>
+		{
+			yulAssert(false, "Jump tables are not supported.");
+		},
+		[&](SSACFG::BasicBlock::FunctionReturn const& _functionReturn) -> std::optional<SSACFG::BlockId>
+		{
+			yulAssert(m_cfg.function && m_cfg.canContinue);
+
+			// The function return layout is fully determined by the function signature.
+			Layout exitStack;
+			for (auto const& returnValue: _functionReturn.returnValues)
+				exitStack.emplace_back(returnValue);
+			exitStack.emplace_back(FunctionReturnLabelSlot{*m_cfg.function});
+
+			createStackLayout(_functionReturn.debugData, exitStack);
+			m_assembly.appendJump(0, AbstractAssembly::JumpType::OutOfFunction);
+			return std::nullopt;
+		},
+		[&](SSACFG::BasicBlock::Terminated const&) -> std::optional<SSACFG::BlockId>
+		{
+			yulAssert(!block.operations.empty());
+			std::visit(util::GenericVisitor{
+				[](SSACFG::BuiltinCall const& _call) { yulAssert(!_call.builtin.get().controlFlowSideEffects.canContinue); },
+				[](SSACFG::Call const& _call) { yulAssert(!_call.canContinue); }
+			}, block.operations.back().kind);
+			return std::nullopt;
+		}
+	}, block.exit);
+}
+
+void SSACFGEVMCodeTransform::operator()(SSACFG::Operation const& _operation, SSACFGLiveness::LivenessData const& _liveOut)
+{
+	auto const* call = std::get_if<SSACFG::Call>(&_operation.kind);
+	bool const pushesReturnLabel = call && call->canContinue;
+	auto const& debugData = std::visit([](auto const& _call) { return _call.debugData; }, _operation.kind);
+
+	// Retain the values that are still needed afterwards and put the inputs on top of them.
+	Layout targetStack = retainLive(m_stack, _liveOut);
+	if (pushesReturnLabel)
+		targetStack.emplace_back(FunctionCallReturnLabelSlot{call->call});
+	for (auto const& input: _operation.inputs)
+		targetStack.emplace_back(input);
+	createStackLayout(debugData, targetStack);
+	size_t const baseHeight = m_stack.size() - _operation.inputs.size() - (pushesReturnLabel ? 1 : 0);
+
+	std::visit(util::GenericVisitor{
+		[&](SSACFG::BuiltinCall const& _call)
+		{
+			m_assembly.setSourceLocation(originLocationOf(_call));
+			static_cast<BuiltinFunctionForEVM const&>(_call.builtin.get()).generateCode(
+				_call.call,
+				m_assembly,
+				m_builtinContext
+			);
+		},
+		[&](SSACFG::Call const& _call)
+		{
+			Scope::Function const& function = _call.function;
+			m_assembly.setSourceLocation(originLocationOf(_call));
+			m_assembly.appendJumpTo(
+				m_functionLabels.at(&function),
+				static_cast<int>(function.numReturns) - static_cast<int>(function.numArguments) - (_call.canContinue ? 1 : 0),
+				AbstractAssembly::JumpType::IntoFunction
+			);
+			if (_call.canContinue)
+				m_assembly.appendLabel(returnLabel(_call.call));
+		}
+	}, _operation.kind);
+
+	m_stack.erase(m_stack.begin() + static_cast<std::ptrdiff_t>(baseHeight), m_stack.end());
+	for (auto const& output: _operation.outputs)
+		m_stack.emplace_back(output);
+	yulAssert(m_assembly.stackHeight() == static_cast<int>(m_stack.size()));
+}
+
+std::optional<SSACFG::BlockId> SSACFGEVMCodeTransform::jump(
+	langutil::DebugData::ConstPtr const& _debugData,
+	SSACFG::BlockId _source,
+	SSACFG::BlockId _target
+)
+{
+	auto& layout = m_blockLayouts[_target.value];
+	if (!layout)
+		layout = entryLayout(_source, _target);
+
+	Layout targetStack;
+	for (auto const& slot: *layout)
+		targetStack.emplace_back(argument(_source, _target, slot));
+	createStackLayout(_debugData, targetStack);
+
+	if (!m_generated[_target.value])
+		return _target;
+	yulAssert(m_blockLabels[_target.value], "Jump to a block without label.");
+	m_assembly.appendJumpTo(*m_blockLabels[_target.value]);
+	return std::nullopt;
+}
+
+SSACFGEVMCodeTransform::Slot SSACFGEVMCodeTransform::argument(
+	SSACFG::BlockId _source,
+	SSACFG::BlockId _target,
+	Slot const& _slot
+) const
+{
+	auto const* value = std::get_if<SSACFG::ValueId>(&_slot);
+	auto const& block = m_cfg.block(_target);
+	if (!value || !block.phis.count(*value))
+		return _slot;
+
+	// The arguments of a phi function are ordered like the entries of its block.
+	auto const& phi = std::get<SSACFG::PhiValue>(m_cfg.valueInfo(*value));
+	auto it = block.entries.find(_source);
+	yulAssert(it != block.entries.end());
+	auto const index = static_cast<size_t>(std::distance(block.entries.begin(), it));
+	yulAssert(index < phi.arguments.size());
+	return phi.arguments[index];
+}
+
+SSACFGEVMCodeTransform::Layout SSACFGEVMCodeTransform::entryLayout(SSACFG::BlockId _source, SSACFG::BlockId _target) const
+{
+	auto const& block = m_cfg.block(_target);
+
+	// The slots required by the target, grouped by the slot they correspond to in the current stack.
+	std::map<Slot, std::deque<Slot>> required;
+	for (auto const& slot: m_stack)
+		if (std::holds_alternative<FunctionReturnLabelSlot>(slot))
+			required[slot].emplace_back(slot);
+	for (auto const& value: m_liveness.liveIn(_target))
+		if (!block.phis.count(value))
+			required[value].emplace_back(value);
+	// The phis of a loop header get new values in each iteration. They are put on top of the values that are
+	// invariant within the loop, so that the back edges only have to shuffle the top of the stack.
+	bool const loopHeader = m_liveness.loopNestingForest().loopNodes().count(_target.value) > 0;
+	Layout loopPhis;
+	for (auto const& phi: block.phis)
+		if (loopHeader)
+			loopPhis.emplace_back(phi);
+		else
+			required[argument(_source, _target, phi)].emplace_back(phi);
+
+	// Assign the required slots to the positions of their counterparts and add those that are not on the stack on top.
+	Layout layout;
+	for (auto const& slot: m_stack)
+		if (auto it = required.find(slot); it != required.end() && !it->second.empty())
+		{
+			layout.emplace_back(it->second.front());
+			it->second.pop_front();
+		}
+		else
+			layout.emplace_back(JunkSlot{});
+	removeJunk(layout);
+	for (auto const& slots: required | ranges::views::values)
+		for (auto const& slot: slots)
+			layout.emplace_back(slot);
+	layout += loopPhis;
+	return layout;
+}
+
+SSACFGEVMCodeTransform::Layout SSACFGEVMCodeTransform::retainLive(Layout _layout, SSACFGLiveness::LivenessData const& _live)
+{
+	std::set<Slot> retained;
+	for (auto& slot: _layout)
+	{
+		bool const live = std::visit(util::GenericVisitor{
+			[&](SSACFG::ValueId const& _value) { return _live.count(_value) > 0; },
+			[](FunctionReturnLabelSlot const&) { return true; },
+			[](auto const&) { return false; }
+		}, slot);
+		if (!live || !retained.insert(slot).second)
+			slot = JunkSlot{};
+	}
+	removeJunk(_layout);
+	return _layout;
+}
+
+void SSACFGEVMCodeTransform::removeJunk(Layout& _layout)
+{
+	for (size_t offset = 0; offset < _layout.size(); ++offset)
+		if (std::holds_alternative<JunkSlot>(_layout[offset]))
+		{
+			while (!_layout.empty() && std::holds_alternative<JunkSlot>(_layout.back()))
+				_layout.pop_back();
+			if (offset < _layout.size())
+			{
+				_layout[offset] = _layout.back();
+				_layout.pop_back();
+			}
+		}
+}
+
+bool SSACFGEVMCodeTransform::canBeFreelyGenerated(Slot const& _slot) const
+{
+	return std::visit(util::GenericVisitor{
+		[&](SSACFG::ValueId const& _value) {
+			auto const& info = m_cfg.valueInfo(_value);
+			return std::holds_alternative<SSACFG::LiteralValue>(info) || std::holds_alternative<SSACFG::UnreachableValue>(info);
+		},
+		[](FunctionReturnLabelSlot const&) { return false; },
+		[](auto const&) { return true; }
+	}, _slot);
+}
+
+std::string SSACFGEVMCodeTransform::slotToString(Slot const& _slot) const
+{
+	return std::visit(util::GenericVisitor{
+		[&](SSACFG::ValueId const& _value) -> std::string {
+			if (auto const* literal = std::get_if<SSACFG::LiteralValue>(&m_cfg.valueInfo(_value)))
+				return toCompactHexWithPrefix(literal->value);
+			return "v" + std::to_string(_value.value);
+		},
+		[](FunctionCallReturnLabelSlot const& _ret) -> std::string { return "RET[" + _ret.call.get().functionName.name.str() + "]"; },
+		[](FunctionReturnLabelSlot const&) -> std::string { return "RET"; },
+		[](JunkSlot const&) -> std::string { return "JUNK"; }
+	}, _slot);
+}
+
+std::string SSACFGEVMCodeTransform::stackToString(Layout const& _layout) const
+{
+	std::string result("[ ");
+	for (auto const& slot: _layout)
+		result += slotToString(slot) + ' ';
+	result += ']';
+	return result;
+}
+
+void SSACFGEVMCodeTransform::createStackLayout(langutil::DebugData::ConstPtr const& _debugData, Layout const& _targetStack)
+{
+	yulAssert(m_assembly.stackHeight() == static_cast<int>(m_stack.size()));
+	YulName const functionName = m_cfg.function ? m_cfg.function->name : YulName{};
+	langutil::SourceLocation sourceLocation = _debugData ? _debugData->originLocation : langutil::SourceLocation{};
+	m_assembly.setSourceLocation(sourceLocation);
+	auto pushJunk = [&]() {
+		// Note: this will always be popped, so we can push anything.
+		if (m_assembly.evmVersion().hasPush0())
+			m_assembly.appendConstant(0);
+		else
+			m_assembly.appendInstruction(evmasm::Instruction::CODESIZE);
+	};
+	::createStackLayout(
+		m_stack,
+		_targetStack,
+		// Swap callback.
+		[&](unsigned _i)
+		{
+			yulAssert(static_cast<int>(m_stack.size()) == m_assembly.stackHeight());
+			yulAssert(_i > 0 && _i < m_stack.size());
+			if (_i <= 16)
+				m_assembly.appendInstruction(evmasm::swapInstruction(_i));
+			else
+			{
+				int deficit = static_cast<int>(_i) - 16;
+				std::string msg =
+					"Cannot swap Slot " + slotToString(m_stack.at(m_stack.size() - _i - 1)) +
+					" with Slot " + slotToString(m_stack.back()) +
+					": too deep in the stack by " + std::to_string(deficit) + " slots in " + stackToString(m_stack);
+				m_stackErrors.emplace_back(StackTooDeepError(
+					functionName,
+					YulName{},
+					deficit,
+					msg
+				) << langutil::errinfo_sourceLocation(sourceLocation));
+				m_assembly.markAsInvalid();
+			}
+		},
+		// Push or dup callback.
+		[&](Slot const& _slot)
+		{
+			yulAssert(static_cast<int>(m_stack.size()) == m_assembly.stackHeight());
+
+			// Dup the slot, if already on stack and reachable.
+			if (auto depth = util::findOffset(m_stack | ranges::views::reverse, _slot))
+			{
+				if (*depth < 16)
+				{
+					m_assembly.appendInstruction(evmasm::dupInstruction(static_cast<unsigned>(*depth + 1)));
+					return;
+				}
+				else if (!canBeFreelyGenerated(_slot))
+				{
+					int deficit = static_cast<int>(*depth - 15);
+					std::string msg =
+						"Slot " + slotToString(_slot) + " is " + std::to_string(deficit) +
+						" too deep in the stack " + stackToString(m_stack);
+					m_stackErrors.emplace_back(StackTooDeepError(
+						functionName,
+						YulName{},
+						deficit,
+						msg
+					) << langutil::errinfo_sourceLocation(sourceLocation));
+					m_assembly.markAsInvalid();
+					m_assembly.appendConstant(u256(0xCAFFEE));
+					return;
+				}
+				// else: the slot is too deep in stack, but can be freely generated, we fall through to push it again.
+			}
+
+			std::visit(util::GenericVisitor{
+				[&](SSACFG::ValueId const& _value)
+				{
+					auto const& info = m_cfg.valueInfo(_value);
+					if (auto const* literal = std::get_if<SSACFG::LiteralValue>(&info))
+					{
+						m_assembly.setSourceLocation(originLocationOf(*literal));
+						m_assembly.appendConstant(literal->value);
+						m_assembly.setSourceLocation(sourceLocation);
+					}
+					else
+					{
+						yulAssert(std::holds_alternative<SSACFG::UnreachableValue>(info), "Value " + slotToString(_slot) + " not found on stack.");
+						pushJunk();
+					}
+				},
+				[&](FunctionCallReturnLabelSlot const& _returnLabel)
+				{
+					m_assembly.setSourceLocation(originLocationOf(_returnLabel.call.get()));
+					m_assembly.appendLabelReference(returnLabel(_returnLabel.call));
+					m_assembly.setSourceLocation(sourceLocation);
+				},
+				[&](FunctionReturnLabelSlot const&)
+				{
+					yulAssert(false, "Cannot produce function return label.");
+				},
+				[&](JunkSlot const&)
+				{
+					pushJunk();
+				}
+			}, _slot);
+		},
+		// Pop callback.
+		[&]()
+		{
+			m_assembly.appendInstruction(evmasm::Instruction::POP);
+		}
+	);
+	yulAssert(m_assembly.stackHeight() == static_cast<int>(m_stack.size()));
+}
+
+AbstractAssembly::LabelID SSACFGEVMCodeTransform::blockLabel(SSACFG::BlockId _block)
+{
+	auto& label = m_blockLabels[_block.value];
+	if (!label)
+		label = m_assembly.newLabelId();
+	return *label;
+}
+
+AbstractAssembly::LabelID SSACFGEVMCodeTransform::returnLabel(FunctionCall const& _call)
+{
+	if (!m_returnLabels.count(&_call))
+		m_returnLabels[&_call] = m_assembly.newLabelId();
+	return m_returnLabels.at(&_call);
+}
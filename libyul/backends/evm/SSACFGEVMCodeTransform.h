@@ -0,0 +1,139 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Experimental code generator translating Yul to EVM based on the SSA control flow graph.
+ */
+
+#pragma once
+
+#include <libyul/backends/evm/ControlFlowGraph.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/OptimizedEVMCodeTransform.h>
+#include <libyul/backends/evm/SSACFGLiveness.h>
+#include <libyul/backends/evm/SSAControlFlowGraph.h>
+#include <libyul/Exceptions.h>
+
+#include <map>
+#include <optional>
+#include <variant>
+#include <vector>
+
+namespace solidity::yul
+{
+struct AsmAnalysisInfo;
+
+/// Code transform that generates EVM code directly from the SSA control flow graph and its liveness
+/// information instead of the stack layouts of the ControlFlowGraph used by OptimizedEVMCodeTransform.
+///
+/// The layout of the stack is derived greedily while generating the code: before each operation only the
+/// values that are live after it are kept (in their current positions as far as possible) and its inputs are
+/// moved to the top. The entry layout of a block is fixed by the first jump to it, all other predecessors
+/// (including back edges of loops) shuffle their stack to it, substituting the phi functions of the block
+/// with their arguments for the respective predecessor. Blocks with a single predecessor are generated
+/// directly after it without a jump.
+class SSACFGEVMCodeTransform
+{
+public:
+	/// A slot on the stack: an SSA value (including literals, which can be pushed at any time), the return label
+	/// of a function call, the return label of the current function, or a slot whose content is irrelevant.
+	using Slot = std::variant<SSACFG::ValueId, FunctionCallReturnLabelSlot, FunctionReturnLabelSlot, JunkSlot>;
+	/// The stack top is the last element of the vector.
+	using Layout = std::vector<Slot>;
+
+	[[nodiscard]] static std::vector<StackTooDeepError> run(
+		AbstractAssembly& _assembly,
+		AsmAnalysisInfo& _analysisInfo,
+		Block const& _block,
+		EVMDialect const& _dialect,
+		BuiltinContext& _builtinContext,
+		OptimizedEVMCodeTransform::UseNamedLabels _useNamedLabelsForFunctions
+	);
+
+private:
+	SSACFGEVMCodeTransform(
+		AbstractAssembly& _assembly,
+		BuiltinContext& _builtinContext,
+		std::map<Scope::Function const*, AbstractAssembly::LabelID> const& _functionLabels,
+		SSACFG const& _cfg,
+		SSACFGLiveness const& _liveness
+	);
+
+	/// A jump target of a conditional jump that still has to be generated.
+	/// If @a stub is set, the conditional jump targets this label instead with the stack layout @a stubLayout
+	/// and the code shuffling from there to the entry layout of @a target still has to be emitted.
+	struct PendingTarget
+	{
+		SSACFG::BlockId source;
+		SSACFG::BlockId target;
+		langutil::DebugData::ConstPtr debugData;
+		std::optional<AbstractAssembly::LabelID> stub;
+		Layout stubLayout;
+	};
+
+	/// Generates the code of the graph, starting with its entry block.
+	void generate();
+	/// Generates the code of the block @a _block, whose entry layout has to be compatible with m_stack.
+	/// @returns the block to be generated directly afterwards, if control flow falls through to it.
+	std::optional<SSACFG::BlockId> operator()(SSACFG::BlockId _block);
+	/// Generates the code for the operation @a _operation, after which the values in @a _liveOut are still needed.
+	void operator()(SSACFG::Operation const& _operation, SSACFGLiveness::LivenessData const& _liveOut);
+	/// Shuffles the stack to the entry layout of @a _target, which is derived from m_stack if not present already,
+	/// and jumps to @a _target if it has already been generated.
+	/// @returns @a _target, if it has not been generated yet and the code generation should continue with it.
+	std::optional<SSACFG::BlockId> jump(
+		langutil::DebugData::ConstPtr const& _debugData,
+		SSACFG::BlockId _source,
+		SSACFG::BlockId _target
+	);
+
+	/// @returns the value the slot @a _slot of the entry layout of @a _target has when coming from @a _source.
+	Slot argument(SSACFG::BlockId _source, SSACFG::BlockId _target, Slot const& _slot) const;
+	/// @returns the entry layout of @a _target, which retains the positions of the corresponding values
+	/// in m_stack when jumping from @a _source as far as possible. The phi functions of loop headers are
+	/// placed on top.
+	Layout entryLayout(SSACFG::BlockId _source, SSACFG::BlockId _target) const;
+	/// @returns @a _layout with all duplicates and all slots that are not live according to @a _live removed.
+	/// The return label of the current function is always retained.
+	static Layout retainLive(Layout _layout, SSACFGLiveness::LivenessData const& _live);
+	/// Removes all junk slots from @a _layout, each of which is replaced by the top most slot above it.
+	static void removeJunk(Layout& _layout);
+	bool canBeFreelyGenerated(Slot const& _slot) const;
+	std::string slotToString(Slot const& _slot) const;
+	std::string stackToString(Layout const& _layout) const;
+
+	/// Shuffles m_stack to the desired @a _targetStack while emitting the shuffling code to m_assembly.
+	void createStackLayout(langutil::DebugData::ConstPtr const& _debugData, Layout const& _targetStack);
+
+	AbstractAssembly::LabelID blockLabel(SSACFG::BlockId _block);
+	AbstractAssembly::LabelID returnLabel(FunctionCall const& _call);
+
+	AbstractAssembly& m_assembly;
+	BuiltinContext& m_builtinContext;
+	std::map<Scope::Function const*, AbstractAssembly::LabelID> const& m_functionLabels;
+	SSACFG const& m_cfg;
+	SSACFGLiveness const& m_liveness;
+	Layout m_stack;
+	std::vector<std::optional<Layout>> m_blockLayouts;
+	std::vector<std::optional<AbstractAssembly::LabelID>> m_blockLabels;
+	std::vector<bool> m_generated;
+	std::vector<PendingTarget> m_pending;
+	std::map<FunctionCall const*, AbstractAssembly::LabelID> m_returnLabels;
+	std::vector<StackTooDeepError> m_stackErrors;
+};
+
+}
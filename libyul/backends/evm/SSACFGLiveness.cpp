@@ -22,6 +22,8 @@
 #include <range/v3/view/filter.hpp>
 #include <range/v3/view/reverse.hpp>
 
+#include <optional>
+
 using namespace solidity::yul;
 
 namespace
@@ -97,6 +99,9 @@ void SSACFGLiveness::runDagDfs()
 		// LiveOut(B) <- live
 		m_liveOuts[blockId.value] = live;
 
+		// the value consumed by the exit of B is used after all of its operations
+		addExitUses(block, live);
+
 		// for each program point p in B, backwards, do:
 		for (auto const& op: block.operations | ranges::views::reverse)
 		{
@@ -111,6 +116,21 @@ void SSACFGLiveness::runDagDfs()
 	}
 }
 
+void SSACFGLiveness::addExitUses(SSACFG::BasicBlock const& _block, std::set<SSACFG::ValueId>& _live) const
+{
+	std::optional<SSACFG::ValueId> use;
+	if (auto const* conditionalJump = std::get_if<SSACFG::BasicBlock::ConditionalJump>(&_block.exit))
+		use = conditionalJump->condition;
+	else if (auto const* jumpTable = std::get_if<SSACFG::BasicBlock::JumpTable>(&_block.exit))
+		use = jumpTable->value;
+	if (
+		use &&
+		literalsFilter(m_cfg)(*use) &&
+		!std::holds_alternative<SSACFG::UnreachableValue>(m_cfg.valueInfo(*use))
+	)
+		_live.insert(*use);
+}
+
 void SSACFGLiveness::runLoopTreeDfs(size_t const _loopHeader)
 {
 	// SSA Book, Algorithm 9.3
@@ -139,12 +159,14 @@ void SSACFGLiveness::fillOperationsLiveOut()
 {
 	for (size_t blockIdValue = 0; blockIdValue < m_cfg.numBlocks(); ++blockIdValue)
 	{
-		auto const& operations = m_cfg.block(SSACFG::BlockId{blockIdValue}).operations;
+		auto const& block = m_cfg.block(SSACFG::BlockId{blockIdValue});
+		auto const& operations = block.operations;
 		auto& liveOuts = m_operationLiveOuts[blockIdValue];
 		liveOuts.resize(operations.size());
 		if (!operations.empty())
 		{
 			auto live = m_liveOuts[blockIdValue];
+			addExitUses(block, live);
 			auto rit = liveOuts.rbegin();
 			for (auto const& op: operations | ranges::views::reverse)
 			{
@@ -42,10 +42,14 @@ public:
 	LivenessData const& liveOut(SSACFG::BlockId _blockId) const { return m_liveOuts[_blockId.value]; }
 	std::vector<LivenessData> const& operationsLiveOut(SSACFG::BlockId _blockId) const { return m_operationLiveOuts[_blockId.value]; }
 	ForwardSSACFGTopologicalSort const& topologicalSort() const { return m_topologicalSort; }
+	SSACFGLoopNestingForest const& loopNestingForest() const { return m_loopNestingForest; }
 private:
 
 	void runDagDfs();
 	void runLoopTreeDfs(size_t _loopHeader);
+	/// Adds the value consumed by the exit of @a _block (the condition of a conditional jump or the value
+	/// of a jump table) to @a _live.
+	void addExitUses(SSACFG::BasicBlock const& _block, LivenessData& _live) const;
 	void fillOperationsLiveOut();
 
 	SSACFG const& m_cfg;
@@ -0,0 +1,116 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/backends/evm/SSACFGValueNumbering.h>
+
+#include <libyul/backends/evm/SSACFGTopologicalSort.h>
+#include <libyul/Dialect.h>
+
+#include <libsolutil/Visitor.h>
+
+#include <range/v3/view/reverse.hpp>
+
+#include <algorithm>
+#include <optional>
+
+using namespace solidity;
+using namespace solidity::yul;
+
+SSACFGValueNumbering::SSACFGValueNumbering(SSACFG const& _cfg, std::map<YulName, SideEffects> const& _functionSideEffects):
+	m_cfg(_cfg),
+	m_functionSideEffects(_functionSideEffects)
+{
+	m_valueNumbers.reserve(m_cfg.numValues());
+	for (size_t valueIdValue = 0; valueIdValue < m_cfg.numValues(); ++valueIdValue)
+		m_valueNumbers.emplace_back(SSACFG::ValueId{valueIdValue});
+
+	ForwardSSACFGTopologicalSort const topologicalSort(m_cfg);
+	for (size_t const blockIdValue: topologicalSort.postOrder() | ranges::views::reverse)
+	{
+		SSACFG::BlockId const blockId{blockIdValue};
+		auto const& block = m_cfg.block(blockId);
+		for (auto const& phi: block.phis)
+			visitPhi(blockId, phi);
+		for (auto const& operation: block.operations)
+			visitOperation(operation);
+	}
+}
+
+void SSACFGValueNumbering::visitPhi(SSACFG::BlockId _block, SSACFG::ValueId _phi)
+{
+	auto const& phiInfo = std::get<SSACFG::PhiValue>(m_cfg.valueInfo(_phi));
+	std::vector<SSACFG::ValueId> arguments;
+	arguments.reserve(phiInfo.arguments.size());
+	std::optional<SSACFG::ValueId> same;
+	bool trivial = true;
+	for (auto const& argument: phiInfo.arguments)
+	{
+		SSACFG::ValueId const valueNumber = m_valueNumbers[argument.value];
+		arguments.emplace_back(valueNumber);
+		if (valueNumber == _phi)
+			continue;
+		if (!same)
+			same = valueNumber;
+		else if (*same != valueNumber)
+			trivial = false;
+	}
+	if (trivial && same)
+	{
+		m_valueNumbers[_phi.value] = *same;
+		return;
+	}
+	m_valueNumbers[_phi.value] = m_computations.emplace(Computation{{}, _block, std::move(arguments)}, _phi).first->second;
+}
+
+void SSACFGValueNumbering::visitOperation(SSACFG::Operation const& _operation)
+{
+	if (_operation.outputs.size() != 1)
+		return;
+
+	std::string const function = std::visit(util::GenericVisitor{
+		[](SSACFG::BuiltinCall const& _call) -> std::string {
+			BuiltinFunction const& builtin = _call.builtin.get();
+			bool const hasLiteralArguments = std::any_of(
+				builtin.literalArguments.begin(),
+				builtin.literalArguments.end(),
+				[](std::optional<LiteralKind> const& _literalKind) { return _literalKind.has_value(); }
+			);
+			if (!builtin.sideEffects.movable || hasLiteralArguments)
+				return {};
+			return builtin.name;
+		},
+		[&](SSACFG::Call const& _call) -> std::string {
+			auto it = m_functionSideEffects.find(_call.function.get().name);
+			if (it == m_functionSideEffects.end() || !it->second.movable)
+				return {};
+			return _call.function.get().name.str();
+		}
+	}, _operation.kind);
+	if (function.empty())
+		return;
+
+	std::vector<SSACFG::ValueId> inputs;
+	inputs.reserve(_operation.inputs.size());
+	for (auto const& input: _operation.inputs)
+		inputs.emplace_back(m_valueNumbers[input.value]);
+	SSACFG::ValueId const output = _operation.outputs.front();
+	m_valueNumbers[output.value] = m_computations.emplace(
+		Computation{function, SSACFG::BlockId{}, std::move(inputs)},
+		output
+	).first->second;
+}
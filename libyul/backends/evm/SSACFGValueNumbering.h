@@ -0,0 +1,65 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <libyul/backends/evm/SSAControlFlowGraph.h>
+#include <libyul/SideEffects.h>
+#include <libyul/YulName.h>
+
+#include <map>
+#include <vector>
+
+namespace solidity::yul
+{
+
+/// Global value numbering on an SSA CFG.
+///
+/// Visits the blocks of the graph in reverse post-order and assigns the same value number to all values
+/// computed by the same movable function (without literal arguments) from inputs with the same value
+/// numbers, and to phi functions of the same block whose arguments have the same value numbers.
+/// A phi function whose arguments all have the same value number (apart from references to itself)
+/// gets that value number as well.
+///
+/// Since values flowing along back edges are only numbered after they are used, congruences that
+/// only hold inductively in loops are not detected (pessimistic value numbering).
+class SSACFGValueNumbering
+{
+public:
+	/// @param _functionSideEffects side effects of the user-defined functions, keyed by their name.
+	SSACFGValueNumbering(SSACFG const& _cfg, std::map<YulName, SideEffects> const& _functionSideEffects);
+
+	/// @returns the value number of @a _value, which is the first value (in reverse post-order) known to be
+	/// equal to @a _value whenever both are defined.
+	SSACFG::ValueId valueNumber(SSACFG::ValueId _value) const { return m_valueNumbers[_value.value]; }
+
+private:
+	/// The computation of a value: the name of the called function (empty for phi functions), the defining
+	/// block for phi functions and the value numbers of the inputs.
+	using Computation = std::tuple<std::string, SSACFG::BlockId, std::vector<SSACFG::ValueId>>;
+
+	void visitPhi(SSACFG::BlockId _block, SSACFG::ValueId _phi);
+	void visitOperation(SSACFG::Operation const& _operation);
+
+	SSACFG const& m_cfg;
+	std::map<YulName, SideEffects> const& m_functionSideEffects;
+	std::vector<SSACFG::ValueId> m_valueNumbers;
+	std::map<Computation, SSACFG::ValueId> m_computations;
+};
+
+}
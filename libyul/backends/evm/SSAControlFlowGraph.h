@@ -170,6 +170,7 @@ public:
 	{
 		return m_valueInfos.at(_var.value);
 	}
+	size_t numValues() const { return m_valueInfos.size(); }
 	ValueId newPhi(BlockId const _definingBlock)
 	{
 		ValueId id { m_valueInfos.size() };
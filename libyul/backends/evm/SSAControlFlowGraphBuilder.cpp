@@ -28,7 +28,6 @@
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/StringUtils.h>
 #include <libsolutil/Visitor.h>
-#include <libsolutil/cxx20.h>
 
 #include <range/v3/range/conversion.hpp>
 #include <range/v3/view/drop_last.hpp>
@@ -178,32 +177,38 @@ void SSAControlFlowGraphBuilder::cleanUnreachable()
 			}, block.exit);
 	});
 
-	auto isUnreachableValue = [&](SSACFG::ValueId const& _value) -> bool {
-		auto* valueInfo = std::get_if<SSACFG::UnreachableValue>(&m_graph.valueInfo(_value));
-		return (valueInfo) ? true : false;
-	};
-
 	// Remove all entries from unreachable nodes from the graph.
 	for (SSACFG::BlockId blockId: reachabilityCheck.visited)
 	{
 		auto& block = m_graph.block(blockId);
 
-		std::set<SSACFG::ValueId> maybeTrivialPhi;
+		// The arguments of the phis are ordered like the entries of the block, so the argument corresponding
+		// to a removed entry has to be removed as well, regardless of its value.
+		std::vector<bool> removedEntries;
 		for (auto it = block.entries.begin(); it != block.entries.end();)
-			if (reachabilityCheck.visited.count(*it))
-				it++;
-			else
+		{
+			removedEntries.push_back(!reachabilityCheck.visited.count(*it));
+			if (removedEntries.back())
 				it = block.entries.erase(it);
+			else
+				it++;
+		}
+
+		std::set<SSACFG::ValueId> maybeTrivialPhi;
 		for (auto phi: block.phis)
 			if (auto* phiInfo = std::get_if<SSACFG::PhiValue>(&m_graph.valueInfo(phi)))
-				cxx20::erase_if(phiInfo->arguments, [&](SSACFG::ValueId _arg) {
-					if (isUnreachableValue(_arg))
-					{
-						maybeTrivialPhi.insert(phi);
-						return true;
-					}
-					return false;
-				});
+			{
+				yulAssert(phiInfo->arguments.size() == removedEntries.size());
+				std::vector<SSACFG::ValueId> arguments;
+				for (size_t index = 0; index < removedEntries.size(); ++index)
+					if (!removedEntries[index])
+						arguments.push_back(phiInfo->arguments[index]);
+				if (arguments.size() != phiInfo->arguments.size())
+				{
+					phiInfo->arguments = std::move(arguments);
+					maybeTrivialPhi.insert(phi);
+				}
+			}
 
 		// After removing a phi argument, we might end up with a trivial phi that can be removed.
 		for (auto phi: maybeTrivialPhi)
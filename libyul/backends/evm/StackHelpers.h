@@ -422,27 +422,40 @@ private:
 	int m_junkSlotMultiplicity = 0;
 };
 
+/// The map used by createStackLayout to count the occurrences of the slots of a stack of type @a StackType.
+template<typename StackType>
+struct StackSlotMultiplicity
+{
+	using type = std::map<typename StackType::value_type, int>;
+};
+template<>
+struct StackSlotMultiplicity<Stack>
+{
+	using type = Multiplicity;
+};
+
 /// Transforms @a _currentStack to @a _targetStack, invoking the provided shuffling operations.
 /// Modifies @a _currentStack itself after each invocation of the shuffling operations.
+/// @a StackType is a vector of a variant of slots, one alternative of which is JunkSlot, e.g. Stack.
 /// @a _swap is a function with signature void(unsigned) that is called when the top most slot is swapped with
 /// the slot `depth` slots below the top. In terms of EVM opcodes this is supposed to be a `SWAP<depth>`.
-/// @a _pushOrDup is a function with signature void(StackSlot const&) that is called to push or dup the slot given as
-/// its argument to the stack top.
+/// @a _pushOrDup is a function with signature void(StackType::value_type const&) that is called to push or dup the slot
+/// given as its argument to the stack top.
 /// @a _pop is a function with signature void() that is called when the top most slot is popped.
-template<typename Swap, typename PushOrDup, typename Pop>
-void createStackLayout(Stack& _currentStack, Stack const& _targetStack, Swap _swap, PushOrDup _pushOrDup, Pop _pop)
+template<typename StackType, typename Swap, typename PushOrDup, typename Pop>
+void createStackLayout(StackType& _currentStack, StackType const& _targetStack, Swap _swap, PushOrDup _pushOrDup, Pop _pop)
 {
 	struct ShuffleOperations
 	{
-		Stack& currentStack;
-		Stack const& targetStack;
+		StackType& currentStack;
+		StackType const& targetStack;
 		Swap swapCallback;
 		PushOrDup pushOrDupCallback;
 		Pop popCallback;
-		Multiplicity multiplicity;
+		typename StackSlotMultiplicity<StackType>::type multiplicity;
 		ShuffleOperations(
-			Stack& _currentStack,
-			Stack const& _targetStack,
+			StackType& _currentStack,
+			StackType const& _targetStack,
 			Swap _swap,
 			PushOrDup _pushOrDup,
 			Pop _pop
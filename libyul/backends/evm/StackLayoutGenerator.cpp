@@ -27,6 +27,7 @@
 
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/cxx20.h>
+#include <libsolutil/Profiler.h>
 #include <libsolutil/Visitor.h>
 
 #include <range/v3/algorithm/any_of.hpp>
@@ -49,6 +50,7 @@ using namespace solidity::yul;
 
 StackLayout StackLayoutGenerator::run(CFG const& _cfg)
 {
+	PROFILER_PROBE("StackLayoutGenerator", probe);
 	StackLayout stackLayout;
 	StackLayoutGenerator{stackLayout, nullptr}.processEntryPoint(*_cfg.entry);
 
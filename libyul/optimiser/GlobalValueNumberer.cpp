@@ -0,0 +1,116 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#include <libyul/optimiser/GlobalValueNumberer.h>
+
+#include <libyul/backends/evm/ControlFlow.h>
+#include <libyul/backends/evm/SSACFGValueNumbering.h>
+#include <libyul/backends/evm/SSAControlFlowGraphBuilder.h>
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/AsmAnalysis.h>
+#include <libyul/AsmAnalysisInfo.h>
+#include <libyul/AST.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <optional>
+
+using namespace solidity;
+using namespace solidity::yul;
+
+void GlobalValueNumberer::run(OptimiserStepContext& _context, Block& _ast)
+{
+	std::map<FunctionCall const*, ValueNumber> valueNumbers;
+	{
+		AsmAnalysisInfo const analysisInfo = AsmAnalyzer::analyzeStrictAssertCorrect(
+			_context.dialect,
+			_ast,
+			referencedDataNames(_ast)
+		);
+		std::unique_ptr<ControlFlow> const controlFlow = SSAControlFlowGraphBuilder::build(analysisInfo, _context.dialect, _ast);
+		std::map<YulName, SideEffects> const functionSideEffects = SideEffectsPropagator::sideEffects(
+			_context.dialect,
+			CallGraphGenerator::callGraph(_ast)
+		);
+
+		auto number = [&](SSACFG const& _cfg) {
+			SSACFGValueNumbering const numbering(_cfg, functionSideEffects);
+			for (size_t blockIdValue = 0; blockIdValue < _cfg.numBlocks(); ++blockIdValue)
+				for (auto const& operation: _cfg.block(SSACFG::BlockId{blockIdValue}).operations)
+					if (operation.outputs.size() == 1)
+					{
+						FunctionCall const& call = std::visit(
+							[](auto const& _kind) -> FunctionCall const& { return _kind.call.get(); },
+							operation.kind
+						);
+						valueNumbers[&call] = {&_cfg, numbering.valueNumber(operation.outputs.front())};
+					}
+		};
+		number(*controlFlow->mainGraph);
+		for (auto const& functionGraph: controlFlow->functionGraphs)
+			number(*functionGraph);
+	}
+
+	GlobalValueNumberer{std::move(valueNumbers), assignedVariableNames(_ast)}(_ast);
+}
+
+void GlobalValueNumberer::operator()(VariableDeclaration& _varDecl)
+{
+	std::optional<ValueNumber> valueNumber;
+	if (_varDecl.variables.size() == 1 && _varDecl.value && !m_assignedVariables.count(_varDecl.variables.front().name))
+		if (FunctionCall const* functionCall = std::get_if<FunctionCall>(_varDecl.value.get()))
+			if (ValueNumber const* number = util::valueOrNullptr(m_valueNumbers, functionCall))
+				valueNumber = *number;
+
+	ASTModifier::operator()(_varDecl);
+
+	// The variable does not provide a new value, if its value was replaced by a reference to another variable.
+	if (valueNumber && std::holds_alternative<FunctionCall>(*_varDecl.value))
+		if (m_availableValues.emplace(*valueNumber, _varDecl.variables.front().name).second)
+			m_addedValues.emplace_back(*valueNumber);
+}
+
+void GlobalValueNumberer::operator()(FunctionDefinition& _functionDefinition)
+{
+	ScopedSaveAndRestore availableValues(m_availableValues, {});
+	ScopedSaveAndRestore addedValues(m_addedValues, {});
+	ASTModifier::operator()(_functionDefinition);
+}
+
+void GlobalValueNumberer::operator()(Block& _block)
+{
+	size_t const numAddedValues = m_addedValues.size();
+	ASTModifier::operator()(_block);
+	for (; m_addedValues.size() > numAddedValues; m_addedValues.pop_back())
+		m_availableValues.erase(m_addedValues.back());
+}
+
+void GlobalValueNumberer::visit(Expression& _expression)
+{
+	if (FunctionCall const* functionCall = std::get_if<FunctionCall>(&_expression))
+		if (ValueNumber const* valueNumber = util::valueOrNullptr(m_valueNumbers, functionCall))
+			if (YulName const* variable = util::valueOrNullptr(m_availableValues, *valueNumber))
+			{
+				_expression = Identifier{debugDataOf(_expression), *variable};
+				return;
+			}
+	ASTModifier::visit(_expression);
+}
@@ -0,0 +1,81 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#pragma once
+
+#include <libyul/backends/evm/SSAControlFlowGraph.h>
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/YulName.h>
+
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace solidity::yul
+{
+
+/**
+ * Optimisation stage that performs global value numbering on the SSA control flow graphs of the
+ * whole code in a single pass.
+ *
+ * Replaces calls of movable functions by a reference to a variable that is in scope, is never
+ * re-assigned and was declared with a call that computes the same value. Other than the
+ * CommonSubexpressionEliminator, this does not depend on the syntactic equality of the two calls,
+ * but on the equality of the values of their arguments, and it is not affected by assignments to
+ * unrelated variables or control flow joins in between.
+ *
+ * Works best if the code is in SSA form (after the ExpressionSplitter and the SSATransform).
+ *
+ * Prerequisite: Disambiguator.
+ */
+class GlobalValueNumberer: public ASTModifier
+{
+public:
+	static constexpr char const* name{"GlobalValueNumberer"};
+	static void run(OptimiserStepContext&, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(VariableDeclaration& _varDecl) override;
+	void operator()(FunctionDefinition& _functionDefinition) override;
+	void operator()(Block& _block) override;
+	void visit(Expression& _expression) override;
+
+private:
+	/// The value number of a value of the given graph.
+	using ValueNumber = std::pair<SSACFG const*, SSACFG::ValueId>;
+
+	GlobalValueNumberer(
+		std::map<FunctionCall const*, ValueNumber> _valueNumbers,
+		std::set<YulName> _assignedVariables
+	):
+		m_valueNumbers(std::move(_valueNumbers)),
+		m_assignedVariables(std::move(_assignedVariables))
+	{}
+
+	/// Value numbers of all calls with a single return value. Calls of functions that are not movable have a
+	/// value number of their own.
+	std::map<FunctionCall const*, ValueNumber> m_valueNumbers;
+	std::set<YulName> m_assignedVariables;
+	/// Variables in scope holding the value with the respective value number.
+	std::map<ValueNumber, YulName> m_availableValues;
+	/// Value numbers in m_availableValues in the order they were added, to remove them at the end of their scope.
+	std::vector<ValueNumber> m_addedValues;
+};
+
+}
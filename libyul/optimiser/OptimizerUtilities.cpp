@@ -25,6 +25,7 @@
 
 #include <libyul/Dialect.h>
 #include <libyul/AST.h>
+#include <libyul/Utilities.h>
 
 #include <liblangutil/Token.h>
 #include <libsolutil/CommonData.h>
@@ -75,6 +76,18 @@ langutil::EVMVersion const yul::evmVersionFromDialect(Dialect const& _dialect)
 	return langutil::EVMVersion();
 }
 
+std::set<std::string> yul::referencedDataNames(Block const& _ast)
+{
+	std::set<std::string> dataNames;
+	forEach<FunctionCall const>(_ast, [&](FunctionCall const& _functionCall) {
+		std::string const& functionName = _functionCall.functionName.name.str();
+		if ((functionName == "datasize" || functionName == "dataoffset") && !_functionCall.arguments.empty())
+			if (Literal const* literal = std::get_if<Literal>(&_functionCall.arguments.front()))
+				dataNames.insert(formatLiteral(*literal));
+	});
+	return dataNames;
+}
+
 void StatementRemover::operator()(Block& _block)
 {
 	util::iterateReplacing(
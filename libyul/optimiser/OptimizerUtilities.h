@@ -29,6 +29,8 @@
 #include <liblangutil/EVMVersion.h>
 
 #include <optional>
+#include <set>
+#include <string>
 
 namespace solidity::evmasm
 {
@@ -54,6 +56,10 @@ std::optional<evmasm::Instruction> toEVMInstruction(Dialect const& _dialect, Yul
 /// It returns the default EVM version if dialect is not an EVMDialect.
 langutil::EVMVersion const evmVersionFromDialect(Dialect const& _dialect);
 
+/// @returns the names of all data objects referenced via ``datasize`` or ``dataoffset`` in @a _ast.
+/// Allows analysing the code of an object during optimisation, when the object itself is not available.
+std::set<std::string> referencedDataNames(Block const& _ast);
+
 class StatementRemover: public ASTModifier
 {
 public:
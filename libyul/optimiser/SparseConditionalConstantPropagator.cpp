@@ -0,0 +1,109 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#include <libyul/optimiser/SparseConditionalConstantPropagator.h>
+
+#include <libyul/backends/evm/ControlFlow.h>
+#include <libyul/backends/evm/SSACFGConstantPropagation.h>
+#include <libyul/backends/evm/SSAControlFlowGraphBuilder.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/AsmAnalysis.h>
+#include <libyul/AsmAnalysisInfo.h>
+#include <libyul/AST.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+
+using namespace solidity;
+using namespace solidity::yul;
+
+void SparseConditionalConstantPropagator::run(OptimiserStepContext& _context, Block& _ast)
+{
+	std::map<FunctionCall const*, u256> constantCalls;
+	std::map<FunctionCall const*, std::map<size_t, u256>> constantArguments;
+	{
+		AsmAnalysisInfo const analysisInfo = AsmAnalyzer::analyzeStrictAssertCorrect(
+			_context.dialect,
+			_ast,
+			referencedDataNames(_ast)
+		);
+		std::unique_ptr<ControlFlow> const controlFlow = SSAControlFlowGraphBuilder::build(analysisInfo, _context.dialect, _ast);
+
+		auto propagate = [&](SSACFG const& _cfg) {
+			SSACFGConstantPropagation const propagation(_context.dialect, _cfg);
+			for (size_t blockIdValue = 0; blockIdValue < _cfg.numBlocks(); ++blockIdValue)
+			{
+				SSACFG::BlockId const blockId{blockIdValue};
+				if (!propagation.executable(blockId))
+					continue;
+				for (auto const& operation: _cfg.block(blockId).operations)
+				{
+					FunctionCall const& call = std::visit(
+						[](auto const& _kind) -> FunctionCall const& { return _kind.call.get(); },
+						operation.kind
+					);
+					// Only movable builtins are evaluated, so the call can be removed if its value is constant.
+					if (operation.outputs.size() == 1)
+						if (std::optional<u256> const value = propagation.constant(operation.outputs.front()))
+							constantCalls[&call] = *value;
+
+					// The inputs of the operation are the arguments that are not required to be literals in reverse order.
+					auto const* builtinCall = std::get_if<SSACFG::BuiltinCall>(&operation.kind);
+					std::vector<size_t> argumentIndices;
+					for (size_t index = call.arguments.size(); index > 0; --index)
+						if (!builtinCall || !builtinCall->builtin.get().literalArgument(index - 1))
+							argumentIndices.emplace_back(index - 1);
+					// This does not hold for the artificial comparisons generated for switch statements.
+					if (argumentIndices.size() != operation.inputs.size())
+						continue;
+					for (size_t input = 0; input < operation.inputs.size(); ++input)
+						if (std::holds_alternative<Identifier>(call.arguments[argumentIndices[input]]))
+							if (std::optional<u256> const value = propagation.constant(operation.inputs[input]))
+								constantArguments[&call][argumentIndices[input]] = *value;
+				}
+			}
+		};
+		propagate(*controlFlow->mainGraph);
+		for (auto const& functionGraph: controlFlow->functionGraphs)
+			propagate(*functionGraph);
+	}
+
+	SparseConditionalConstantPropagator{std::move(constantCalls), std::move(constantArguments)}(_ast);
+}
+
+void SparseConditionalConstantPropagator::operator()(FunctionCall& _functionCall)
+{
+	if (auto const* arguments = util::valueOrNullptr(m_constantArguments, &_functionCall))
+		for (auto const& [index, value]: *arguments)
+		{
+			Expression& argument = _functionCall.arguments[index];
+			yulAssert(std::holds_alternative<Identifier>(argument));
+			argument = Literal{debugDataOf(argument), LiteralKind::Number, LiteralValue{value, formatNumber(value)}};
+		}
+	ASTModifier::operator()(_functionCall);
+}
+
+void SparseConditionalConstantPropagator::visit(Expression& _expression)
+{
+	if (FunctionCall const* functionCall = std::get_if<FunctionCall>(&_expression))
+		if (u256 const* value = util::valueOrNullptr(m_constantCalls, functionCall))
+		{
+			_expression = Literal{debugDataOf(_expression), LiteralKind::Number, LiteralValue{*value, formatNumber(*value)}};
+			return;
+		}
+	ASTModifier::visit(_expression);
+}
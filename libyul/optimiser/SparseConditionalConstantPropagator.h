@@ -0,0 +1,69 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libsolutil/Numeric.h>
+
+#include <map>
+
+namespace solidity::yul
+{
+
+/**
+ * Optimisation stage that performs sparse conditional constant propagation on the SSA control
+ * flow graphs of the whole code in a single pass.
+ *
+ * Replaces calls of movable builtins whose value is the same constant on all executable paths by that
+ * constant and does the same for variables used as arguments of function calls.
+ * Since only control flow edges that can actually be taken are considered, this also finds constants
+ * that depend on conditions that are always true or false (e.g. inside loops), which the
+ * DataFlowAnalyzer-based steps cannot resolve.
+ *
+ * The StructuralSimplifier and the Rematerialiser should be run afterwards to remove the branches
+ * whose conditions became constant.
+ *
+ * Prerequisite: Disambiguator.
+ */
+class SparseConditionalConstantPropagator: public ASTModifier
+{
+public:
+	static constexpr char const* name{"SparseConditionalConstantPropagator"};
+	static void run(OptimiserStepContext&, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(FunctionCall& _functionCall) override;
+	void visit(Expression& _expression) override;
+
+private:
+	SparseConditionalConstantPropagator(
+		std::map<FunctionCall const*, u256> _constantCalls,
+		std::map<FunctionCall const*, std::map<size_t, u256>> _constantArguments
+	):
+		m_constantCalls(std::move(_constantCalls)),
+		m_constantArguments(std::move(_constantArguments))
+	{}
+
+	/// Calls that can be replaced by a constant.
+	std::map<FunctionCall const*, u256> m_constantCalls;
+	/// Variables used as arguments of calls (by index of the argument) that can be replaced by a constant.
+	std::map<FunctionCall const*, std::map<size_t, u256>> m_constantArguments;
+};
+
+}
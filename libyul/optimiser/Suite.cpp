@@ -43,6 +43,7 @@
 #include <libyul/optimiser/ForLoopInitRewriter.h>
 #include <libyul/optimiser/ForLoopConditionIntoBody.h>
 #include <libyul/optimiser/FunctionSpecializer.h>
+#include <libyul/optimiser/GlobalValueNumberer.h>
 #include <libyul/optimiser/Rematerialiser.h>
 #include <libyul/optimiser/UnusedFunctionParameterPruner.h>
 #include <libyul/optimiser/UnusedPruner.h>
@@ -51,6 +52,7 @@
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/SSAReverser.h>
 #include <libyul/optimiser/SSATransform.h>
+#include <libyul/optimiser/SparseConditionalConstantPropagator.h>
 #include <libyul/optimiser/StackCompressor.h>
 #include <libyul/optimiser/StackLimitEvader.h>
 #include <libyul/optimiser/StructuralSimplifier.h>
@@ -223,42 +225,43 @@ std::map<std::string, std::unique_ptr<OptimiserStep>> optimiserStepCollection()
 
 std::map<std::string, std::unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 {
-	static std::map<std::string, std::unique_ptr<OptimiserStep>> instance;
-	if (instance.empty())
-		instance = optimiserStepCollection<
-			BlockFlattener,
-			CircularReferencesPruner,
-			CommonSubexpressionEliminator,
-			ConditionalSimplifier,
-			ConditionalUnsimplifier,
-			ControlFlowSimplifier,
-			DeadCodeEliminator,
-			EqualStoreEliminator,
-			EquivalentFunctionCombiner,
-			ExpressionInliner,
-			ExpressionJoiner,
-			ExpressionSimplifier,
-			ExpressionSplitter,
-			ForLoopConditionIntoBody,
-			ForLoopConditionOutOfBody,
-			ForLoopInitRewriter,
-			FullInliner,
-			FunctionGrouper,
-			FunctionHoister,
-			FunctionSpecializer,
-			LiteralRematerialiser,
-			LoadResolver,
-			LoopInvariantCodeMotion,
-			UnusedAssignEliminator,
-			UnusedStoreEliminator,
-			Rematerialiser,
-			SSAReverser,
-			SSATransform,
-			StructuralSimplifier,
-			UnusedFunctionParameterPruner,
-			UnusedPruner,
-			VarDeclInitializer
-		>();
+	// Initialized only once and in a thread-safe manner, since it may be accessed concurrently.
+	static std::map<std::string, std::unique_ptr<OptimiserStep>> const instance = optimiserStepCollection<
+		BlockFlattener,
+		CircularReferencesPruner,
+		CommonSubexpressionEliminator,
+		ConditionalSimplifier,
+		ConditionalUnsimplifier,
+		ControlFlowSimplifier,
+		DeadCodeEliminator,
+		EqualStoreEliminator,
+		EquivalentFunctionCombiner,
+		ExpressionInliner,
+		ExpressionJoiner,
+		ExpressionSimplifier,
+		ExpressionSplitter,
+		ForLoopConditionIntoBody,
+		ForLoopConditionOutOfBody,
+		ForLoopInitRewriter,
+		FullInliner,
+		FunctionGrouper,
+		FunctionHoister,
+		FunctionSpecializer,
+		GlobalValueNumberer,
+		LiteralRematerialiser,
+		LoadResolver,
+		LoopInvariantCodeMotion,
+		UnusedAssignEliminator,
+		UnusedStoreEliminator,
+		Rematerialiser,
+		SSAReverser,
+		SSATransform,
+		SparseConditionalConstantPropagator,
+		StructuralSimplifier,
+		UnusedFunctionParameterPruner,
+		UnusedPruner,
+		VarDeclInitializer
+	>();
 	// Does not include VarNameCleaner because it destroys the property of unique names.
 	// Does not include NameSimplifier.
 	return instance;
@@ -267,38 +270,40 @@ std::map<std::string, std::unique_ptr<OptimiserStep>> const& OptimiserSuite::all
 std::map<std::string, char> const& OptimiserSuite::stepNameToAbbreviationMap()
 {
 	static std::map<std::string, char> lookupTable{
-		{BlockFlattener::name,                'f'},
-		{CircularReferencesPruner::name,      'l'},
-		{CommonSubexpressionEliminator::name, 'c'},
-		{ConditionalSimplifier::name,         'C'},
-		{ConditionalUnsimplifier::name,       'U'},
-		{ControlFlowSimplifier::name,         'n'},
-		{DeadCodeEliminator::name,            'D'},
-		{EqualStoreEliminator::name,          'E'},
-		{EquivalentFunctionCombiner::name,    'v'},
-		{ExpressionInliner::name,             'e'},
-		{ExpressionJoiner::name,              'j'},
-		{ExpressionSimplifier::name,          's'},
-		{ExpressionSplitter::name,            'x'},
-		{ForLoopConditionIntoBody::name,      'I'},
-		{ForLoopConditionOutOfBody::name,     'O'},
-		{ForLoopInitRewriter::name,           'o'},
-		{FullInliner::name,                   'i'},
-		{FunctionGrouper::name,               'g'},
-		{FunctionHoister::name,               'h'},
-		{FunctionSpecializer::name,           'F'},
-		{LiteralRematerialiser::name,         'T'},
-		{LoadResolver::name,                  'L'},
-		{LoopInvariantCodeMotion::name,       'M'},
-		{UnusedAssignEliminator::name,        'r'},
-		{UnusedStoreEliminator::name,         'S'},
-		{Rematerialiser::name,                'm'},
-		{SSAReverser::name,                   'V'},
-		{SSATransform::name,                  'a'},
-		{StructuralSimplifier::name,          't'},
-		{UnusedFunctionParameterPruner::name, 'p'},
-		{UnusedPruner::name,                  'u'},
-		{VarDeclInitializer::name,            'd'},
+		{BlockFlattener::name,                      'f'},
+		{CircularReferencesPruner::name,            'l'},
+		{CommonSubexpressionEliminator::name,       'c'},
+		{ConditionalSimplifier::name,               'C'},
+		{ConditionalUnsimplifier::name,             'U'},
+		{ControlFlowSimplifier::name,               'n'},
+		{DeadCodeEliminator::name,                  'D'},
+		{EqualStoreEliminator::name,                'E'},
+		{EquivalentFunctionCombiner::name,          'v'},
+		{ExpressionInliner::name,                   'e'},
+		{ExpressionJoiner::name,                    'j'},
+		{ExpressionSimplifier::name,                's'},
+		{ExpressionSplitter::name,                  'x'},
+		{ForLoopConditionIntoBody::name,            'I'},
+		{ForLoopConditionOutOfBody::name,           'O'},
+		{ForLoopInitRewriter::name,                 'o'},
+		{FullInliner::name,                         'i'},
+		{FunctionGrouper::name,                     'g'},
+		{FunctionHoister::name,                     'h'},
+		{FunctionSpecializer::name,                 'F'},
+		{GlobalValueNumberer::name,                 'N'},
+		{LiteralRematerialiser::name,               'T'},
+		{LoadResolver::name,                        'L'},
+		{LoopInvariantCodeMotion::name,             'M'},
+		{UnusedAssignEliminator::name,              'r'},
+		{UnusedStoreEliminator::name,               'S'},
+		{Rematerialiser::name,                      'm'},
+		{SSAReverser::name,                         'V'},
+		{SSATransform::name,                        'a'},
+		{SparseConditionalConstantPropagator::name, 'P'},
+		{StructuralSimplifier::name,                't'},
+		{UnusedFunctionParameterPruner::name,       'p'},
+		{UnusedPruner::name,                        'u'},
+		{VarDeclInitializer::name,                  'd'},
 	};
 	yulAssert(lookupTable.size() == allSteps().size(), "");
 	yulAssert((
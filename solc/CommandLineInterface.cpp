@@ -41,7 +41,9 @@
 #include <libsolidity/lsp/LanguageServer.h>
 #include <libsolidity/lsp/Transport.h>
 
+#include <libyul/ObjectOptimizer.h>
 #include <libyul/YulStack.h>
+#include <libyul/YulString.h>
 
 #include <libevmasm/Disassemble.h>
 
@@ -58,6 +60,7 @@
 #include <algorithm>
 #include <fstream>
 #include <memory>
+#include <optional>
 
 #include <range/v3/view/map.hpp>
 
@@ -92,6 +95,9 @@ std::set<frontend::InputMode> const CompilerInputModes{
 	frontend::InputMode::CompilerWithASTImport,
 };
 
+/// Number of optimized Yul objects after which the cache of the standard JSON server is cleared.
+size_t constexpr maxCachedObjectsInServerMode = 2048;
+
 } // anonymous namespace
 
 namespace solidity::frontend
@@ -651,6 +657,7 @@ void CommandLineInterface::readInputFiles()
 
 	if (
 		m_options.input.mode != InputMode::LanguageServer &&
+		m_options.input.mode != InputMode::StandardJsonServer &&
 		m_fileReader.sourceUnits().empty() &&
 		!m_standardJsonInput.has_value()
 	)
@@ -798,10 +805,16 @@ void CommandLineInterface::processInput()
 		solAssert(m_standardJsonInput.has_value());
 
 		StandardCompiler compiler(m_universalCallback.callback(), m_options.formatting.json);
-		sout() << compiler.compile(std::move(m_standardJsonInput.value())) << std::endl;
+		bool outputComplete = compiler.compile(m_standardJsonInput.value(), sout());
+		sout() << std::endl;
 		m_standardJsonInput.reset();
+		if (!outputComplete)
+			solThrow(CommandLineExecutionError, "Internal error while writing the output. The output is incomplete.");
 		break;
 	}
+	case InputMode::StandardJsonServer:
+		serveStandardJson();
+		break;
 	case InputMode::LanguageServer:
 		serveLSP();
 		break;
@@ -888,6 +901,10 @@ void CommandLineInterface::compile()
 		m_compiler->setRemappings(m_options.input.remappings);
 		m_compiler->setLibraries(m_options.linker.libraries);
 		m_compiler->setViaIR(m_options.output.viaIR);
+		m_compiler->setParallelism(m_options.output.parallelism);
+		m_compiler->setProfiling(m_options.output.profileFile.has_value());
+		if (m_options.optimizer.cacheDirectory.has_value())
+			m_compiler->setOptimizerCacheDirectory(*m_options.optimizer.cacheDirectory, m_options.optimizer.cacheSizeLimit);
 		m_compiler->setEVMVersion(m_options.output.evmVersion);
 		m_compiler->setEOFVersion(m_options.output.eofVersion);
 		m_compiler->setRevertStringBehaviour(m_options.output.revertStrings);
@@ -957,6 +974,16 @@ void CommandLineInterface::compile()
 			formatter.printErrorInformation(*error);
 		}
 
+		if (m_options.output.profileFile.has_value())
+		{
+			solAssert(m_compiler->profiler());
+			std::string pathName = m_options.output.profileFile->string();
+			std::ofstream profileFile(pathName);
+			profileFile << util::jsonPrint(m_compiler->profiler()->toJson(), m_options.formatting.json) << std::endl;
+			if (!profileFile)
+				solThrow(CommandLineOutputError, "Could not write to file \"" + pathName + "\".");
+		}
+
 		if (!successful)
 			solThrow(CommandLineExecutionError, "");
 	}
@@ -1117,6 +1144,46 @@ void CommandLineInterface::handleAst()
 	}
 }
 
+void CommandLineInterface::serveStandardJson()
+{
+	// Parsed source units and optimized Yul objects are reused by later compilations. Since they
+	// refer to Yul strings, the string repository must not be reset while they are kept.
+	std::optional<yul::YulStringRepository::Scope> yulStringScope;
+	std::shared_ptr<yul::ObjectOptimizer> objectOptimizer;
+	std::shared_ptr<ParsedSourceCache> parsedSourceCache;
+
+	std::string input;
+	while (std::getline(m_sin, input))
+	{
+		if (boost::trim_copy(input).empty())
+			continue;
+
+		if (!objectOptimizer || objectOptimizer->size() > maxCachedObjectsInServerMode)
+		{
+			objectOptimizer.reset();
+			parsedSourceCache.reset();
+			yulStringScope.reset();
+			yulStringScope.emplace();
+			objectOptimizer = std::make_shared<yul::ObjectOptimizer>();
+			parsedSourceCache = std::make_shared<ParsedSourceCache>();
+		}
+
+		// Files loaded on import might have changed since the previous compilation.
+		m_fileReader.setSourceUnits({});
+		// The output of each compilation has to fit on a single line.
+		StandardCompiler compiler(
+			m_universalCallback.callback(),
+			util::JsonFormat{util::JsonFormat::Compact},
+			objectOptimizer,
+			parsedSourceCache
+		);
+		bool outputComplete = compiler.compile(input, sout());
+		sout() << std::endl;
+		if (!outputComplete)
+			serr() << "Internal error while writing the output. The output is incomplete." << std::endl;
+	}
+}
+
 void CommandLineInterface::serveLSP()
 {
 	lsp::StdioTransport transport;
@@ -55,6 +55,7 @@ static std::string const g_strHelp = "help";
 static std::string const g_strImportAst = "import-ast";
 static std::string const g_strImportEvmAssemblerJson = "import-asm-json";
 static std::string const g_strInputFile = "input-file";
+static std::string const g_strJobs = "jobs";
 static std::string const g_strYul = "yul";
 static std::string const g_strYulDialect = "yul-dialect";
 static std::string const g_strDebugInfo = "debug-info";
@@ -72,10 +73,13 @@ static std::string const g_strModelCheckerDivModNoSlacks = "model-checker-div-mo
 static std::string const g_strModelCheckerEngine = "model-checker-engine";
 static std::string const g_strModelCheckerExtCalls = "model-checker-ext-calls";
 static std::string const g_strModelCheckerInvariants = "model-checker-invariants";
+static std::string const g_strModelCheckerJobs = "model-checker-jobs";
 static std::string const g_strModelCheckerPrintQuery = "model-checker-print-query";
+static std::string const g_strModelCheckerRaceSolvers = "model-checker-race-solvers";
 static std::string const g_strModelCheckerShowProvedSafe = "model-checker-show-proved-safe";
 static std::string const g_strModelCheckerShowUnproved = "model-checker-show-unproved";
 static std::string const g_strModelCheckerShowUnsupported = "model-checker-show-unsupported";
+static std::string const g_strModelCheckerSolverSessions = "model-checker-solver-sessions";
 static std::string const g_strModelCheckerSolvers = "model-checker-solvers";
 static std::string const g_strModelCheckerTargets = "model-checker-targets";
 static std::string const g_strModelCheckerTimeout = "model-checker-timeout";
@@ -86,9 +90,12 @@ static std::string const g_strNoImportCallback = "no-import-callback";
 static std::string const g_strOptimize = "optimize";
 static std::string const g_strOptimizeRuns = "optimize-runs";
 static std::string const g_strOptimizeYul = "optimize-yul";
+static std::string const g_strOptimizerCacheDir = "optimizer-cache-dir";
+static std::string const g_strOptimizerCacheSizeLimit = "optimizer-cache-size-limit";
 static std::string const g_strYulOptimizations = "yul-optimizations";
 static std::string const g_strOutputDir = "output-dir";
 static std::string const g_strOverwrite = "overwrite";
+static std::string const g_strProfileJson = "profile-json";
 static std::string const g_strRevertStrings = "revert-strings";
 static std::string const g_strStopAfter = "stop-after";
 static std::string const g_strParsing = "parsing";
@@ -105,6 +112,7 @@ static std::set<std::string> const g_revertStringsArgs
 static std::string const g_strSources = "sources";
 static std::string const g_strSourceList = "sourceList";
 static std::string const g_strStandardJSON = "standard-json";
+static std::string const g_strStandardJSONServer = "standard-json-server";
 static std::string const g_strStrictAssembly = "strict-assembly";
 static std::string const g_strSwarm = "swarm";
 static std::string const g_strPrettyJson = "pretty-json";
@@ -143,6 +151,7 @@ static std::map<InputMode, std::string> const g_inputModeName = {
 	{InputMode::CompilerWithASTImport, "compiler (AST import)"},
 	{InputMode::Assembler, "assembler"},
 	{InputMode::StandardJson, "standard JSON"},
+	{InputMode::StandardJsonServer, "standard JSON server"},
 	{InputMode::Linker, "linker"},
 	{InputMode::LanguageServer, "language server (LSP)"},
 	{InputMode::EVMAssemblerJSON, "EVM assembler (JSON format)"},
@@ -235,10 +244,12 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		output.overwriteFiles == _other.output.overwriteFiles &&
 		output.evmVersion == _other.output.evmVersion &&
 		output.viaIR == _other.output.viaIR &&
+		output.parallelism == _other.output.parallelism &&
 		output.revertStrings == _other.output.revertStrings &&
 		output.debugInfoSelection == _other.output.debugInfoSelection &&
 		output.stopAfter == _other.output.stopAfter &&
 		output.eofVersion == _other.output.eofVersion &&
+		output.profileFile == _other.output.profileFile &&
 		input.mode == _other.input.mode &&
 		assembly.targetMachine == _other.assembly.targetMachine &&
 		assembly.inputLanguage == _other.assembly.inputLanguage &&
@@ -256,6 +267,8 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		optimizer.optimizeYul == _other.optimizer.optimizeYul &&
 		optimizer.expectedExecutionsPerDeployment == _other.optimizer.expectedExecutionsPerDeployment &&
 		optimizer.yulSteps == _other.optimizer.yulSteps &&
+		optimizer.cacheDirectory == _other.optimizer.cacheDirectory &&
+		optimizer.cacheSizeLimit == _other.optimizer.cacheSizeLimit &&
 		modelChecker.initialize == _other.modelChecker.initialize &&
 		modelChecker.settings == _other.modelChecker.settings;
 }
@@ -312,7 +325,7 @@ void CommandLineParser::parseInputPathsAndRemappings()
 				if (!remapping.has_value())
 					solThrow(CommandLineValidationError, "Invalid remapping: \"" + positionalArg + "\".");
 
-				if (m_options.input.mode == InputMode::StandardJson)
+				if (m_options.input.mode == InputMode::StandardJson || m_options.input.mode == InputMode::StandardJsonServer)
 					solThrow(
 						CommandLineValidationError,
 						"Import remappings are not accepted on the command line in Standard JSON mode.\n"
@@ -339,7 +352,15 @@ void CommandLineParser::parseInputPathsAndRemappings()
 				m_options.input.paths.insert(positionalArg);
 		}
 
-	if (m_options.input.mode == InputMode::StandardJson)
+	if (m_options.input.mode == InputMode::StandardJsonServer)
+	{
+		if (!m_options.input.paths.empty() || m_options.input.addStdin)
+			solThrow(
+				CommandLineValidationError,
+				"--" + g_strStandardJSONServer + " does not accept input files. It reads requests from standard input."
+			);
+	}
+	else if (m_options.input.mode == InputMode::StandardJson)
 	{
 		if (m_options.input.paths.size() > 1 || (m_options.input.paths.size() == 1 && m_options.input.addStdin))
 			solThrow(
@@ -497,6 +518,7 @@ void CommandLineParser::parseOutputSelection()
 		case InputMode::Assembler:
 			return util::contains(assemblerModeOutputs, _outputName);
 		case InputMode::StandardJson:
+		case InputMode::StandardJsonServer:
 		case InputMode::Linker:
 			return false;
 		}
@@ -641,6 +663,14 @@ General Information)").c_str(),
 			g_strViaIR.c_str(),
 			"Turn on compilation mode via the IR."
 		)
+		(
+			g_strJobs.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Number of threads used to parse sources and compile contracts concurrently. "
+			"0 means one per available hardware thread. "
+			"Without --via-ir, only the parsing and the optimization of the assembly are parallelized. "
+			"The output does not depend on this setting."
+		)
 		(
 			g_strRevertStrings.c_str(),
 			po::value<std::string>()->value_name(util::joinHumanReadable(g_revertStringsArgs, ",")),
@@ -658,6 +688,14 @@ General Information)").c_str(),
 			po::value<std::string>()->value_name("stage"),
 			"Stop execution after the given compiler stage. Valid options: \"parsing\"."
 		)
+		(
+			g_strProfileJson.c_str(),
+			po::value<std::string>()->value_name("path"),
+			"Measure the time spent in each compilation phase and write the results as JSON, broken down "
+			"by contract, to the specified file. The \"rssHighWaterGrowth\" of a phase is the growth of the "
+			"resident set size high-water mark of the process during the phase in bytes, not the memory "
+			"allocated by the phase."
+		)
 	;
 	desc.add(outputOptions);
 
@@ -668,6 +706,12 @@ General Information)").c_str(),
 			"Switch to Standard JSON input / output mode, ignoring all options. "
 			"It reads from standard input, if no input file was given, otherwise it reads from the provided input file. The result will be written to standard output."
 		)
+		(
+			g_strStandardJSONServer.c_str(),
+			("Switch to Standard JSON server mode, ignoring all options. Like --" + g_strStandardJSON + ", but keeps "
+			"running and compiles every line of standard input as a separate Standard JSON input, writing each "
+			"result as a single line to standard output. Optimized code is reused between compilations.").c_str()
+		)
 		(
 			g_strLink.c_str(),
 			("Switch to linker mode, ignoring all options apart from --" + g_strLibraries + " "
@@ -839,6 +883,18 @@ General Information)").c_str(),
 			po::value<std::string>()->value_name("steps"),
 			"Forces Yul optimizer to use the specified sequence of optimization steps instead of the built-in one."
 		)
+		(
+			g_strOptimizerCacheDir.c_str(),
+			po::value<std::string>()->value_name("path"),
+			"Store the results of the Yul optimizer in the given directory and reuse them in later compilations "
+			"with the same compiler version. Does not affect the output."
+		)
+		(
+			g_strOptimizerCacheSizeLimit.c_str(),
+			po::value<size_t>()->value_name("bytes")->default_value(yul::PersistentObjectCache::defaultSizeLimit),
+			("Maximum total size of the files in the directory given via --" + g_strOptimizerCacheDir + ". "
+			"The least recently used entries are removed when it is exceeded.").c_str()
+		)
 	;
 	desc.add(optimizerOptions);
 
@@ -874,10 +930,21 @@ General Information)").c_str(),
 			" Multiple types of invariants can be selected at the same time, separated by a comma and no spaces."
 			" By default no invariants are reported."
 		)
+		(
+			g_strModelCheckerJobs.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Send the queries of up to n independent verification targets to the solvers concurrently."
+			" The results are reported in the same order regardless of n."
+			" 0 means the number of hardware threads. The default is 1."
+		)
 		(
 			g_strModelCheckerPrintQuery.c_str(),
 			"Print the queries created by the SMTChecker in the SMTLIB2 format."
 		)
+		(
+			g_strModelCheckerRaceSolvers.c_str(),
+			"Run the BMC solvers concurrently and use the first definitive answer instead of checking that all solvers agree."
+		)
 		(
 			g_strModelCheckerShowProvedSafe.c_str(),
 			"Show all targets that were proved safe separately."
@@ -890,6 +957,10 @@ General Information)").c_str(),
 			g_strModelCheckerShowUnsupported.c_str(),
 			"Show all unsupported language features separately."
 		)
+		(
+			g_strModelCheckerSolverSessions.c_str(),
+			"Keep one process per BMC solver alive and send it queries incrementally instead of starting a new process for every query."
+		)
 		(
 			g_strModelCheckerSolvers.c_str(),
 			po::value<std::string>()->value_name("cvc5,eld,z3,smtlib2")->default_value("z3"),
@@ -966,6 +1037,7 @@ void CommandLineParser::processArgs()
 		g_strLicense,
 		g_strVersion,
 		g_strStandardJSON,
+		g_strStandardJSONServer,
 		g_strLink,
 		g_strAssemble,
 		g_strStrictAssembly,
@@ -982,6 +1054,8 @@ void CommandLineParser::processArgs()
 		m_options.input.mode = InputMode::Version;
 	else if (m_args.count(g_strStandardJSON) > 0)
 		m_options.input.mode = InputMode::StandardJson;
+	else if (m_args.count(g_strStandardJSONServer) > 0)
+		m_options.input.mode = InputMode::StandardJsonServer;
 	else if (m_args.count(g_strLSP))
 		m_options.input.mode = InputMode::LanguageServer;
 	else if (m_args.count(g_strAssemble) > 0 || m_args.count(g_strStrictAssembly) > 0)
@@ -1013,6 +1087,9 @@ void CommandLineParser::processArgs()
 		// TODO: This should eventually contain all options.
 		{g_strExperimentalViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strJobs, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strProfileJson, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strOptimizerCacheDir, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strMetadataLiteral, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strNoCBORMetadata, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strMetadataHash, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
@@ -1020,10 +1097,13 @@ void CommandLineParser::processArgs()
 		{g_strModelCheckerDivModNoSlacks, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerEngine, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerInvariants, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerJobs, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerPrintQuery, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerRaceSolvers, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerShowProvedSafe, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerShowUnproved, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerShowUnsupported, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerSolverSessions, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerSolvers, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerTimeout, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerBMCLoopIterations, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
@@ -1151,6 +1231,9 @@ void CommandLineParser::processArgs()
 
 	m_options.output.overwriteFiles = (m_args.count(g_strOverwrite) > 0);
 
+	if (m_args.count(g_strProfileJson))
+		m_options.output.profileFile = m_args.at(g_strProfileJson).as<std::string>();
+
 	if (m_args.count(g_strPrettyJson) > 0)
 	{
 		m_options.formatting.json.format = util::JsonFormat::Pretty;
@@ -1205,7 +1288,7 @@ void CommandLineParser::processArgs()
 
 	parseInputPathsAndRemappings();
 
-	if (m_options.input.mode == InputMode::StandardJson)
+	if (m_options.input.mode == InputMode::StandardJson || m_options.input.mode == InputMode::StandardJsonServer)
 		return;
 
 	if (m_args.count(g_strLibraries))
@@ -1275,6 +1358,15 @@ void CommandLineParser::processArgs()
 		m_options.optimizer.yulSteps = m_args[g_strYulOptimizations].as<std::string>();
 	}
 
+	if (m_args.count(g_strOptimizerCacheDir) > 0)
+		m_options.optimizer.cacheDirectory = boost::filesystem::path(m_args[g_strOptimizerCacheDir].as<std::string>());
+	else if (!m_args[g_strOptimizerCacheSizeLimit].defaulted())
+		solThrow(
+			CommandLineValidationError,
+			"Option --" + g_strOptimizerCacheSizeLimit + " can only be used together with --" + g_strOptimizerCacheDir + "."
+		);
+	m_options.optimizer.cacheSizeLimit = m_args[g_strOptimizerCacheSizeLimit].as<size_t>();
+
 	if (m_options.input.mode == InputMode::Assembler)
 	{
 		std::vector<std::string> const nonAssemblyModeOptions = {
@@ -1396,6 +1488,12 @@ void CommandLineParser::processArgs()
 		m_options.modelChecker.settings.invariants = *invs;
 	}
 
+	if (m_args.count(g_strModelCheckerJobs))
+		m_options.modelChecker.settings.jobs = m_args[g_strModelCheckerJobs].as<unsigned>();
+
+	if (m_args.count(g_strModelCheckerRaceSolvers))
+		m_options.modelChecker.settings.raceSolvers = true;
+
 	if (m_args.count(g_strModelCheckerShowProvedSafe))
 		m_options.modelChecker.settings.showProvedSafe = true;
 
@@ -1405,6 +1503,9 @@ void CommandLineParser::processArgs()
 	if (m_args.count(g_strModelCheckerShowUnsupported))
 		m_options.modelChecker.settings.showUnsupported = true;
 
+	if (m_args.count(g_strModelCheckerSolverSessions))
+		m_options.modelChecker.settings.solverSessions = true;
+
 	if (m_args.count(g_strModelCheckerSolvers))
 	{
 		std::string solversStr = m_args[g_strModelCheckerSolvers].as<std::string>();
@@ -1447,13 +1548,17 @@ void CommandLineParser::processArgs()
 		m_args.count(g_strModelCheckerEngine) ||
 		m_args.count(g_strModelCheckerExtCalls) ||
 		m_args.count(g_strModelCheckerInvariants) ||
+		m_args.count(g_strModelCheckerJobs) ||
+		m_args.count(g_strModelCheckerRaceSolvers) ||
 		m_args.count(g_strModelCheckerShowProvedSafe) ||
 		m_args.count(g_strModelCheckerShowUnproved) ||
 		m_args.count(g_strModelCheckerShowUnsupported) ||
+		m_args.count(g_strModelCheckerSolverSessions) ||
 		m_args.count(g_strModelCheckerSolvers) ||
 		m_args.count(g_strModelCheckerTargets) ||
 		m_args.count(g_strModelCheckerTimeout);
 	m_options.output.viaIR = (m_args.count(g_strExperimentalViaIR) > 0 || m_args.count(g_strViaIR) > 0);
+	m_options.output.parallelism = m_args.at(g_strJobs).as<unsigned>();
 
 	solAssert(
 		m_options.input.mode == InputMode::Compiler ||
@@ -54,6 +54,7 @@ enum class InputMode
 	Compiler,
 	CompilerWithASTImport,
 	StandardJson,
+	StandardJsonServer,
 	Linker,
 	Assembler,
 	LanguageServer,
@@ -190,10 +191,12 @@ struct CommandLineOptions
 		bool overwriteFiles = false;
 		langutil::EVMVersion evmVersion;
 		bool viaIR = false;
+		size_t parallelism = 1;
 		RevertStrings revertStrings = RevertStrings::Default;
 		std::optional<langutil::DebugInfoSelection> debugInfoSelection;
 		CompilerStack::State stopAfter = CompilerStack::State::CompilationSuccessful;
 		std::optional<uint8_t> eofVersion;
+		std::optional<boost::filesystem::path> profileFile;
 	} output;
 
 	struct
@@ -234,6 +237,8 @@ struct CommandLineOptions
 		bool optimizeYul = false;
 		std::optional<unsigned> expectedExecutionsPerDeployment;
 		std::optional<std::string> yulSteps;
+		std::optional<boost::filesystem::path> cacheDirectory;
+		size_t cacheSizeLimit = yul::PersistentObjectCache::defaultSizeLimit;
 	} optimizer;
 
 	struct
@@ -24,6 +24,7 @@
 
 #include <libevmasm/Assembly.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/ThreadPool.h>
 #include <libevmasm/Disassemble.h>
 #include <libyul/Exceptions.h>
 
@@ -31,6 +32,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -422,6 +424,149 @@ BOOST_AUTO_TEST_CASE(subobject_encode_decode)
 	BOOST_CHECK(assembly.decodeSubPath(assembly.encodeSubPath(subPath)) == subPath);
 }
 
+BOOST_AUTO_TEST_CASE(assembly_item_data)
+{
+	u256 const large = u256(1) << 200;
+	AssemblyItem small{u256(42)};
+	AssemblyItem big{large};
+	BOOST_CHECK_EQUAL(small.data(), 42);
+	BOOST_CHECK_EQUAL(big.data(), large);
+	BOOST_CHECK(small == AssemblyItem{u256(42)});
+	BOOST_CHECK(big == AssemblyItem{large});
+	BOOST_CHECK(small != big);
+	BOOST_CHECK(small < big);
+	BOOST_CHECK(!(big < small));
+
+	// Copies share large data, but changing it does not affect the other copies.
+	AssemblyItem copy = big;
+	copy.setData(u256(42));
+	BOOST_CHECK(copy == small);
+	BOOST_CHECK_EQUAL(big.data(), large);
+	copy.setData(large + 1);
+	BOOST_CHECK(big < copy);
+
+	AssemblyItem verbatim{bytes{0x01, 0x02}, 1, 2};
+	BOOST_CHECK(verbatim == (AssemblyItem{bytes{0x01, 0x02}, 1, 2}));
+	BOOST_CHECK(verbatim != (AssemblyItem{bytes{0x01, 0x02}, 2, 2}));
+	BOOST_CHECK_EQUAL(verbatim.arguments(), 1);
+	BOOST_CHECK_EQUAL(verbatim.returnValues(), 2);
+	BOOST_CHECK(verbatim.verbatimData() == (bytes{0x01, 0x02}));
+}
+
+BOOST_AUTO_TEST_CASE(parallel_optimisation_of_subs)
+{
+	EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
+
+	// Builds a tree of assemblies where each one contains code that can be optimised
+	// and a duplicate block whose tag gets replaced.
+	std::function<std::shared_ptr<Assembly>(bool, size_t)> createAssembly = [&](bool _creation, size_t _depth) {
+		auto assembly = std::make_shared<Assembly>(evmVersion, _creation, std::nullopt, std::string{});
+		for (size_t i = 0; i < 3 && _depth > 0; ++i)
+			assembly->appendSubroutine(createAssembly(false, _depth - 1));
+		*assembly << u256(1) << u256(2) << Instruction::ADD << Instruction::POP;
+		*assembly << u256(0) << Instruction::CALLDATALOAD;
+		AssemblyItem first = assembly->newTag();
+		AssemblyItem second = assembly->newTag();
+		assembly->appendJumpI(first);
+		assembly->appendJump(second);
+		assembly->append(first);
+		*assembly << u256(42) << u256(0) << Instruction::SSTORE << Instruction::STOP;
+		assembly->append(second);
+		*assembly << u256(42) << u256(0) << Instruction::SSTORE << Instruction::STOP;
+		return assembly;
+	};
+
+	Assembly::OptimiserSettings settings = Assembly::OptimiserSettings::translateSettings(
+		frontend::OptimiserSettings::full(),
+		evmVersion
+	);
+	std::shared_ptr<Assembly> sequential = createAssembly(true, 2);
+	sequential->optimise(settings);
+	std::shared_ptr<Assembly> parallel = createAssembly(true, 2);
+	util::ThreadPool threadPool(4);
+	parallel->optimise(settings, &threadPool);
+
+	BOOST_CHECK_EQUAL(parallel->assemblyString(), sequential->assemblyString());
+	BOOST_CHECK(parallel->assemble().bytecode == sequential->assemble().bytecode);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_common_subexpression_elimination)
+{
+	EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
+
+	// Creates many basic blocks containing expressions the common subexpression eliminator simplifies.
+	auto createAssembly = [&]() {
+		auto assembly = std::make_shared<Assembly>(evmVersion, false, std::nullopt, std::string{});
+		for (size_t i = 0; i < 32; ++i)
+		{
+			*assembly << u256(i) << u256(2) << Instruction::MUL << u256(0) << Instruction::CALLDATALOAD;
+			*assembly << Instruction::DUP1 << Instruction::POP;
+			AssemblyItem tag = assembly->newTag();
+			assembly->appendJumpI(tag);
+			*assembly << Instruction::STOP;
+			assembly->append(tag);
+		}
+		*assembly << Instruction::STOP;
+		return assembly;
+	};
+
+	Assembly::OptimiserSettings settings = Assembly::OptimiserSettings::translateSettings(
+		frontend::OptimiserSettings::full(),
+		evmVersion
+	);
+	std::shared_ptr<Assembly> sequential = createAssembly();
+	sequential->optimise(settings);
+	std::shared_ptr<Assembly> parallel = createAssembly();
+	util::ThreadPool threadPool(4);
+	parallel->optimise(settings, &threadPool);
+
+	BOOST_CHECK(sequential->codeSections().front().items.size() < createAssembly()->codeSections().front().items.size());
+	BOOST_CHECK_EQUAL(parallel->assemblyString(), sequential->assemblyString());
+	BOOST_CHECK(parallel->assemble().bytecode == sequential->assemble().bytecode);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_common_subexpression_elimination_with_shared_subs)
+{
+	EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
+
+	// The sub-assembly is referenced twice, so the sub-assemblies are optimised one after another,
+	// while the blocks of each assembly are still optimised concurrently.
+	auto appendBlocks = [](Assembly& _assembly) {
+		for (size_t i = 0; i < 32; ++i)
+		{
+			_assembly << u256(i) << u256(2) << Instruction::MUL << u256(0) << Instruction::CALLDATALOAD;
+			_assembly << Instruction::DUP1 << Instruction::POP;
+			AssemblyItem tag = _assembly.newTag();
+			_assembly.appendJumpI(tag);
+			_assembly << Instruction::STOP;
+			_assembly.append(tag);
+		}
+		_assembly << Instruction::STOP;
+	};
+	auto createAssembly = [&]() {
+		auto sub = std::make_shared<Assembly>(evmVersion, false, std::nullopt, std::string{});
+		appendBlocks(*sub);
+		auto assembly = std::make_shared<Assembly>(evmVersion, true, std::nullopt, std::string{});
+		assembly->appendSubroutine(sub);
+		assembly->appendSubroutine(sub);
+		appendBlocks(*assembly);
+		return assembly;
+	};
+
+	Assembly::OptimiserSettings settings = Assembly::OptimiserSettings::translateSettings(
+		frontend::OptimiserSettings::full(),
+		evmVersion
+	);
+	std::shared_ptr<Assembly> sequential = createAssembly();
+	sequential->optimise(settings);
+	std::shared_ptr<Assembly> parallel = createAssembly();
+	util::ThreadPool threadPool(4);
+	parallel->optimise(settings, &threadPool);
+
+	BOOST_CHECK_EQUAL(parallel->assemblyString(), sequential->assemblyString());
+	BOOST_CHECK(parallel->assemble().bytecode == sequential->assemble().bytecode);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -192,6 +192,7 @@ BOOST_AUTO_TEST_CASE(cse_assign_immutable_breaks)
 	evmasm::CommonSubexpressionEliminator cse{evmasm::KnownState()};
 	// Make sure CSE breaks after AssignImmutable.
 	BOOST_REQUIRE(cse.feedItems(input.begin(), input.end(), false) == input.begin() + 2);
+	BOOST_CHECK(evmasm::CommonSubexpressionEliminator::chunkEnd(input.begin(), input.end(), false) == input.begin() + 2);
 }
 
 BOOST_AUTO_TEST_CASE(cse_intermediate_swap)
@@ -1801,7 +1802,8 @@ BOOST_AUTO_TEST_CASE(inliner)
 		Instruction::SWAP1,
 		jumpOutOf,
 	};
-	Inliner{items, {}, Assembly::OptimiserSettings{}.expectedExecutionsPerDeployment, false, {}}.optimise();
+	Inliner inliner{items, {}, Assembly::OptimiserSettings{}.expectedExecutionsPerDeployment, false, {}};
+	BOOST_CHECK(inliner.optimise());
 	BOOST_CHECK_EQUAL_COLLECTIONS(
 		items.begin(), items.end(),
 		expectation.begin(), expectation.end()
@@ -1823,7 +1825,8 @@ BOOST_AUTO_TEST_CASE(inliner_no_inline_type)
 		Instruction::SWAP1,
 		Instruction::JUMP,
 	};
-	Inliner{items, {}, Assembly::OptimiserSettings{}.expectedExecutionsPerDeployment, false, {}}.optimise();
+	Inliner inliner{items, {}, Assembly::OptimiserSettings{}.expectedExecutionsPerDeployment, false, {}};
+	BOOST_CHECK(!inliner.optimise());
 	BOOST_CHECK_EQUAL_COLLECTIONS(
 		items.begin(), items.end(),
 		items.begin(), items.end()
@@ -33,6 +33,7 @@
 #include <libsolidity/analysis/NameAndTypeResolver.h>
 #include <libsolidity/analysis/Scoper.h>
 #include <libsolidity/codegen/Compiler.h>
+#include <libsolidity/codegen/InlineAssemblyCache.h>
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/analysis/TypeChecker.h>
 #include <libsolidity/analysis/SyntaxChecker.h>
@@ -52,7 +53,10 @@ namespace solidity::frontend::test
 namespace
 {
 
-evmasm::AssemblyItems compileContract(std::shared_ptr<CharStream> _sourceCode)
+evmasm::AssemblyItems compileContract(
+	std::shared_ptr<CharStream> _sourceCode,
+	std::shared_ptr<InlineAssemblyCache> _inlineAssemblyCache = nullptr
+)
 {
 	ErrorList errors;
 	ErrorReporter errorReporter(errors);
@@ -91,7 +95,8 @@ evmasm::AssemblyItems compileContract(std::shared_ptr<CharStream> _sourceCode)
 			Compiler compiler(
 				solidity::test::CommonOptions::get().evmVersion(),
 				RevertStrings::Default,
-				solidity::test::CommonOptions::get().optimize ? OptimiserSettings::standard() : OptimiserSettings::minimal()
+				solidity::test::CommonOptions::get().optimize ? OptimiserSettings::standard() : OptimiserSettings::minimal(),
+				_inlineAssemblyCache
 			);
 			compiler.compileContract(*contract, std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>{}, bytes());
 
@@ -222,6 +227,32 @@ BOOST_AUTO_TEST_CASE(jump_type)
 }
 
 
+BOOST_AUTO_TEST_CASE(inline_assembly_cache)
+{
+	std::string sourceCode = R"(
+	contract test {
+		function f(uint a) public pure returns (uint) {
+			require(a > 1);
+			require(a > 2);
+			return a;
+		}
+	}
+	)";
+	auto cache = std::make_shared<InlineAssemblyCache>();
+	AssemblyItems uncached = compileContract(std::make_shared<CharStream>(sourceCode, ""));
+	AssemblyItems cached = compileContract(std::make_shared<CharStream>(sourceCode, ""), cache);
+	AssemblyItems cachedAgain = compileContract(std::make_shared<CharStream>(sourceCode, ""), cache);
+	for (AssemblyItems const* items: {&cached, &cachedAgain})
+	{
+		BOOST_REQUIRE_EQUAL(items->size(), uncached.size());
+		for (size_t i = 0; i < uncached.size(); ++i)
+		{
+			BOOST_CHECK((*items)[i] == uncached[i]);
+			BOOST_CHECK((*items)[i].location() == uncached[i].location());
+		}
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
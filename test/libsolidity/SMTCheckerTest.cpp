@@ -134,6 +134,16 @@ SMTCheckerTest::SMTCheckerTest(std::string const& _filename):
 #endif
 	}
 
+	auto const& solverSessions = m_reader.stringSetting("SMTSolverSessions", "no");
+	if (solverSessions == "no")
+		m_modelCheckerSettings.solverSessions = false;
+	else if (solverSessions == "yes")
+		m_modelCheckerSettings.solverSessions = true;
+	else
+		BOOST_THROW_EXCEPTION(std::runtime_error("Invalid SMT solver sessions choice."));
+
+	m_modelCheckerSettings.jobs = static_cast<unsigned>(m_reader.sizetSetting("SMTJobs", 1));
+
 	auto const& bmcLoopIterations = m_reader.sizetSetting("BMCLoopIterations", 1);
 	m_modelCheckerSettings.bmcLoopIterations = std::optional<unsigned>{bmcLoopIterations};
 }
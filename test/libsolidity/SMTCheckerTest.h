@@ -63,6 +63,8 @@ protected:
 		Set in m_modelCheckerSettings.
 	SMTSolvers: `all`, `cvc5`, `z3`, `eld`, `none`, where the default is `z3`.
 		Set in m_modelCheckerSettings.
+	SMTSolverSessions: `yes`, `no`, where the default is `no`.
+		Set in m_modelCheckerSettings.
 	BMCLoopIterations: number of loop iterations for BMC engine, the default is 1.
 		Set in m_modelCheckerSettings.
 	*/
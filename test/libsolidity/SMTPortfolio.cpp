@@ -0,0 +1,157 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the SMT solver portfolio.
+ */
+
+#include <libsmtutil/SMTLib2Interface.h>
+#include <libsmtutil/SMTPortfolio.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+using namespace solidity::smtutil;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+/// Solver that answers every query with a fixed result, optionally only after being cancelled.
+class MockSolver: public BMCSolverInterface
+{
+public:
+	MockSolver(CheckResult _result, bool _waitForCancellation = false):
+		m_result(_result),
+		m_waitForCancellation(_waitForCancellation)
+	{}
+
+	void reset() override {}
+	void push() override {}
+	void pop() override {}
+	void declareVariable(std::string const&, SortPointer const&) override {}
+	void addAssertion(Expression const&) override {}
+
+	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const&) override
+	{
+		++m_queries;
+		if (m_waitForCancellation)
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_cancellation.wait(lock, [&]() { return m_cancelled; });
+			m_cancelled = false;
+			return {CheckResult::ERROR, {}};
+		}
+		return {m_result, {}};
+	}
+
+	void cancel() override
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_cancelled = true;
+		}
+		m_cancellation.notify_all();
+	}
+
+	size_t queries() const { return m_queries; }
+
+private:
+	CheckResult m_result;
+	bool m_waitForCancellation;
+	std::atomic<size_t> m_queries = 0;
+	std::mutex m_mutex;
+	std::condition_variable m_cancellation;
+	bool m_cancelled = false;
+};
+
+SMTPortfolio makePortfolio(std::vector<MockSolver*>& _mocks, std::vector<std::pair<CheckResult, bool>> const& _solvers, bool _race)
+{
+	std::vector<std::unique_ptr<BMCSolverInterface>> solvers;
+	for (auto const& [result, waitForCancellation]: _solvers)
+	{
+		auto solver = std::make_unique<MockSolver>(result, waitForCancellation);
+		_mocks.push_back(solver.get());
+		solvers.emplace_back(std::move(solver));
+	}
+	return SMTPortfolio(std::move(solvers), std::nullopt, _race);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(SMTPortfolioTest)
+
+BOOST_AUTO_TEST_CASE(sequential_detects_conflicts)
+{
+	std::vector<MockSolver*> mocks;
+	SMTPortfolio portfolio = makePortfolio(mocks, {{CheckResult::SATISFIABLE, false}, {CheckResult::UNSATISFIABLE, false}}, false);
+	BOOST_CHECK(portfolio.check({}).first == CheckResult::CONFLICTING);
+}
+
+BOOST_AUTO_TEST_CASE(race_cancels_slower_solvers)
+{
+	std::vector<MockSolver*> mocks;
+	SMTPortfolio portfolio = makePortfolio(mocks, {{CheckResult::UNKNOWN, true}, {CheckResult::UNSATISFIABLE, false}}, true);
+	for (size_t i = 0; i < 3; ++i)
+		BOOST_CHECK(portfolio.check({}).first == CheckResult::UNSATISFIABLE);
+	BOOST_TEST(mocks[1]->queries() == 3);
+}
+
+BOOST_AUTO_TEST_CASE(race_without_answer)
+{
+	std::vector<MockSolver*> mocks;
+	SMTPortfolio portfolio = makePortfolio(mocks, {{CheckResult::ERROR, false}, {CheckResult::UNKNOWN, false}}, true);
+	BOOST_CHECK(portfolio.check({}).first == CheckResult::UNKNOWN);
+	BOOST_TEST(mocks[0]->queries() == 1);
+	BOOST_TEST(mocks[1]->queries() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(prefetched_answers_are_reused)
+{
+	std::atomic<size_t> callbackCalls = 0;
+	ReadCallback::Callback callback = [&](std::string const&, std::string const&) -> ReadCallback::Result {
+		++callbackCalls;
+		return {true, "unsat\n"};
+	};
+	std::vector<std::unique_ptr<BMCSolverInterface>> solvers;
+	solvers.emplace_back(std::make_unique<SMTLib2Interface>(std::map<util::h256, std::string>{}, callback));
+	solvers.emplace_back(std::make_unique<SMTLib2Interface>(std::map<util::h256, std::string>{}, callback));
+	SMTPortfolio portfolio(std::move(solvers), std::nullopt);
+	portfolio.declareVariable("x", SortProvider::sintSort);
+	portfolio.addAssertion(Expression("x", {}, SortProvider::sintSort) > 0);
+
+	auto tasks = portfolio.prefetch({});
+	BOOST_REQUIRE(tasks.size() == 2);
+	for (auto& task: tasks)
+		task();
+	BOOST_TEST(callbackCalls == 2);
+
+	BOOST_CHECK(portfolio.check({}).first == CheckResult::UNSATISFIABLE);
+	BOOST_TEST(callbackCalls == 2);
+	// Prefetched answers are only used once.
+	BOOST_CHECK(portfolio.check({}).first == CheckResult::UNSATISFIABLE);
+	BOOST_TEST(callbackCalls == 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
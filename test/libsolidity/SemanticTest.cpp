@@ -108,6 +108,13 @@ SemanticTest::SemanticTest(
 
 	m_allowNonExistingFunctions = m_reader.boolSetting("allowNonExistingFunctions", false);
 
+	m_testCaseWantsSSACFGRun = m_reader.boolSetting("ssaCFGCodeTransform", false);
+	if (m_testCaseWantsSSACFGRun && !m_testCaseWantsYulRun)
+		BOOST_THROW_EXCEPTION(std::runtime_error(
+			"ssaCFGCodeTransform tests are run via yul, "
+			"so they cannot specify ``compileViaYul: false``"
+		));
+
 	parseExpectations(m_reader.stream());
 	soltestAssert(!m_tests.empty(), "No tests specified in " + _filename);
 
@@ -327,6 +334,16 @@ TestCase::TestResult SemanticTest::run(std::ostream& _stream, std::string const&
 			result = tryRunTestWithYulOptimizer(_stream, _linePrefix, _formatted);
 	}
 
+	if (m_testCaseWantsSSACFGRun && result == TestResult::Success && !m_eofVersion.has_value())
+	{
+		OptimiserSettings settings = solidity::test::CommonOptions::get().optimize ?
+			OptimiserSettings::full() :
+			optimizerSettingsFor(m_requiresYulOptimizer);
+		settings.experimentalSSACFGCodeTransform = true;
+		ScopedSaveAndRestore optimizerSettings(m_optimiserSettings, std::move(settings));
+		result = runTest(_stream, _linePrefix, _formatted, true /* _isYulRun */);
+	}
+
 	if (result != TestResult::Success)
 		solidity::test::CommonOptions::get().printSelectedOptions(
 			_stream,
@@ -353,7 +370,9 @@ TestCase::TestResult SemanticTest::runTest(
 
 	m_compileViaYul = _isYulRun;
 
-	if (_isYulRun)
+	if (_isYulRun && m_optimiserSettings.experimentalSSACFGCodeTransform)
+		AnsiColorized(_stream, _formatted, {BOLD, CYAN}) << _linePrefix << "Running via Yul with the SSA CFG code transform: " << std::endl;
+	else if (_isYulRun)
 		AnsiColorized(_stream, _formatted, {BOLD, CYAN}) << _linePrefix << "Running via Yul: " << std::endl;
 
 	for (TestFunctionCall& test: m_tests)
@@ -580,8 +599,10 @@ bool SemanticTest::checkGasCostExpectation(TestFunctionCall& io_test, bool _comp
 	// or the test has used up all available gas (test will fail anyway)
 	// or setting is "ir" and it's not included in expectations
 	// or if the called function is an isoltest builtin e.g. `smokeTest` or `storageEmpty`
+	// or the code was generated by the experimental SSA CFG code transform, which has no expectations
 	if (
 		!m_enforceGasCost ||
+		m_optimiserSettings.experimentalSSACFGCodeTransform ||
 		m_gasUsed < m_enforceGasCostMinValue ||
 		m_gasUsed >= InitialGas ||
 		(setting == "ir" && io_test.call().expectations.gasUsedExcludingCode.count(setting) == 0) ||
@@ -119,6 +119,8 @@ private:
 	std::vector<SideEffectHook> const m_sideEffectHooks;
 	bool m_testCaseWantsYulRun = true;
 	bool m_testCaseWantsLegacyRun = true;
+	/// Whether the test is run via Yul with the experimental SSA CFG code transform as well.
+	bool m_testCaseWantsSSACFGRun = false;
 	bool m_runWithABIEncoderV1Only = false;
 	bool m_allowNonExistingFunctions = false;
 	bool m_gasCostFailure = false;
@@ -3837,6 +3837,57 @@ BOOST_AUTO_TEST_CASE(strip_reason_strings)
 	)
 }
 
+BOOST_AUTO_TEST_CASE(ssa_cfg_code_transform)
+{
+	char const* sourceCode = R"(
+		contract C {
+			function fac(uint n) public pure returns (uint) {
+				return n <= 1 ? 1 : n * fac(n - 1);
+			}
+			function loop(uint n) public pure returns (uint sum, uint count) {
+				for (uint i = 0; i < n; ++i) {
+					if (i % 3 == 0)
+						continue;
+					if (i > 20)
+						break;
+					sum += i;
+					count++;
+				}
+			}
+			function select(uint x) public pure returns (uint r) {
+				assembly {
+					switch x
+					case 0 { r := 10 }
+					case 1 { r := 20 }
+					default { r := add(x, 30) }
+				}
+			}
+			function rotate(uint a, uint b, uint c) public pure returns (uint, uint, uint) {
+				return (c, a, b);
+			}
+			function sub(uint a, uint b) public pure returns (uint) {
+				return a - b;
+			}
+		}
+	)";
+	m_compileViaYul = true;
+	for (bool ssaCFGCodeTransform: {false, true})
+	{
+		reset();
+		m_optimiserSettings.experimentalSSACFGCodeTransform = ssaCFGCodeTransform;
+		compileAndRun(sourceCode, 0, "C");
+		ABI_CHECK(callContractFunction("fac(uint256)", 5), encodeArgs(120));
+		ABI_CHECK(callContractFunction("loop(uint256)", 30), encodeArgs(147, 14));
+		ABI_CHECK(callContractFunction("loop(uint256)", 3), encodeArgs(3, 2));
+		ABI_CHECK(callContractFunction("select(uint256)", 0), encodeArgs(10));
+		ABI_CHECK(callContractFunction("select(uint256)", 1), encodeArgs(20));
+		ABI_CHECK(callContractFunction("select(uint256)", 7), encodeArgs(37));
+		ABI_CHECK(callContractFunction("rotate(uint256,uint256,uint256)", 1, 2, 3), encodeArgs(3, 1, 2));
+		ABI_CHECK(callContractFunction("sub(uint256,uint256)", 3, 1), encodeArgs(2));
+		ABI_CHECK(callContractFunction("sub(uint256,uint256)", 1, 3), panicData(PanicCode::UnderOverflow));
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
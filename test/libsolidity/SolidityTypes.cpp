@@ -27,6 +27,8 @@
 #include <libsolutil/Keccak256.h>
 #include <boost/test/unit_test.hpp>
 
+#include <thread>
+
 using namespace solidity::langutil;
 
 namespace solidity::frontend::test
@@ -282,6 +284,33 @@ BOOST_AUTO_TEST_CASE(helper_string_result)
 	BOOST_REQUIRE_EQUAL(r1.message(), "Failure");
 }
 
+BOOST_AUTO_TEST_CASE(deduplicated_types)
+{
+	ArrayType const* uintArray = TypeProvider::array(DataLocation::Memory, TypeProvider::uint256());
+	BOOST_CHECK(TypeProvider::array(DataLocation::Memory, TypeProvider::uint256()) == uintArray);
+	BOOST_CHECK(TypeProvider::array(DataLocation::Memory, TypeProvider::uint256(), 2) != uintArray);
+	BOOST_CHECK(TypeProvider::withLocation(uintArray, DataLocation::Storage, true) == TypeProvider::withLocation(uintArray, DataLocation::Storage, true));
+	BOOST_CHECK(TypeProvider::typeType(uintArray) == TypeProvider::typeType(uintArray));
+	BOOST_CHECK(TypeProvider::tuple({uintArray, TypeProvider::boolean()}) == TypeProvider::tuple({uintArray, TypeProvider::boolean()}));
+	BOOST_CHECK(TypeProvider::rationalNumber(rational(7, 3)) == TypeProvider::rationalNumber(rational(7, 3)));
+	BOOST_CHECK(TypeProvider::rationalNumber(rational(7, 3)) != TypeProvider::rationalNumber(rational(7, 2)));
+}
+
+BOOST_AUTO_TEST_CASE(types_per_thread)
+{
+	IntegerType const* otherThreadType = nullptr;
+	std::string otherThreadIdentifier;
+	std::thread thread([&]() {
+		otherThreadType = TypeProvider::uint256();
+		otherThreadIdentifier = TypeProvider::typeType(otherThreadType)->identifier();
+		TypeProvider::reset();
+	});
+	thread.join();
+
+	BOOST_CHECK(otherThreadType != TypeProvider::uint256());
+	BOOST_CHECK_EQUAL(otherThreadIdentifier, TypeProvider::typeType(TypeProvider::uint256())->identifier());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
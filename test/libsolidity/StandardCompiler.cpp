@@ -28,11 +28,14 @@
 #include <libsolidity/interface/Version.h>
 #include <libsolutil/JSON.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/TemporaryDirectory.h>
+#include <libyul/YulString.h>
 #include <test/Metadata.h>
 #include <test/Common.h>
 
 #include <algorithm>
 #include <set>
+#include <sstream>
 
 using namespace solidity::evmasm;
 using namespace std::string_literals;
@@ -152,6 +155,31 @@ Json compile(std::string _input)
 	return ret;
 }
 
+/// Compiles @a _inputTemplate with ``PARALLELISM`` replaced by @a _parallelism.
+Json compileWithParallelism(
+	std::string _inputTemplate,
+	std::string const& _parallelism,
+	ReadCallback::Callback const& _readFile = ReadCallback::Callback()
+)
+{
+	_inputTemplate.replace(_inputTemplate.find("PARALLELISM"), std::string("PARALLELISM").size(), _parallelism);
+	StandardCompiler compiler(_readFile);
+	Json ret;
+	BOOST_REQUIRE(util::jsonParseStrict(compiler.compile(std::move(_inputTemplate)), ret));
+	return ret;
+}
+
+/// Checks that compiling @a _inputTemplate in parallel gives @a _sequentialResult.
+void checkParallelCompilation(
+	std::string const& _inputTemplate,
+	Json const& _sequentialResult,
+	ReadCallback::Callback const& _readFile = ReadCallback::Callback()
+)
+{
+	for (std::string parallelism: {"0", "2", "4"})
+		BOOST_CHECK(compileWithParallelism(_inputTemplate, parallelism, _readFile) == _sequentialResult);
+}
+
 } // end anonymous namespace
 
 BOOST_AUTO_TEST_SUITE(StandardCompiler)
@@ -1655,6 +1683,345 @@ BOOST_AUTO_TEST_CASE(stopAfter_ast_output)
 	BOOST_CHECK(result["sources"]["a.sol"]["ast"].is_object());
 }
 
+BOOST_AUTO_TEST_CASE(parallelism_invalid_type)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{ "": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } },
+		"settings":
+		{
+			"parallelism": -1,
+			"outputSelection":
+			{
+				"*": { "C": ["evm.bytecode"] }
+			}
+		}
+	}
+	)";
+	Json result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.parallelism\" must be an unsigned integer."));
+}
+
+BOOST_AUTO_TEST_CASE(profiling_invalid_type)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{ "": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } },
+		"settings":
+		{
+			"profiling": 1
+		}
+	}
+	)";
+	Json result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.profiling\" must be a Boolean."));
+}
+
+BOOST_AUTO_TEST_CASE(profiling)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{ "A.sol": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } },
+		"settings":
+		{
+			"profiling": true,
+			"outputSelection":
+			{
+				"*": { "C": ["evm.bytecode"] }
+			}
+		}
+	}
+	)";
+	Json result = compile(input);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_REQUIRE(result.contains("profiling"));
+	Json const& profiling = result["profiling"];
+	BOOST_REQUIRE(profiling["general"]["Parsing"].is_object());
+	BOOST_CHECK(profiling["general"]["Parsing"]["calls"] == 1);
+	BOOST_CHECK(profiling["general"]["TypeChecker"].is_object());
+	BOOST_REQUIRE(profiling["contracts"]["A.sol:C"].is_object());
+	BOOST_CHECK(profiling["contracts"]["A.sol:C"]["LegacyCodeGeneration"].is_object());
+
+	char const* inputWithoutProfiling = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{ "A.sol": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } },
+		"settings":
+		{
+			"outputSelection":
+			{
+				"*": { "C": ["evm.bytecode"] }
+			}
+		}
+	}
+	)";
+	BOOST_CHECK(!compile(inputWithoutProfiling).contains("profiling"));
+}
+
+BOOST_AUTO_TEST_CASE(parallel_compilation_matches_sequential)
+{
+	std::string const inputTemplate = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nimport \"B.sol\";\ncontract A { function f() public returns (address) { return address(new B()); } }"
+			},
+			"B.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\ncontract B { uint x; function g(uint y) public { x = y * 2; } }\ncontract D is B { function h() public view returns (uint) { return x; } }"
+			},
+			"C.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nimport \"A.sol\";\ncontract C { function f() public returns (bytes memory) { new A(); return type(B).creationCode; } }"
+			}
+		},
+		"settings": {
+			"viaIR": true,
+			"optimizer": { "enabled": true },
+			"parallelism": PARALLELISM,
+			"outputSelection": { "*": { "*": ["*"] } }
+		}
+	}
+	)";
+
+	Json sequentialResult = compileWithParallelism(inputTemplate, "1");
+	BOOST_REQUIRE(containsAtMostWarnings(sequentialResult));
+	BOOST_REQUIRE(getContractResult(sequentialResult, "C.sol", "C")["evm"]["bytecode"]["object"].is_string());
+	checkParallelCompilation(inputTemplate, sequentialResult);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_parsing_matches_sequential)
+{
+	std::string const inputTemplate = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nimport {B as BB} from \"B.sol\";\n/// @title A\ncontract A is BB { function f() public returns (uint r) { assembly { r := add(sload(0), 1) } } }"
+			},
+			"B.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nstruct S { uint a; }\ncontract B { S s; event E(uint); function g(uint y) public { s.a = y; emit E(y); } }"
+			},
+			"C.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nimport \"A.sol\";\ncontract C { function f() public returns (bytes memory) { new A(); return type(A).creationCode; } }"
+			},
+			"D.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nimport \"C.sol\";\ncontract D is C { mapping(uint => uint[]) m; function h() public view returns (uint) { return m[1].length; } }"
+			}
+		},
+		"settings": {
+			"parallelism": PARALLELISM,
+			"outputSelection": { "*": { "": ["ast"], "*": ["abi", "evm.methodIdentifiers"] } }
+		}
+	}
+	)";
+
+	Json sequentialResult = compileWithParallelism(inputTemplate, "1");
+	BOOST_REQUIRE(containsAtMostWarnings(sequentialResult));
+	BOOST_REQUIRE(sequentialResult["sources"]["D.sol"]["ast"].is_object());
+	BOOST_CHECK(sequentialResult["sources"]["A.sol"]["id"] == 0);
+	BOOST_CHECK(sequentialResult["sources"]["D.sol"]["id"] == 3);
+	checkParallelCompilation(inputTemplate, sequentialResult);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_parsing_of_imported_sources_matches_sequential)
+{
+	// Only A.sol is given, the other sources are loaded via the callback in three further waves:
+	// {B.sol, C.sol}, {D.sol, E.sol} and {F.sol}.
+	std::map<std::string, std::string> const importedSources{
+		{"B.sol", "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nimport \"D.sol\";\ncontract B is D { function b() public pure returns (uint) { return 2; } }"},
+		{"C.sol", "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nimport \"D.sol\";\nimport \"E.sol\";\ncontract C is E { function c() public returns (uint) { return new D().d(); } }"},
+		{"D.sol", "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nimport \"F.sol\";\ncontract D { function d() public pure returns (uint) { return F_VALUE; } }"},
+		{"E.sol", "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nimport \"F.sol\";\ncontract E { event Ev(uint); function e() public { emit Ev(F_VALUE); } }"},
+		{"F.sol", "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nuint constant F_VALUE = 6;"}
+	};
+	ReadCallback::Callback readFile = [&](std::string const& _kind, std::string const& _path) -> ReadCallback::Result {
+		if (_kind != ReadCallback::kindString(ReadCallback::Kind::ReadFile) || !importedSources.count(_path))
+			return ReadCallback::Result{false, "File not found: " + _path};
+		return ReadCallback::Result{true, importedSources.at(_path)};
+	};
+	std::string const inputTemplate = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nimport \"B.sol\";\nimport \"C.sol\";\ncontract A is B, C { function a() public pure returns (uint) { return F_VALUE; } }"
+			}
+		},
+		"settings": {
+			"parallelism": PARALLELISM,
+			"outputSelection": { "*": { "": ["ast"], "*": ["abi", "evm.methodIdentifiers"] } }
+		}
+	}
+	)";
+
+	Json sequentialResult = compileWithParallelism(inputTemplate, "1", readFile);
+	BOOST_REQUIRE(containsAtMostWarnings(sequentialResult));
+	for (std::string sourceName: {"A.sol", "B.sol", "C.sol", "D.sol", "E.sol", "F.sol"})
+		BOOST_REQUIRE(sequentialResult["sources"][sourceName]["ast"].is_object());
+	BOOST_CHECK(sequentialResult["sources"]["F.sol"]["id"] == 5);
+	checkParallelCompilation(inputTemplate, sequentialResult, readFile);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_parsing_keeps_error_limit)
+{
+	// Every source has a parser error, which together exceed the limit of 256 errors.
+	std::string sources;
+	for (size_t i = 0; i < 300; ++i)
+		sources += (i > 0 ? ", \"S" : "\"S") + std::to_string(i) + ".sol\": { \"content\": \"contract\" }";
+	std::string const inputTemplate =
+		R"({ "language": "Solidity", "sources": { )" + sources + R"( }, "settings": { "parallelism": PARALLELISM } })";
+
+	Json sequentialResult = compileWithParallelism(inputTemplate, "1");
+	size_t errorCount = 0;
+	for (Json const& error: sequentialResult["errors"])
+		if (error["severity"] == "error")
+			++errorCount;
+	BOOST_CHECK_EQUAL(errorCount, 256);
+	BOOST_CHECK(containsError(sequentialResult, "Warning", "There are more than 256 errors. Aborting."));
+	checkParallelCompilation(inputTemplate, sequentialResult);
+}
+
+BOOST_AUTO_TEST_CASE(via_ir_bytecode_does_not_depend_on_optimized_ir_output)
+{
+	std::string const inputTemplate = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\ncontract B { uint x; function g(uint y) public { x = y * 2; } }\ncontract A { function f() public returns (address) { return address(new B()); } }"
+			}
+		},
+		"settings": {
+			"viaIR": true,
+			"optimizer": { "enabled": true },
+			"outputSelection": { "*": { "*": [OUTPUTS] } }
+		}
+	}
+	)";
+
+	auto compileWithOutputs = [&](std::string const& _outputs) {
+		std::string input = inputTemplate;
+		input.replace(input.find("OUTPUTS"), std::string("OUTPUTS").size(), _outputs);
+		return compile(input);
+	};
+
+	Json bytecodeOnly = compileWithOutputs(R"("evm.bytecode", "evm.deployedBytecode")");
+	Json withOptimizedIR = compileWithOutputs(R"("evm.bytecode", "evm.deployedBytecode", "irOptimized")");
+	BOOST_REQUIRE(containsAtMostWarnings(bytecodeOnly));
+	BOOST_REQUIRE(containsAtMostWarnings(withOptimizedIR));
+	for (std::string contractName: {"A", "B"})
+	{
+		Json const& contractWithoutIR = getContractResult(bytecodeOnly, "A.sol", contractName);
+		Json const& contractWithIR = getContractResult(withOptimizedIR, "A.sol", contractName);
+		BOOST_CHECK(!contractWithoutIR.contains("irOptimized"));
+		BOOST_REQUIRE(contractWithIR["irOptimized"].is_string());
+		BOOST_CHECK(!contractWithIR["irOptimized"].get<std::string>().empty());
+		BOOST_CHECK(contractWithoutIR["evm"] == contractWithIR["evm"]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_cache_invalid_directory)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{ "": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } },
+		"settings":
+		{
+			"optimizerCache": { "sizeLimit": 1000 }
+		}
+	}
+	)";
+	Json result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.optimizerCache.directory\" must be a string."));
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_cache_does_not_change_output)
+{
+	char const* inputWithoutCache = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\ncontract B { uint x; function g(uint y) public { x = y * 2; } }\ncontract A { function f() public returns (address) { return address(new B()); } }"
+			}
+		},
+		"settings": {
+			"viaIR": true,
+			"optimizer": { "enabled": true },
+			"outputSelection": { "*": { "*": ["evm.bytecode", "evm.deployedBytecode", "irOptimized"] } }
+		}
+	}
+	)";
+
+	util::TemporaryDirectory tempDir("solidity-optimizer-cache-test");
+	Json input;
+	BOOST_REQUIRE(util::jsonParseStrict(inputWithoutCache, input));
+	Json expectedResult = compile(util::jsonCompactPrint(input));
+	BOOST_REQUIRE(containsAtMostWarnings(expectedResult));
+
+	input["settings"]["optimizerCache"]["directory"] = tempDir.path().string();
+	BOOST_CHECK(compile(util::jsonCompactPrint(input)) == expectedResult);
+	BOOST_CHECK(!boost::filesystem::is_empty(tempDir.path()));
+	// The second compilation only uses entries loaded from disk.
+	BOOST_CHECK(compile(util::jsonCompactPrint(input)) == expectedResult);
+}
+
+BOOST_AUTO_TEST_CASE(parsed_source_cache_does_not_change_output)
+{
+	std::string const inputTemplate = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nimport \"B.sol\";\ncontract A is B { function f() public returns (uint) { return VALUE; } }"
+			},
+			"B.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nstruct S { uint a; }\ncontract B { S s; event E(uint); function g(uint y) public returns (uint r) { s.a = y; emit E(y); assembly { r := sload(0) } } }"
+			}
+		},
+		"settings": {
+			"outputSelection": { "*": { "": ["ast"], "*": ["abi", "storageLayout", "evm.bytecode.object", "evm.methodIdentifiers"] } }
+		}
+	}
+	)";
+	auto inputWithValue = [&](std::string const& _value) {
+		std::string input = inputTemplate;
+		input.replace(input.find("VALUE"), std::string("VALUE").size(), _value);
+		return input;
+	};
+	// The cached source units contain inline assembly, which refers to Yul strings.
+	yul::YulStringRepository::Scope yulStringScope;
+	auto parsedSourceCache = std::make_shared<ParsedSourceCache>();
+	auto compileWithCache = [&](std::string const& _input) {
+		frontend::StandardCompiler compiler(ReadCallback::Callback(), util::JsonFormat{}, nullptr, parsedSourceCache);
+		Json result;
+		BOOST_REQUIRE(util::jsonParseStrict(compiler.compile(_input), result));
+		return result;
+	};
+
+	Json expectedResult = compile(inputWithValue("1"));
+	BOOST_REQUIRE(containsAtMostWarnings(expectedResult));
+	BOOST_CHECK(compileWithCache(inputWithValue("1")) == expectedResult);
+	BOOST_CHECK_EQUAL(parsedSourceCache->size(), 2);
+	// Both source units are reused and analyzed again.
+	BOOST_CHECK(compileWithCache(inputWithValue("1")) == expectedResult);
+
+	// A.sol is parsed again and the node IDs of the reused B.sol change.
+	expectedResult = compile(inputWithValue("x + 1; } uint x; function h() public { x = 2"));
+	BOOST_REQUIRE(containsAtMostWarnings(expectedResult));
+	BOOST_CHECK(compileWithCache(inputWithValue("x + 1; } uint x; function h() public { x = 2")) == expectedResult);
+	BOOST_CHECK_EQUAL(parsedSourceCache->size(), 2);
+}
+
 BOOST_AUTO_TEST_CASE(dependency_tracking_of_abstract_contract)
 {
 	char const* input = R"(
@@ -1782,6 +2149,41 @@ BOOST_AUTO_TEST_CASE(source_location_of_bare_block)
 	BOOST_REQUIRE(sourceMap.find(sourceRef) != std::string::npos);
 }
 
+BOOST_AUTO_TEST_CASE(streamed_output_matches_output)
+{
+	std::string const input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"a.sol": {"content": "contract B { function f() public {} } contract A { uint x; }"},
+			"a.sol.b": {"content": "import \"a.sol\"; contract C is A {}"},
+			"b.sol": {"content": "contract D { function g() public { uint y; } }"}
+		},
+		"settings": {
+			"outputSelection": {
+				"*": {"*": ["*"], "": ["ast"]}
+			}
+		}
+	}
+	)";
+
+	for (util::JsonFormat const& format: {util::JsonFormat{util::JsonFormat::Compact}, util::JsonFormat{util::JsonFormat::Pretty, 4}})
+	{
+		frontend::StandardCompiler compiler({}, format);
+		std::ostringstream streamedOutput;
+		BOOST_TEST(compiler.compile(input, streamedOutput));
+		BOOST_TEST(streamedOutput.str() == compiler.compile(input));
+	}
+
+	frontend::StandardCompiler compiler;
+	for (std::string const& invalidInput: {"invalid"s, "{}"s, R"({"language": "Yul", "sources": {"a.yul": {"content": "{}"}}})"s})
+	{
+		std::ostringstream streamedOutput;
+		BOOST_TEST(compiler.compile(invalidInput, streamedOutput));
+		BOOST_TEST(streamedOutput.str() == compiler.compile(invalidInput));
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
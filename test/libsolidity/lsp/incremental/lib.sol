@@ -0,0 +1,10 @@
+// SPDX-License-Identifier: UNLICENSED
+pragma solidity >=0.8.0;
+
+library L
+{
+    function f() internal view returns (uint)
+    {
+        return block.number;
+    }
+}
@@ -0,0 +1,10 @@
+// SPDX-License-Identifier: UNLICENSED
+pragma solidity >=0.8.0;
+
+contract Other
+{
+    function h(uint a) public pure returns (uint)
+    {
+        return a;
+    }
+}
@@ -0,0 +1,12 @@
+// SPDX-License-Identifier: UNLICENSED
+pragma solidity >=0.8.0;
+
+import "./lib.sol";
+
+contract User
+{
+    function g() public view returns (uint)
+    {
+        return L.f();
+    }
+}
@@ -13,6 +13,8 @@ contract C {
         }
     }
 }
+// ====
+// ssaCFGCodeTransform: true
 // ----
 // f(uint256): 0 -> 2
 // f(uint256): 1 -> 18
@@ -15,6 +15,8 @@ contract C {
         }
     }
 }
+// ====
+// ssaCFGCodeTransform: true
 // ----
 // f(uint256): 0 -> 1
 // f(uint256): 1 -> 1
@@ -10,5 +10,7 @@ contract test {
         return 42;
     }
 }
+// ====
+// ssaCFGCodeTransform: true
 // ----
 // f() -> 42
@@ -26,6 +26,8 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <sstream>
+
 
 namespace solidity::util::test
 {
@@ -117,6 +119,40 @@ BOOST_AUTO_TEST_CASE(json_compact_print)
 	BOOST_CHECK(R"({"1":1,"2":"2","3":{"3.1":"3.1","3.2":2},"4":"\u0911 \u0912 \u0913 \u0914 \u0915 \u0916","5":"\u0010","6":"\u4e2d"})" == jsonCompactPrint(json));
 }
 
+BOOST_AUTO_TEST_CASE(json_stream_writer)
+{
+	Json json;
+	json["a"]["b"]["c"] = 1;
+	json["a"]["b"]["d"] = Json::array({1, "2", Json::object()});
+	json["a"]["e"] = Json::object();
+	json["f"] = "\u4e2d";
+	json["g"]["h"] = {{"i", {{"j", true}}}};
+
+	for (JsonFormat const& format: {JsonFormat{JsonFormat::Compact}, JsonFormat{JsonFormat::Pretty}, JsonFormat{JsonFormat::Pretty, 4}})
+	{
+		std::ostringstream stream;
+		JsonStreamWriter writer(stream, format);
+		writer.write({"a", "b", "c"}, json["a"]["b"]["c"]);
+		writer.write({"a", "b", "d"}, json["a"]["b"]["d"]);
+		writer.write({"a", "e"}, json["a"]["e"]);
+		writer.write({"f"}, json["f"]);
+		writer.write({"g", "h"}, json["g"]["h"]);
+		writer.finish();
+		BOOST_CHECK_EQUAL(stream.str(), jsonPrint(json, format));
+	}
+
+	std::ostringstream stream;
+	JsonStreamWriter emptyWriter(stream, JsonFormat{JsonFormat::Pretty});
+	emptyWriter.finish();
+	BOOST_CHECK_EQUAL(stream.str(), jsonPrettyPrint(Json::object()));
+
+	JsonStreamWriter unorderedWriter(stream, JsonFormat{});
+	unorderedWriter.write({"b", "c"}, 1);
+	BOOST_CHECK_THROW(unorderedWriter.write({"a"}, 1), Exception);
+	BOOST_CHECK_THROW(unorderedWriter.write({"b", "c"}, 1), Exception);
+	BOOST_CHECK_THROW(unorderedWriter.write({"b"}, 1), Exception);
+}
+
 BOOST_AUTO_TEST_CASE(parse_json_strict)
 {
 	// In this test we check conformance against JSON.parse (https://tc39.es/ecma262/multipage/structured-data.html#sec-json.parse)
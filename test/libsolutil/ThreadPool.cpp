@@ -0,0 +1,145 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for ThreadPool.
+ */
+
+#include <libsolutil/ThreadPool.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ThreadPoolTest)
+
+BOOST_AUTO_TEST_CASE(no_threads_runs_inline)
+{
+	ThreadPool pool(0);
+	BOOST_CHECK_EQUAL(pool.size(), 0);
+
+	std::thread::id executingThread;
+	std::future<int> result = pool.submit([&]() { executingThread = std::this_thread::get_id(); return 42; });
+	BOOST_CHECK(executingThread == std::this_thread::get_id());
+	BOOST_CHECK_EQUAL(result.get(), 42);
+}
+
+BOOST_AUTO_TEST_CASE(results_and_exceptions)
+{
+	ThreadPool pool(4);
+	BOOST_CHECK_EQUAL(pool.size(), 4);
+
+	std::vector<std::future<size_t>> results;
+	for (size_t i = 0; i < 100; ++i)
+		results.emplace_back(pool.submit([i]() { return i * i; }));
+	std::future<void> failure = pool.submit([]() { throw std::runtime_error("failure"); });
+
+	for (size_t i = 0; i < results.size(); ++i)
+		BOOST_CHECK_EQUAL(results[i].get(), i * i);
+	BOOST_CHECK_THROW(failure.get(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(waiting_for_earlier_tasks)
+{
+	ThreadPool pool(2);
+
+	std::vector<std::shared_future<void>> tasks;
+	std::atomic<size_t> completed = 0;
+	for (size_t i = 0; i < 20; ++i)
+	{
+		std::vector<std::shared_future<void>> earlierTasks = tasks;
+		tasks.emplace_back(pool.submit([&completed, earlierTasks, i]() {
+			for (auto const& task: earlierTasks)
+				task.wait();
+			BOOST_CHECK_EQUAL(completed.load(), i);
+			++completed;
+		}).share());
+	}
+	for (auto const& task: tasks)
+		task.wait();
+	BOOST_CHECK_EQUAL(completed.load(), 20);
+}
+
+BOOST_AUTO_TEST_CASE(destructor_finishes_pending_tasks)
+{
+	std::atomic<size_t> completed = 0;
+	{
+		ThreadPool pool(3);
+		for (size_t i = 0; i < 50; ++i)
+			pool.submit([&]() { ++completed; });
+	}
+	BOOST_CHECK_EQUAL(completed.load(), 50);
+}
+
+BOOST_AUTO_TEST_CASE(run_all_nested)
+{
+	ThreadPool pool(2);
+
+	// Every task of the pool waits for tasks of its own, which must not deadlock
+	// even though there are more waiting tasks than worker threads.
+	std::atomic<size_t> completed = 0;
+	std::vector<std::future<void>> outerTasks;
+	for (size_t i = 0; i < 8; ++i)
+		outerTasks.emplace_back(pool.submit([&]() {
+			std::vector<std::function<void()>> innerTasks;
+			for (size_t j = 0; j < 4; ++j)
+				innerTasks.emplace_back([&]() { ++completed; });
+			pool.runAll(std::move(innerTasks));
+		}));
+	for (auto& task: outerTasks)
+		task.get();
+	BOOST_CHECK_EQUAL(completed.load(), 32);
+}
+
+BOOST_AUTO_TEST_CASE(run_all_exceptions)
+{
+	ThreadPool pool(3);
+
+	std::atomic<size_t> completed = 0;
+	std::vector<std::function<void()>> tasks;
+	for (size_t i = 0; i < 10; ++i)
+		tasks.emplace_back([&completed, i]() {
+			++completed;
+			if (i % 3 == 1)
+				throw std::runtime_error("failure " + std::to_string(i));
+		});
+	try
+	{
+		pool.runAll(std::move(tasks));
+		BOOST_FAIL("Expected an exception.");
+	}
+	catch (std::runtime_error const& _exception)
+	{
+		BOOST_CHECK_EQUAL(std::string(_exception.what()), "failure 1");
+	}
+	BOOST_CHECK_EQUAL(completed.load(), 10);
+}
+
+BOOST_AUTO_TEST_CASE(thread_count_for_jobs)
+{
+	BOOST_CHECK_EQUAL(ThreadPool::threadCountForJobs(1), 0);
+	BOOST_CHECK_EQUAL(ThreadPool::threadCountForJobs(4), 4);
+	BOOST_CHECK(ThreadPool::threadCountForJobs(0) != 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -240,6 +240,25 @@ BOOST_AUTO_TEST_CASE(invalid_param_rendered)
 	BOOST_CHECK_EQUAL(m.render(), templ);
 }
 
+BOOST_AUTO_TEST_CASE(same_template_rendered_with_different_values)
+{
+	std::string templ = "<?c><a><!c><#l><a><b></l></c>";
+	std::vector<std::map<std::string, std::string>> list(2);
+	list[0]["b"] = "1";
+	list[1]["b"] = "2";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", true)("a", "A")("l", list).render(), "A");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", false)("a", "B")("l", list).render(), "B1B2");
+	Whiskers missingList(templ);
+	missingList("c", false)("a", "B");
+	BOOST_CHECK_THROW(missingList.render(), WhiskersError);
+}
+
+BOOST_AUTO_TEST_CASE(incomplete_elements_are_text)
+{
+	std::string templ = "<?c>x</c> </c> <!c> <#l> <?d> <a> < b>";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", true)("a", "A").render(), "x </c> <!c> <#l> <?d> A < b>");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -0,0 +1,96 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the on-disk cache of optimized Yul objects.
+ */
+
+#include <libyul/PersistentObjectCache.h>
+
+#include <libsolutil/Keccak256.h>
+#include <libsolutil/TemporaryDirectory.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace solidity::util;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+size_t countEntries(boost::filesystem::path const& _directory)
+{
+	size_t count = 0;
+	for (auto const& entry: boost::filesystem::directory_iterator(_directory))
+		if (entry.path().extension() == ".yul")
+			++count;
+	return count;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(PersistentObjectCacheTest)
+
+BOOST_AUTO_TEST_CASE(store_and_load)
+{
+	TemporaryDirectory tempDir("solidity-optimizer-cache-test");
+	PersistentObjectCache cache(tempDir.path() / "cache", "1.0.0");
+
+	BOOST_CHECK(!cache.load(keccak256("a")).has_value());
+	cache.store(keccak256("a"), "{ sstore(0, 1) }");
+	BOOST_CHECK(cache.load(keccak256("a")) == std::optional<std::string>("{ sstore(0, 1) }"));
+	BOOST_CHECK(!cache.load(keccak256("b")).has_value());
+
+	// Entries survive the cache object.
+	PersistentObjectCache sameVersion(tempDir.path() / "cache", "1.0.0");
+	BOOST_CHECK(sameVersion.load(keccak256("a")) == std::optional<std::string>("{ sstore(0, 1) }"));
+}
+
+BOOST_AUTO_TEST_CASE(versions_do_not_share_entries)
+{
+	TemporaryDirectory tempDir("solidity-optimizer-cache-test");
+	PersistentObjectCache oldVersion(tempDir.path(), "1.0.0");
+	PersistentObjectCache newVersion(tempDir.path(), "1.0.1");
+
+	oldVersion.store(keccak256("a"), "{ }");
+	BOOST_CHECK(oldVersion.load(keccak256("a")).has_value());
+	BOOST_CHECK(!newVersion.load(keccak256("a")).has_value());
+}
+
+BOOST_AUTO_TEST_CASE(eviction)
+{
+	TemporaryDirectory tempDir("solidity-optimizer-cache-test");
+	std::string const code(100, ' ');
+	PersistentObjectCache cache(tempDir.path(), "1.0.0", 3 * code.size());
+
+	for (std::string key: {"a", "b", "c"})
+		cache.store(keccak256(key), code);
+	BOOST_CHECK_EQUAL(countEntries(tempDir.path()), 3);
+
+	for (std::string key: {"d", "e", "f", "g"})
+	{
+		cache.store(keccak256(key), code);
+		BOOST_CHECK_EQUAL(countEntries(tempDir.path()), 3);
+		BOOST_CHECK(cache.load(keccak256(key)).has_value());
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -34,6 +34,7 @@
 #include <libyul/optimiser/FunctionGrouper.h>
 #include <libyul/optimiser/FunctionHoister.h>
 #include <libyul/optimiser/FunctionSpecializer.h>
+#include <libyul/optimiser/GlobalValueNumberer.h>
 #include <libyul/optimiser/ExpressionInliner.h>
 #include <libyul/optimiser/FullInliner.h>
 #include <libyul/optimiser/ForLoopConditionIntoBody.h>
@@ -50,6 +51,7 @@
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/SSAReverser.h>
 #include <libyul/optimiser/SSATransform.h>
+#include <libyul/optimiser/SparseConditionalConstantPropagator.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/UnusedAssignEliminator.h>
 #include <libyul/optimiser/UnusedStoreEliminator.h>
@@ -357,6 +359,18 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			LoopInvariantCodeMotion::run(*m_context, block);
 			return block;
 		}},
+		{"sparseConditionalConstantPropagator", [&]() {
+			auto block = disambiguate();
+			updateContext(block);
+			SparseConditionalConstantPropagator::run(*m_context, block);
+			return block;
+		}},
+		{"globalValueNumberer", [&]() {
+			auto block = disambiguate();
+			updateContext(block);
+			GlobalValueNumberer::run(*m_context, block);
+			return block;
+		}},
 		{"controlFlowSimplifier", [&]() {
 			auto block = disambiguate();
 			updateContext(block);
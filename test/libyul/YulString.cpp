@@ -0,0 +1,85 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the YulString repository.
+ */
+
+#include <libyul/YulString.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStringTest)
+
+BOOST_AUTO_TEST_CASE(interning)
+{
+	YulString a("abc");
+	YulString b(std::string("ab") + "c");
+	BOOST_CHECK(a == b);
+	BOOST_CHECK(&a.str() == &b.str());
+	BOOST_CHECK(a != YulString("abd"));
+	BOOST_CHECK_EQUAL(a.hash(), YulStringRepository::hash("abc"));
+
+	BOOST_CHECK(YulString().empty());
+	BOOST_CHECK(YulString("").empty());
+	BOOST_CHECK(YulString() == YulString(""));
+	BOOST_CHECK(!a.empty());
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_interning)
+{
+	size_t const threadCount = 4;
+	size_t const stringCount = 1000;
+	std::vector<std::vector<YulString>> results(threadCount);
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < threadCount; ++i)
+		threads.emplace_back([&, i]() {
+			for (size_t j = 0; j < stringCount; ++j)
+				results[i].emplace_back("s" + std::to_string(j));
+		});
+	for (auto& thread: threads)
+		thread.join();
+
+	for (size_t j = 0; j < stringCount; ++j)
+	{
+		BOOST_CHECK_EQUAL(results[0][j].str(), "s" + std::to_string(j));
+		for (size_t i = 1; i < threadCount; ++i)
+			BOOST_CHECK(results[i][j] == results[0][j]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(reset_is_ignored_in_scope)
+{
+	YulStringRepository::Scope scope;
+	YulString a("abc");
+	{
+		YulStringRepository::Scope nestedScope;
+		YulStringRepository::reset();
+	}
+	YulStringRepository::reset();
+	BOOST_CHECK_EQUAL(a.str(), "abc");
+	BOOST_CHECK(a == YulString("abc"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -225,7 +225,7 @@ class JsonRpcProcess:
         self.trace('receive_message', json.dumps(json_object, indent=4, sort_keys=True))
         return json_object
 
-    def send_message(self, method_name: str, params: Optional[dict]) -> None:
+    def send_message(self, method_name: str, params: Optional[dict], message_id: Optional[int] = None) -> None:
         if self.process.stdin is None:
             return
         message = {
@@ -233,6 +233,8 @@ class JsonRpcProcess:
             'method': method_name,
             'params': params
         }
+        if message_id is not None:
+            message['id'] = message_id
         json_string = json.dumps(obj=message)
         rpc_message = f"Content-Length: {len(json_string)}\r\n\r\n{json_string}"
         self.trace(f'send_message ({method_name})', json.dumps(message, indent=4, sort_keys=True))
@@ -994,9 +996,17 @@ class SolidityLSPTestSuite: # {{{
         """
         Return all published diagnostic reports sorted by file URI.
         """
+        return self.wait_for_compilation(solc)[1]
+
+    def wait_for_compilation(self, solc: JsonRpcProcess) -> Tuple[List[str], List[dict]]:
+        """
+        Return the URIs of the files analysed by the compilation, which are empty if the
+        previous results were reused, and all published diagnostic reports sorted by file URI.
+        """
         reports = []
 
-        num_files = solc.receive_message()["params"]["openFileCount"]
+        trace = solc.receive_message()["params"]
+        num_files = trace["openFileCount"]
 
         for _ in range(0, num_files):
             message = solc.receive_message()
@@ -1010,7 +1020,7 @@ class SolidityLSPTestSuite: # {{{
                 )
             )
 
-        return sorted(reports, key=lambda x: x['uri'])
+        return sorted(trace["analyzedFiles"]), sorted(reports, key=lambda x: x['uri'])
 
     def normalizeUri(self, uri):
         return uri.replace(self.project_root_uri + "/", "")[:-len(".sol")]
@@ -1610,6 +1620,226 @@ class SolidityLSPTestSuite: # {{{
         self.expect_equal(len(report['diagnostics']), 0)
         # The warning went away because the compiler aborts further processing after the error.
 
+    def open_incremental_test_files(self, solc: JsonRpcProcess) -> None:
+        self.setup_lsp(solc)
+        for test_name in ['lib', 'user', 'other']:
+            self.open_file_and_wait_for_diagnostics(solc, test_name, 'incremental')
+
+    def replace_file_contents(self, solc: JsonRpcProcess, test_name: str, sub_dir: str, text: str) -> None:
+        solc.send_message(
+            'textDocument/didChange',
+            {
+                'textDocument': {
+                    'uri': self.get_test_file_uri(test_name, sub_dir)
+                },
+                'contentChanges': [
+                    {
+                        'text': text
+                    }
+                ]
+            }
+        )
+
+    def test_didChange_reanalyzes_importing_files(self, solc: JsonRpcProcess) -> None:
+        self.open_incremental_test_files(solc)
+        lib = self.get_test_file_contents('lib', 'incremental')
+        self.replace_file_contents(
+            solc,
+            'lib',
+            'incremental',
+            lib.replace('view', 'pure').replace('block.number', '1')
+        )
+        analyzed_files, published_diagnostics = self.wait_for_compilation(solc)
+
+        # Only the changed file and the file importing it are analysed again.
+        self.expect_equal(
+            analyzed_files,
+            sorted([self.get_test_file_uri('lib', 'incremental'), self.get_test_file_uri('user', 'incremental')]),
+            "Analysed files"
+        )
+        self.expect_equal(len(published_diagnostics), 3, "Diagnostic reports for 3 files")
+        report = published_diagnostics[2]
+        self.expect_equal(report['uri'], self.get_test_file_uri('user', 'incremental'))
+        # The function calling the library can be pure now.
+        self.expect_equal([diagnostic['code'] for diagnostic in report['diagnostics']], [2018])
+        for report in published_diagnostics[:2]:
+            self.expect_equal(len(report['diagnostics']), 0, "no diagnostics")
+
+    def test_request_after_partial_reanalysis(self, solc: JsonRpcProcess) -> None:
+        self.open_incremental_test_files(solc)
+        lib = self.get_test_file_contents('lib', 'incremental')
+        self.replace_file_contents(
+            solc,
+            'lib',
+            'incremental',
+            lib.replace('view', 'pure').replace('block.number', '1')
+        )
+        analyzed_files, _ = self.wait_for_compilation(solc)
+        self.expect_equal(
+            analyzed_files,
+            sorted([self.get_test_file_uri('lib', 'incremental'), self.get_test_file_uri('user', 'incremental')]),
+            "Analysed files"
+        )
+
+        # The file that was not analysed again is analysed for the request.
+        solc.send_message(
+            'textDocument/hover',
+            {
+                'textDocument': {
+                    'uri': self.get_test_file_uri('other', 'incremental')
+                },
+                'position': {
+                    'line': 7,
+                    'character': 15
+                }
+            },
+            message_id=1
+        )
+        response = solc.receive_message()
+        self.expect_equal(response['id'], 1)
+        self.expect_equal(response['result']['contents']['value'], "```solidity\nuint256\n```\n\n")
+
+    def test_didChange_without_changes_reuses_analysis(self, solc: JsonRpcProcess) -> None:
+        self.open_incremental_test_files(solc)
+        self.replace_file_contents(solc, 'user', 'incremental', self.get_test_file_contents('user', 'incremental'))
+        analyzed_files, published_diagnostics = self.wait_for_compilation(solc)
+
+        self.expect_equal(analyzed_files, [], "No file analysed")
+        self.expect_equal(len(published_diagnostics), 3, "Diagnostic reports for 3 files")
+        for report in published_diagnostics:
+            self.expect_equal(len(report['diagnostics']), 0, "no diagnostics")
+
+    def test_didChange_causing_error_falls_back_to_full_compilation(self, solc: JsonRpcProcess) -> None:
+        self.open_incremental_test_files(solc)
+        other = self.get_test_file_contents('other', 'incremental')
+        self.replace_file_contents(solc, 'other', 'incremental', other.replace('return a;', 'return b;'))
+        analyzed_files, published_diagnostics = self.wait_for_compilation(solc)
+
+        # The error stops the analysis, so the results of the other files cannot be kept.
+        self.expect_equal(
+            analyzed_files,
+            sorted(self.get_test_file_uri(test_name, 'incremental') for test_name in ['lib', 'user', 'other']),
+            "Analysed files"
+        )
+        self.expect_equal(len(published_diagnostics), 3, "Diagnostic reports for 3 files")
+        report = published_diagnostics[1]
+        self.expect_equal(report['uri'], self.get_test_file_uri('other', 'incremental'))
+        self.expect_equal([diagnostic['code'] for diagnostic in report['diagnostics']], [7576])
+
+    def test_didChange_in_quick_succession_compiles_once(self, solc: JsonRpcProcess) -> None:
+        self.open_incremental_test_files(solc)
+        other = self.get_test_file_contents('other', 'incremental')
+        # The intermediate states contain errors, but only the last one is compiled, which
+        # is the same as before.
+        self.replace_file_contents(solc, 'other', 'incremental', other.replace('return a;', 'return b;'))
+        self.replace_file_contents(solc, 'other', 'incremental', other.replace('return a;', 'return c;'))
+        self.replace_file_contents(solc, 'other', 'incremental', other)
+        analyzed_files, published_diagnostics = self.wait_for_compilation(solc)
+
+        self.expect_equal(analyzed_files, [], "No file analysed")
+        self.expect_equal(len(published_diagnostics), 3, "Diagnostic reports for 3 files")
+        for report in published_diagnostics:
+            self.expect_equal(len(report['diagnostics']), 0, "no diagnostics")
+
+        # No further compilation publishes diagnostics before the request is answered.
+        solc.send_message(
+            'textDocument/hover',
+            {
+                'textDocument': {
+                    'uri': self.get_test_file_uri('other', 'incremental')
+                },
+                'position': {
+                    'line': 7,
+                    'character': 15
+                }
+            },
+            message_id=1
+        )
+        response = solc.receive_message()
+        self.expect_equal(response['id'], 1)
+        self.expect_true('result' in response, "Request answered")
+
+    def hover_other_incremental_test_file(self, solc: JsonRpcProcess, message_id: int) -> None:
+        solc.send_message(
+            'textDocument/hover',
+            {
+                'textDocument': {
+                    'uri': self.get_test_file_uri('other', 'incremental')
+                },
+                'position': {
+                    'line': 7,
+                    'character': 15
+                }
+            },
+            message_id=message_id
+        )
+
+    def test_request_on_changed_document_waits_for_compilation(self, solc: JsonRpcProcess) -> None:
+        self.open_incremental_test_files(solc)
+        other = self.get_test_file_contents('other', 'incremental')
+        self.replace_file_contents(solc, 'other', 'incremental', other.replace('uint a', 'uint8 a'))
+        # The last analysis does not belong to the changed document anymore.
+        self.hover_other_incremental_test_file(solc, message_id=1)
+
+        self.wait_for_compilation(solc)
+        response = solc.receive_message()
+        self.expect_equal(response['id'], 1)
+        self.expect_equal(response['result']['contents']['value'], "```solidity\nuint8\n```\n\n")
+
+    def test_request_on_changed_document_fails_if_compilation_fails(self, solc: JsonRpcProcess) -> None:
+        self.open_incremental_test_files(solc)
+        other = self.get_test_file_contents('other', 'incremental')
+        self.replace_file_contents(solc, 'other', 'incremental', other.replace('return a;', 'return b;'))
+        self.hover_other_incremental_test_file(solc, message_id=1)
+
+        _, published_diagnostics = self.wait_for_compilation(solc)
+        report = published_diagnostics[1]
+        self.expect_equal(report['uri'], self.get_test_file_uri('other', 'incremental'))
+        self.expect_equal([diagnostic['code'] for diagnostic in report['diagnostics']], [7576])
+
+        # The request is not answered from the analysis of the previous version of the document.
+        response = solc.receive_message()
+        self.expect_equal(response['id'], 1)
+        self.expect_equal(response['error']['code'], -32801, "Content modified")
+
+    def test_cancelRequest_answers_request_waiting_for_compilation(self, solc: JsonRpcProcess) -> None:
+        self.setup_lsp(solc)
+        solc.send_message(
+            'textDocument/didOpen',
+            {
+                'textDocument': {
+                    'uri': self.get_test_file_uri('other', 'incremental'),
+                    'languageId': 'Solidity',
+                    'version': 1,
+                    'text': self.get_test_file_contents('other', 'incremental')
+                }
+            }
+        )
+        # Requests wait for the first compilation, which only starts after a delay.
+        solc.send_message(
+            'textDocument/hover',
+            {
+                'textDocument': {
+                    'uri': self.get_test_file_uri('other', 'incremental')
+                },
+                'position': {
+                    'line': 7,
+                    'character': 15
+                }
+            },
+            message_id=1
+        )
+        solc.send_message('$/cancelRequest', {'id': 1})
+
+        response = solc.receive_message()
+        self.expect_equal(response['id'], 1)
+        self.expect_equal(response['error']['code'], -32800, "Request cancelled")
+
+        # The compilation is not affected by the cancelled request.
+        published_diagnostics = self.wait_for_diagnostics(solc)
+        self.expect_equal(len(published_diagnostics), 1, "Diagnostic report for 1 file")
+        self.expect_equal(len(published_diagnostics[0]['diagnostics']), 0, "no diagnostics")
+
     def test_textDocument_didOpen_with_relative_import_without_project_url(self, solc: JsonRpcProcess) -> None:
         self.setup_lsp(solc, expose_project_root=False)
         TEST_NAME = 'didOpen_with_import'
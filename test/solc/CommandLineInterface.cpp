@@ -153,6 +153,7 @@ BOOST_AUTO_TEST_CASE(multiple_input_modes)
 		"--license",
 		"--version",
 		"--standard-json",
+		"--standard-json-server",
 		"--link",
 		"--assemble",
 		"--strict-assembly",
@@ -161,7 +162,7 @@ BOOST_AUTO_TEST_CASE(multiple_input_modes)
 	};
 	std::string expectedMessage =
 		"The following options are mutually exclusive: "
-		"--help, --license, --version, --standard-json, --link, --assemble, --strict-assembly, --import-ast, --lsp, --import-asm-json. "
+		"--help, --license, --version, --standard-json, --standard-json-server, --link, --assemble, --strict-assembly, --import-ast, --lsp, --import-asm-json. "
 		"Select at most one.";
 
 	for (auto const& mode1: inputModeOptions)
@@ -442,6 +443,43 @@ BOOST_AUTO_TEST_CASE(standard_json_remapping)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(standard_json_server_input_file)
+{
+	std::string expectedMessage =
+		"--standard-json-server does not accept input files. It reads requests from standard input.";
+
+	BOOST_CHECK_EXCEPTION(
+		parseCommandLineAndReadInputFiles({"solc", "--standard-json-server", "input.json"}),
+		CommandLineValidationError,
+		[&](auto const& _exception) { BOOST_TEST(_exception.what() == expectedMessage); return true; }
+	);
+}
+
+BOOST_AUTO_TEST_CASE(standard_json_server_multiple_requests)
+{
+	std::string const request =
+		R"({"language": "Solidity", "sources": {"A.sol": {"content": "contract C { function f() public {} }"}}, )"
+		R"("settings": {"optimizer": {"enabled": true}, "outputSelection": {"*": {"*": ["evm.bytecode.object"]}}}})";
+
+	OptionsReaderAndMessages result = runCLI({"solc", "--standard-json-server"}, request + "\n\n" + request + "\n");
+	BOOST_REQUIRE(result.success);
+	BOOST_TEST(result.stderrContent == "");
+
+	std::vector<std::string> lines;
+	boost::split(lines, boost::trim_copy(result.stdoutContent), boost::is_any_of("\n"));
+	BOOST_REQUIRE(lines.size() == 2);
+
+	std::vector<std::string> bytecodes;
+	for (std::string const& line: lines)
+	{
+		Json output;
+		BOOST_REQUIRE(util::jsonParseStrict(line, output));
+		bytecodes.push_back(output["contracts"]["A.sol"]["C"]["evm"]["bytecode"]["object"].get<std::string>());
+	}
+	BOOST_TEST(!bytecodes[0].empty());
+	BOOST_TEST(bytecodes[0] == bytecodes[1]);
+}
+
 BOOST_AUTO_TEST_CASE(cli_paths_to_source_unit_names_no_base_path)
 {
 	TemporaryDirectory tempDirCurrent(TEST_CASE_NAME);
@@ -120,8 +120,10 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--evm-version=spuriousDragon",
 			"--via-ir",
 			"--experimental-via-ir",
+			"--jobs=4",
 			"--revert-strings=strip",
 			"--debug-info=location",
+			"--profile-json=/tmp/profile.json",
 			"--pretty-json",
 			"--json-indent=7",
 			"--no-color",
@@ -143,15 +145,20 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--optimize-yul",
 			"--optimize-runs=1000",
 			"--yul-optimizations=agf",
+			"--optimizer-cache-dir=/tmp/cache",
+			"--optimizer-cache-size-limit=1000",
 			"--model-checker-bmc-loop-iterations=2",
 			"--model-checker-contracts=contract1.yul:A,contract2.yul:B",
 			"--model-checker-div-mod-no-slacks",
 			"--model-checker-engine=bmc",
 			"--model-checker-ext-calls=trusted",
 			"--model-checker-invariants=contract,reentrancy",
+			"--model-checker-jobs=3",
+			"--model-checker-race-solvers",
 			"--model-checker-show-proved-safe",
 			"--model-checker-show-unproved",
 			"--model-checker-show-unsupported",
+			"--model-checker-solver-sessions",
 			"--model-checker-solvers=z3,smtlib2",
 			"--model-checker-targets=underflow,divByZero",
 			"--model-checker-timeout=5"
@@ -181,6 +188,8 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		expectedOptions.output.overwriteFiles = true;
 		expectedOptions.output.evmVersion = EVMVersion::spuriousDragon();
 		expectedOptions.output.viaIR = true;
+		expectedOptions.output.parallelism = 4;
+		expectedOptions.output.profileFile = "/tmp/profile.json";
 		expectedOptions.output.revertStrings = RevertStrings::Strip;
 		expectedOptions.output.debugInfoSelection = DebugInfoSelection::fromString("location");
 		expectedOptions.formatting.json = JsonFormat{JsonFormat::Pretty, 7};
@@ -209,6 +218,8 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		expectedOptions.optimizer.optimizeYul = true;
 		expectedOptions.optimizer.expectedExecutionsPerDeployment = 1000;
 		expectedOptions.optimizer.yulSteps = "agf";
+		expectedOptions.optimizer.cacheDirectory = "/tmp/cache";
+		expectedOptions.optimizer.cacheSizeLimit = 1000;
 
 		expectedOptions.modelChecker.initialize = true;
 		expectedOptions.modelChecker.settings = {
@@ -218,10 +229,13 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			{true, false},
 			{ModelCheckerExtCalls::Mode::TRUSTED},
 			{{InvariantType::Contract, InvariantType::Reentrancy}},
+			3, // --model-checker-jobs
 			false, // --model-checker-print-query
+			true, // --model-checker-race-solvers
 			true,
 			true,
 			true,
+			true, // --model-checker-solver-sessions
 			{false, false, true, true},
 			{{VerificationTargetType::Underflow, VerificationTargetType::DivByZero}},
 			5,
@@ -267,6 +281,31 @@ BOOST_AUTO_TEST_CASE(via_ir_options)
 		BOOST_TEST(parseCommandLine({"solc", viaIrOption, "contract.sol"}).output.viaIR);
 }
 
+BOOST_AUTO_TEST_CASE(jobs)
+{
+	BOOST_TEST(parseCommandLine({"solc", "contract.sol"}).output.parallelism == 1);
+	BOOST_TEST(parseCommandLine({"solc", "--jobs=0", "contract.sol"}).output.parallelism == 0);
+	BOOST_TEST(parseCommandLine({"solc", "--jobs", "8", "contract.sol"}).output.parallelism == 8);
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_cache)
+{
+	CommandLineOptions defaultOptions = parseCommandLine({"solc", "contract.sol"});
+	BOOST_TEST(!defaultOptions.optimizer.cacheDirectory.has_value());
+	BOOST_TEST(defaultOptions.optimizer.cacheSizeLimit == yul::PersistentObjectCache::defaultSizeLimit);
+
+	CommandLineOptions options = parseCommandLine({"solc", "--optimizer-cache-dir", "cache", "contract.sol"});
+	BOOST_CHECK(options.optimizer.cacheDirectory == boost::filesystem::path("cache"));
+
+	BOOST_CHECK_EXCEPTION(
+		parseCommandLine({"solc", "--optimizer-cache-size-limit=1000", "contract.sol"}),
+		CommandLineValidationError,
+		[](CommandLineValidationError const& _exception) {
+			return std::string(_exception.what()) == "Option --optimizer-cache-size-limit can only be used together with --optimizer-cache-dir.";
+		}
+	);
+}
+
 BOOST_AUTO_TEST_CASE(assembly_mode_options)
 {
 	static std::vector<std::tuple<std::vector<std::string>, YulStack::Machine, YulStack::Language>> const allowedCombinations = {
@@ -423,14 +462,19 @@ BOOST_AUTO_TEST_CASE(invalid_options_input_modes_combinations)
 		// TODO: This should eventually contain all options.
 		{"--experimental-via-ir", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--via-ir", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
+		{"--jobs=4", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
+		{"--optimizer-cache-dir=/tmp/cache", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--metadata-literal", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--metadata-hash=swarm", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-show-proved-safe", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-show-unproved", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-race-solvers", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-show-unsupported", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-solver-sessions", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-div-mod-no-slacks", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-engine=bmc", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-invariants=contract,reentrancy", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-jobs=3", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-solvers=z3,smtlib2", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-timeout=5", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-contracts=contract1.yul:A,contract2.yul:B", {"--assemble", "--strict-assembly", "--standard-json", "--link"}},
@@ -99,10 +99,13 @@ void FuzzerUtil::testCompiler(
 			frontend::ModelCheckerEngine::All(),
 			frontend::ModelCheckerExtCalls{},
 			frontend::ModelCheckerInvariants::All(),
+			/*jobs=*/1,
 			/*printQuery=*/false,
+			/*raceSolvers=*/false,
 			/*showProvedSafe=*/false,
 			/*showUnproved=*/false,
 			/*showUnsupported=*/false,
+			/*solverSessions=*/false,
 			smtutil::SMTSolverChoice::All(),
 			frontend::ModelCheckerTargets::Default(),
 			/*timeout=*/1
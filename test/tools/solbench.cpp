@@ -0,0 +1,371 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * In-process benchmark of the individual stages of the compiler pipeline.
+ *
+ * Compiles every Solidity file of a corpus (e.g. test/benchmarks or test/libsolidity/semanticTests)
+ * repeatedly and reports the time spent in each stage as recorded by the probes of util::Profiler
+ * (parsing, analysis passes, code generation, Yul optimizer steps, stack layout generation, assembly),
+ * together with the scanner and keccak256 throughput on the same sources.
+ * The number of files that fail to compile due to "stack too deep" is reported as well, so that
+ * the code transforms from Yul to EVM code can be compared.
+ * The result is printed as JSON with sorted keys, so that runs on different commits can be compared.
+ */
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/OptimiserSettings.h>
+#include <libsolidity/interface/Version.h>
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/Exceptions.h>
+#include <liblangutil/Scanner.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+#include <libsolutil/Keccak256.h>
+#include <libsolutil/Profiler.h>
+
+#include <libyul/Exceptions.h>
+
+#include <boost/exception/diagnostic_information.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::langutil;
+using namespace solidity::frontend;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+struct StageSamples
+{
+	/// Number of times the stage ran in a single iteration.
+	size_t calls = 0;
+	/// Total time spent in the stage, for each iteration.
+	std::vector<std::chrono::microseconds> durations;
+};
+
+struct BenchmarkSettings
+{
+	size_t iterations = 5;
+	bool optimize = false;
+	bool viaIR = false;
+	bool ssaCFGCodeTransform = false;
+};
+
+std::map<std::string, std::string> loadCorpus(std::vector<std::string> const& _paths, size_t& _skipped)
+{
+	std::vector<fs::path> files;
+	for (std::string const& path: _paths)
+		if (fs::is_directory(path))
+		{
+			for (fs::directory_entry const& entry: fs::recursive_directory_iterator(path))
+				if (fs::is_regular_file(entry.path()) && entry.path().extension() == ".sol")
+					files.push_back(entry.path());
+		}
+		else
+			files.emplace_back(path);
+	std::sort(files.begin(), files.end());
+
+	std::map<std::string, std::string> corpus;
+	for (fs::path const& file: files)
+	{
+		std::string content = readFileAsString(file);
+		// Test files consisting of multiple sources cannot be compiled on their own.
+		if (content.find("==== Source:") != std::string::npos || content.find("==== ExternalSource:") != std::string::npos)
+			++_skipped;
+		else
+			corpus[file.generic_string()] = std::move(content);
+	}
+	return corpus;
+}
+
+/// Compiles @a _source on its own and @returns the profiler metrics summed over all contracts,
+/// or nothing if the source does not compile without errors.
+/// Sets @a _stackTooDeep, if given, to whether the compilation failed due to "stack too deep".
+/// Exceptions other than the ones reporting errors in the source, like internal compiler errors
+/// and failed Yul assertions, are passed on.
+std::optional<std::map<std::string, Profiler::Metrics>> compile(
+	std::string const& _name,
+	std::string const& _source,
+	BenchmarkSettings const& _settings,
+	bool* _stackTooDeep = nullptr
+)
+{
+	OptimiserSettings optimiserSettings = _settings.optimize ? OptimiserSettings::standard() : OptimiserSettings::minimal();
+	optimiserSettings.experimentalSSACFGCodeTransform = _settings.ssaCFGCodeTransform;
+
+	CompilerStack compiler;
+	compiler.setSources({{_name, _source}});
+	compiler.setViaIR(_settings.viaIR);
+	compiler.setOptimiserSettings(std::move(optimiserSettings));
+	compiler.selectContracts({{"", {{"", CompilerStack::PipelineConfig{false, false, true}}}}});
+	compiler.setProfiling(true);
+
+	try
+	{
+		if (!compiler.compile() || Error::containsErrors(compiler.errors()))
+			return std::nullopt;
+	}
+	catch (yul::StackTooDeepError const&)
+	{
+		if (_stackTooDeep)
+			*_stackTooDeep = true;
+		return std::nullopt;
+	}
+	catch (langutil::StackTooDeepError const&)
+	{
+		if (_stackTooDeep)
+			*_stackTooDeep = true;
+		return std::nullopt;
+	}
+	catch (CompilerError const&)
+	{
+		return std::nullopt;
+	}
+	catch (UnimplementedFeatureError const&)
+	{
+		return std::nullopt;
+	}
+	catch (...)
+	{
+		// Internal compiler errors and failed assertions are bugs, which must not be hidden by
+		// skipping the source.
+		std::cerr << "Unexpected exception while compiling " << _name << ":" << std::endl;
+		throw;
+	}
+
+	std::map<std::string, Profiler::Metrics> stages;
+	for (auto const& [contract, scopes]: compiler.profiler()->metrics())
+		for (auto const& [scope, metrics]: scopes)
+		{
+			stages[scope].durationInMicroseconds += metrics.durationInMicroseconds;
+			stages[scope].callCount += metrics.callCount;
+		}
+	return stages;
+}
+
+template <typename Function>
+std::chrono::microseconds measure(Function&& _function)
+{
+	auto start = std::chrono::steady_clock::now();
+	_function();
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+}
+
+Json summarize(StageSamples _samples)
+{
+	std::sort(_samples.durations.begin(), _samples.durations.end());
+	Json result;
+	result["calls"] = _samples.calls;
+	result["minMicroseconds"] = _samples.durations.front().count();
+	result["medianMicroseconds"] = _samples.durations[_samples.durations.size() / 2].count();
+	return result;
+}
+
+Json runBenchmarks(std::map<std::string, std::string> _corpus, size_t _skipped, BenchmarkSettings const& _settings)
+{
+	// The first round serves as warm-up and sorts out the sources that do not compile on their own
+	// (e.g. because they require a different EVM version or contain expected errors).
+	size_t stackTooDeep = 0;
+	for (auto it = _corpus.begin(); it != _corpus.end();)
+	{
+		bool failedWithStackTooDeep = false;
+		if (!compile(it->first, it->second, _settings, &failedWithStackTooDeep))
+		{
+			if (failedWithStackTooDeep)
+			{
+				std::cerr << "Skipping " << it->first << ": stack too deep." << std::endl;
+				++stackTooDeep;
+			}
+			else
+				std::cerr << "Skipping " << it->first << ": it does not compile on its own." << std::endl;
+			it = _corpus.erase(it);
+			++_skipped;
+		}
+		else
+			++it;
+	}
+
+	size_t corpusBytes = 0;
+	for (auto const& source: _corpus)
+		corpusBytes += source.second.size();
+
+	std::map<std::string, StageSamples> stages;
+	for (size_t iteration = 0; iteration < _settings.iterations; ++iteration)
+	{
+		std::map<std::string, Profiler::Metrics> iterationMetrics;
+		std::chrono::microseconds total = measure([&]() {
+			for (auto const& [name, source]: _corpus)
+			{
+				auto metrics = compile(name, source, _settings);
+				solAssert(metrics, "Source " + name + " did not compile again.");
+				for (auto const& [stage, stageMetrics]: *metrics)
+				{
+					iterationMetrics[stage].durationInMicroseconds += stageMetrics.durationInMicroseconds;
+					iterationMetrics[stage].callCount += stageMetrics.callCount;
+				}
+			}
+		});
+		iterationMetrics["Total"] = {total, _corpus.size(), 0};
+
+		iterationMetrics["Scanner"].callCount = _corpus.size();
+		iterationMetrics["Scanner"].durationInMicroseconds = measure([&]() {
+			for (auto const& [name, source]: _corpus)
+			{
+				CharStream charStream(source, name);
+				Scanner scanner(charStream);
+				while (scanner.next() != Token::EOS)
+				{
+				}
+			}
+		});
+
+		iterationMetrics["Keccak256"].callCount = _corpus.size();
+		iterationMetrics["Keccak256"].durationInMicroseconds = measure([&]() {
+			for (auto const& source: _corpus)
+				keccak256(source.second);
+		});
+
+		for (auto const& [stage, metrics]: iterationMetrics)
+		{
+			stages[stage].calls = metrics.callCount;
+			stages[stage].durations.push_back(metrics.durationInMicroseconds);
+		}
+	}
+
+	Json result;
+	result["version"] = VersionStringStrict;
+	result["iterations"] = _settings.iterations;
+	result["settings"]["optimize"] = _settings.optimize;
+	result["settings"]["viaIR"] = _settings.viaIR;
+	result["settings"]["ssaCFGCodeTransform"] = _settings.ssaCFGCodeTransform;
+	result["corpus"]["files"] = _corpus.size();
+	result["corpus"]["skippedFiles"] = _skipped;
+	result["corpus"]["stackTooDeepFiles"] = stackTooDeep;
+	result["corpus"]["bytes"] = corpusBytes;
+	result["stages"] = Json::object();
+	for (auto const& [stage, samples]: stages)
+		result["stages"][stage] = summarize(samples);
+	return result;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		BenchmarkSettings settings;
+		po::options_description options(
+			R"(solbench, benchmark of the stages of the compiler pipeline.
+	Usage: solbench [Options] <path>...
+	Compiles each Solidity file given directly or found in the given directories
+	on its own and prints the time spent in each stage of the compiler as JSON.
+	Example: solbench test/benchmarks test/libsolidity/semanticTests
+
+	Allowed options)",
+			po::options_description::m_default_line_length,
+			po::options_description::m_default_line_length - 23);
+		options.add_options()
+			(
+				"input-path",
+				po::value<std::vector<std::string>>(),
+				"input files or directories"
+			)
+			(
+				"iterations",
+				po::value<size_t>(&settings.iterations)->default_value(settings.iterations),
+				"number of measured compilations of the corpus"
+			)
+			(
+				"optimize",
+				po::bool_switch(&settings.optimize)->default_value(false),
+				"enable the optimizer"
+			)
+			(
+				"via-ir",
+				po::bool_switch(&settings.viaIR)->default_value(false),
+				"compile via the IR"
+			)
+			(
+				"ssa-cfg-code-transform",
+				po::bool_switch(&settings.ssaCFGCodeTransform)->default_value(false),
+				"generate the bytecode with the experimental code transform based on the SSA control flow graph "
+				"(only takes effect together with --via-ir)"
+			)
+			("help,h", "Show this help screen.");
+
+		po::positional_options_description filesPositions;
+		filesPositions.add("input-path", -1);
+
+		po::variables_map arguments;
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+		po::notify(arguments);
+
+		if (arguments.count("help"))
+		{
+			std::cout << options;
+			return 0;
+		}
+
+		if (!arguments.count("input-path") || settings.iterations == 0)
+		{
+			std::cout << options;
+			return 1;
+		}
+
+		size_t skipped = 0;
+		auto corpus = loadCorpus(arguments["input-path"].as<std::vector<std::string>>(), skipped);
+		Json result = runBenchmarks(std::move(corpus), skipped, settings);
+		if (result["corpus"]["files"] == 0)
+		{
+			std::cerr << "No source of the corpus could be compiled." << std::endl;
+			return 1;
+		}
+		std::cout << jsonPrettyPrint(result) << std::endl;
+	}
+	catch (po::error const& _exception)
+	{
+		std::cerr << _exception.what() << std::endl;
+		return 1;
+	}
+	catch (...)
+	{
+		std::cerr << std::endl << "Exception:" << std::endl;
+		std::cerr << boost::current_exception_diagnostic_information() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
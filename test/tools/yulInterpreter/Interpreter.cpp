@@ -43,18 +43,29 @@ using namespace solidity::yul::test;
 
 using solidity::util::h256;
 
-void InterpreterState::dumpStorage(std::ostream& _out) const
+namespace
+{
+
+void dumpNonZeroSlots(std::ostream& _out, Storage const& _storage)
 {
-	for (auto const& [slot, value]: storage)
+	std::map<h256, h256> nonZeroSlots;
+	for (auto const& [slot, value]: _storage)
 		if (value != h256{})
-			_out << "  " << slot.hex() << ": " << value.hex() << std::endl;
+			nonZeroSlots.emplace(slot, value);
+	for (auto const& [slot, value]: nonZeroSlots)
+		_out << "  " << slot.hex() << ": " << value.hex() << std::endl;
+}
+
+}
+
+void InterpreterState::dumpStorage(std::ostream& _out) const
+{
+	dumpNonZeroSlots(_out, storage);
 }
 
 void InterpreterState::dumpTransientStorage(std::ostream& _out) const
 {
-	for (auto const& [slot, value]: transientStorage)
-		if (value != h256{})
-			_out << "  " << slot.hex() << ": " << value.hex() << std::endl;
+	dumpNonZeroSlots(_out, transientStorage);
 }
 
 void InterpreterState::dumpTraceAndState(std::ostream& _out, bool _disableMemoryTrace) const
@@ -65,12 +76,13 @@ void InterpreterState::dumpTraceAndState(std::ostream& _out, bool _disableMemory
 	if (!_disableMemoryTrace)
 	{
 		_out << "Memory dump:\n";
-		std::map<u256, u256> words;
-		for (auto const& [offset, value]: memory)
-			words[(offset / 0x20) * 0x20] |= u256(uint32_t(value)) << (256 - 8 - 8 * static_cast<size_t>(offset % 0x20));
-		for (auto const& [offset, value]: words)
-			if (value != 0)
-				_out << "  " << std::uppercase << std::hex << std::setw(4) << offset << ": " << h256(value).hex() << std::endl;
+		for (auto const& [pageAddress, page]: memory.pages())
+			for (size_t offset = 0; offset < Memory::PageSize; offset += 0x20)
+			{
+				h256 word(bytesConstRef(page.data() + offset, 0x20));
+				if (word != h256{})
+					_out << "  " << std::uppercase << std::hex << std::setw(4) << u256(pageAddress + offset) << ": " << word.hex() << std::endl;
+			}
 	}
 	_out << "Storage dump:" << std::endl;
 	dumpStorage(_out);
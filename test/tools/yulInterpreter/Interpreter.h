@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <test/tools/yulInterpreter/Memory.h>
+
 #include <libyul/ASTForward.h>
 #include <libyul/optimiser/ASTWalker.h>
 
@@ -31,7 +33,10 @@
 
 #include <libsolutil/Exceptions.h>
 
+#include <boost/functional/hash.hpp>
+
 #include <map>
+#include <unordered_map>
 
 namespace solidity::yul
 {
@@ -73,15 +78,23 @@ enum class ControlFlowState
 	Leave
 };
 
+struct StorageSlotHash
+{
+	size_t operator()(util::h256 const& _slot) const { return boost::hash_range(_slot.data(), _slot.data() + util::h256::size); }
+};
+
+/// Storage is only ever accessed by slot, and it is sorted for dumping.
+using Storage = std::unordered_map<util::h256, util::h256, StorageSlotHash>;
+
 struct InterpreterState
 {
 	bytes calldata;
 	bytes returndata;
-	std::map<u256, uint8_t> memory;
-	/// This is different than memory.size() because we ignore gas.
+	Memory memory;
+	/// This is different than the size of the touched memory because we ignore gas.
 	u256 msize;
-	std::map<util::h256, util::h256> storage;
-	std::map<util::h256, util::h256> transientStorage;
+	Storage storage;
+	Storage transientStorage;
 	util::h160 address = util::h160("0x0000000000000000000000000000000011111111");
 	u256 balance = 0x22222222;
 	u256 selfbalance = 0x22223333;
@@ -132,10 +145,7 @@ struct InterpreterState
 	bytes readMemory(u256 const& _offset, u256 const& _size)
 	{
 		yulAssert(_size <= 0xffff, "Too large read.");
-		bytes data(size_t(_size), uint8_t(0));
-		for (size_t i = 0; i < data.size(); ++i)
-			data[i] = memory[_offset + i];
-		return data;
+		return memory.read(_offset, size_t(_size));
 	}
 };
 
@@ -0,0 +1,104 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Byte-addressable memory of the Yul interpreter.
+ */
+
+#include <test/tools/yulInterpreter/Memory.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace solidity;
+using namespace solidity::yul::test;
+
+uint8_t Memory::read(u256 const& _offset) const
+{
+	uint8_t value = 0;
+	read(_offset, &value, 1);
+	return value;
+}
+
+void Memory::write(u256 const& _offset, uint8_t _value)
+{
+	write(_offset, &_value, 1);
+}
+
+bytes Memory::read(u256 const& _offset, size_t _size) const
+{
+	bytes data(_size, uint8_t(0));
+	read(_offset, data.data(), data.size());
+	return data;
+}
+
+void Memory::write(u256 const& _offset, bytesConstRef _data)
+{
+	write(_offset, _data.data(), _data.size());
+}
+
+u256 Memory::readWord(u256 const& _offset) const
+{
+	util::h256 word;
+	read(_offset, word.data(), 32);
+	return u256(word);
+}
+
+void Memory::writeWord(u256 const& _offset, u256 const& _value)
+{
+	util::h256 word(_value);
+	write(_offset, word.data(), 32);
+}
+
+void Memory::copy(u256 const& _targetOffset, u256 const& _sourceOffset, size_t _size)
+{
+	bytes data = read(_sourceOffset, _size);
+	write(_targetOffset, data.data(), data.size());
+}
+
+void Memory::read(u256 _offset, uint8_t* _target, size_t _size) const
+{
+	while (_size > 0)
+	{
+		size_t start = offsetInPage(_offset);
+		size_t chunk = std::min(PageSize - start, _size);
+		auto page = m_pages.find(pageAddress(_offset));
+		if (page != m_pages.end())
+			std::memcpy(_target, page->second.data() + start, chunk);
+		else
+			std::memset(_target, 0, chunk);
+		_target += chunk;
+		_size -= chunk;
+		_offset += chunk;
+	}
+}
+
+void Memory::write(u256 _offset, uint8_t const* _source, size_t _size)
+{
+	while (_size > 0)
+	{
+		size_t start = offsetInPage(_offset);
+		size_t chunk = std::min(PageSize - start, _size);
+		Page& page = m_pages.try_emplace(pageAddress(_offset)).first->second;
+		std::memcpy(page.data() + start, _source, chunk);
+		_source += chunk;
+		_size -= chunk;
+		_offset += chunk;
+	}
+}
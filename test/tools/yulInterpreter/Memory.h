@@ -0,0 +1,73 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Byte-addressable memory of the Yul interpreter.
+ */
+
+#pragma once
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Numeric.h>
+
+#include <array>
+#include <map>
+
+namespace solidity::yul::test
+{
+
+/**
+ * Sparse memory stored in fixed-size pages, so that word-sized and bulk accesses need
+ * one lookup per page instead of one tree node per byte.
+ * Bytes that were never written read as zero. Addresses wrap around modulo 2**256.
+ */
+class Memory
+{
+public:
+	/// Multiple of 32, so that aligned words never cross a page boundary.
+	static constexpr size_t PageSize = 0x400;
+	using Page = std::array<uint8_t, PageSize>;
+
+	uint8_t read(u256 const& _offset) const;
+	void write(u256 const& _offset, uint8_t _value);
+
+	/// @returns @a _size bytes starting at @a _offset.
+	bytes read(u256 const& _offset, size_t _size) const;
+	void write(u256 const& _offset, bytesConstRef _data);
+
+	/// @returns the big-endian word starting at @a _offset.
+	u256 readWord(u256 const& _offset) const;
+	void writeWord(u256 const& _offset, u256 const& _value);
+
+	/// Copies @a _size bytes from @a _sourceOffset to @a _targetOffset
+	/// as if using an intermediate buffer.
+	void copy(u256 const& _targetOffset, u256 const& _sourceOffset, size_t _size);
+
+	/// @returns all pages that were written to, ordered by their address.
+	std::map<u256, Page> const& pages() const { return m_pages; }
+
+private:
+	void read(u256 _offset, uint8_t* _target, size_t _size) const;
+	void write(u256 _offset, uint8_t const* _source, size_t _size);
+
+	static u256 pageAddress(u256 const& _offset) { return _offset & ~u256(PageSize - 1); }
+	static size_t offsetInPage(u256 const& _offset) { return static_cast<size_t>(_offset & (PageSize - 1)); }
+
+	std::map<u256, Page> m_pages;
+};
+
+}
@@ -25,6 +25,7 @@
 
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/TemporaryDirectory.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
@@ -88,6 +89,7 @@ protected:
 		/* metricAggregator = */ MetricAggregatorChoice::Average,
 		/* relativeMetricScale = */ 5,
 		/* chromosomeRepetitions = */ 1,
+		/* jobs = */ 1,
 	};
 	CodeWeights const m_weights{};
 };
@@ -236,6 +238,20 @@ BOOST_FIXTURE_TEST_CASE(build_should_set_relative_metric_scale, FitnessMetricFac
 	BOOST_TEST(relativeProgramSizeMetric->fixedPointPrecision() == m_options.relativeMetricScale);
 }
 
+BOOST_FIXTURE_TEST_CASE(build_should_set_thread_pool_according_to_jobs_option, FitnessMetricFactoryFixture)
+{
+	m_options.jobs = 1;
+	std::unique_ptr<FitnessMetric> sequentialMetric = FitnessMetricFactory::build(m_options, {m_programs[0]}, {nullptr}, m_weights);
+	BOOST_REQUIRE(sequentialMetric != nullptr);
+	BOOST_TEST(sequentialMetric->threadPool() == nullptr);
+
+	m_options.jobs = 3;
+	std::unique_ptr<FitnessMetric> concurrentMetric = FitnessMetricFactory::build(m_options, {m_programs[0]}, {nullptr}, m_weights);
+	BOOST_REQUIRE(concurrentMetric != nullptr);
+	BOOST_REQUIRE(concurrentMetric->threadPool() != nullptr);
+	BOOST_TEST(concurrentMetric->threadPool()->size() == 3);
+}
+
 BOOST_FIXTURE_TEST_CASE(build_should_create_metric_for_each_input_program, FitnessMetricFactoryFixture)
 {
 	std::unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(
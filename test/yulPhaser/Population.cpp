@@ -31,6 +31,8 @@
 
 #include <liblangutil/CharStream.h>
 
+#include <libsolutil/ThreadPool.h>
+
 #include <boost/test/unit_test.hpp>
 
 #include <cmath>
@@ -39,6 +41,7 @@
 #include <sstream>
 
 using namespace solidity::langutil;
+using namespace solidity::util;
 using namespace solidity::yul;
 using namespace boost::unit_test::framework;
 
@@ -112,6 +115,19 @@ BOOST_FIXTURE_TEST_CASE(constructor_should_copy_chromosomes_compute_fitness_and_
 	BOOST_TEST(individuals[2].chromosome == chromosomes[1]);
 }
 
+BOOST_FIXTURE_TEST_CASE(constructor_should_compute_the_same_fitness_if_the_metric_uses_a_thread_pool, PopulationFixture)
+{
+	std::vector<Chromosome> chromosomes;
+	for (size_t length = 0; length < 20; ++length)
+		chromosomes.push_back(Chromosome::makeRandom(length));
+	Population sequentialPopulation(m_fitnessMetric, chromosomes);
+
+	m_fitnessMetric->setThreadPool(std::make_shared<ThreadPool>(4));
+	Population concurrentPopulation(m_fitnessMetric, chromosomes);
+
+	BOOST_TEST(concurrentPopulation == sequentialPopulation);
+}
+
 BOOST_FIXTURE_TEST_CASE(constructor_should_accept_individuals_without_recalculating_fitness, PopulationFixture)
 {
 	std::vector<Individual> customIndividuals = {
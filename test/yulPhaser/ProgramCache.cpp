@@ -24,11 +24,14 @@
 #include <liblangutil/CharStream.h>
 
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <boost/test/unit_test.hpp>
 
+#include <functional>
 #include <string>
 #include <set>
+#include <vector>
 
 using namespace solidity::util;
 using namespace solidity::langutil;
@@ -116,6 +119,24 @@ BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_store_programs_for_all_prefixes,
 	BOOST_TEST(toString(*m_programCache.find("IuO")) == toString(programIuO));
 }
 
+BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_be_safe_to_call_concurrently, ProgramCacheFixture)
+{
+	std::vector<std::string> chromosomes = {"IuO", "Iu", "IuOI", "uO", "IuO", "OI"};
+	std::vector<std::string> optimisedPrograms(chromosomes.size());
+
+	std::vector<std::function<void()>> optimisations;
+	for (size_t i = 0; i < chromosomes.size(); ++i)
+		optimisations.emplace_back([&, i]() {
+			optimisedPrograms[i] = toString(m_programCache.optimiseProgram(chromosomes[i]));
+		});
+	ThreadPool threadPool(3);
+	threadPool.runAll(std::move(optimisations));
+
+	for (size_t i = 0; i < chromosomes.size(); ++i)
+		BOOST_TEST(optimisedPrograms[i] == toString(optimisedProgram(m_program, chromosomes[i])));
+	BOOST_TEST((cachedKeys(m_programCache) == std::set<std::string>{"I", "Iu", "IuO", "IuOI", "u", "uO", "O", "OI"}));
+}
+
 BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_repeat_the_chromosome_requested_number_of_times, ProgramCacheFixture)
 {
 	std::string steps = "IuOIuO";
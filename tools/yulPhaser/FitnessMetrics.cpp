@@ -19,13 +19,31 @@
 #include <tools/yulPhaser/FitnessMetrics.h>
 
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <cmath>
+#include <functional>
 
 using namespace solidity::util;
 using namespace solidity::yul;
 using namespace solidity::phaser;
 
+std::vector<size_t> FitnessMetric::evaluateAll(std::vector<Chromosome> const& _chromosomes)
+{
+	std::vector<size_t> values(_chromosomes.size());
+	std::vector<std::function<void()>> evaluations;
+	for (size_t i = 0; i < _chromosomes.size(); ++i)
+		evaluations.emplace_back([&, i]() { values[i] = evaluate(_chromosomes[i]); });
+
+	if (m_threadPool)
+		m_threadPool->runAll(std::move(evaluations));
+	else
+		for (auto const& evaluation: evaluations)
+			evaluation();
+
+	return values;
+}
+
 Program const& ProgramBasedMetric::program() const
 {
 	if (m_programCache == nullptr)
@@ -28,7 +28,14 @@
 #include <libyul/optimiser/Metrics.h>
 
 #include <cstddef>
+#include <memory>
 #include <optional>
+#include <vector>
+
+namespace solidity::util
+{
+class ThreadPool;
+}
 
 namespace solidity::phaser
 {
@@ -39,6 +46,9 @@ namespace solidity::phaser
  * The main feature is the @a evaluate() method that can tell how good a given chromosome is.
  * The lower the value, the better the fitness is. The result should be deterministic and depend
  * only on the chromosome and metric's state (which is constant).
+ *
+ * If a thread pool is set, @a evaluateAll() evaluates multiple chromosomes concurrently, so
+ * @a evaluate() must be safe to call from multiple threads at the same time.
  */
 class FitnessMetric
 {
@@ -49,6 +59,16 @@ public:
 	virtual ~FitnessMetric() = default;
 
 	virtual size_t evaluate(Chromosome const& _chromosome) = 0;
+
+	/// Evaluates all the chromosomes, concurrently if a thread pool is set.
+	/// @returns the fitness values in the order of @a _chromosomes.
+	std::vector<size_t> evaluateAll(std::vector<Chromosome> const& _chromosomes);
+
+	std::shared_ptr<util::ThreadPool> const& threadPool() const { return m_threadPool; }
+	void setThreadPool(std::shared_ptr<util::ThreadPool> _threadPool) { m_threadPool = std::move(_threadPool); }
+
+private:
+	std::shared_ptr<util::ThreadPool> m_threadPool;
 };
 
 /**
@@ -34,6 +34,7 @@
 #include <libsolutil/Assertions.h>
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <iostream>
 
@@ -218,6 +219,7 @@ FitnessMetricFactory::Options FitnessMetricFactory::Options::fromCommandLine(po:
 		_arguments["metric-aggregator"].as<MetricAggregatorChoice>(),
 		_arguments["relative-metric-scale"].as<size_t>(),
 		_arguments["chromosome-repetitions"].as<size_t>(),
+		_arguments["jobs"].as<size_t>(),
 	};
 }
 
@@ -262,22 +264,31 @@ std::unique_ptr<FitnessMetric> FitnessMetricFactory::build(
 			assertThrow(false, solidity::util::Exception, "Invalid MetricChoice value.");
 	}
 
+	std::unique_ptr<FitnessMetric> aggregatedMetric;
 	switch (_options.metricAggregator)
 	{
 		case MetricAggregatorChoice::Average:
-			return std::make_unique<FitnessMetricAverage>(std::move(metrics));
+			aggregatedMetric = std::make_unique<FitnessMetricAverage>(std::move(metrics));
+			break;
 		case MetricAggregatorChoice::Sum:
-			return std::make_unique<FitnessMetricSum>(std::move(metrics));
+			aggregatedMetric = std::make_unique<FitnessMetricSum>(std::move(metrics));
+			break;
 		case MetricAggregatorChoice::Maximum:
-			return std::make_unique<FitnessMetricMaximum>(std::move(metrics));
+			aggregatedMetric = std::make_unique<FitnessMetricMaximum>(std::move(metrics));
+			break;
 		case MetricAggregatorChoice::Minimum:
-			return std::make_unique<FitnessMetricMinimum>(std::move(metrics));
+			aggregatedMetric = std::make_unique<FitnessMetricMinimum>(std::move(metrics));
+			break;
 		default:
 			assertThrow(false, solidity::util::Exception, "Invalid MetricAggregatorChoice value.");
 	}
 
-	// FIXME: Workaround for spurious GCC 12.1 warning (https://gcc.gnu.org/bugzilla/show_bug.cgi?id=105794)
-	util::unreachable();
+	// The individuals of a population are evaluated concurrently by the aggregated metric.
+	// The nested metrics and the program caches are safe to use from multiple threads.
+	if (size_t threadCount = util::ThreadPool::threadCountForJobs(_options.jobs); threadCount > 0)
+		aggregatedMetric->setThreadPool(std::make_shared<util::ThreadPool>(threadCount));
+
+	return aggregatedMetric;
 }
 
 PopulationFactory::Options PopulationFactory::Options::fromCommandLine(po::variables_map const& _arguments)
@@ -460,6 +471,13 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 			"or removed using this option. The value given here is applied after it."
 		)
 		("seed", po::value<uint32_t>()->value_name("<NUM>"), "Seed for the random number generator.")
+		(
+			"jobs",
+			po::value<size_t>()->value_name("<NUM>")->default_value(1),
+			"Number of threads used to evaluate the fitness of the individuals of a population concurrently. "
+			"0 means one per available hardware thread. "
+			"For a given seed, the results do not depend on this setting."
+		)
 		(
 			"rounds",
 			po::value<size_t>()->value_name("<NUM>"),
@@ -158,6 +158,7 @@ public:
 		MetricAggregatorChoice metricAggregator;
 		size_t relativeMetricScale;
 		size_t chromosomeRepetitions;
+		size_t jobs;
 
 		static Options fromCommandLine(boost::program_options::variables_map const& _arguments);
 	};
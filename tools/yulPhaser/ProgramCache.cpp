@@ -59,31 +59,36 @@ Program ProgramCache::optimiseProgram(
 		targetOptimisations += _abbreviatedOptimisationSteps;
 
 	std::size_t prefixSize = 0;
-	for (std::size_t i = 1; i <= targetOptimisations.size(); ++i)
-	{
-		auto const& pair = m_entries.find(targetOptimisations.substr(0, i));
-		if (pair != m_entries.end())
+	Program intermediateProgram = [&]() {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (std::size_t i = 1; i <= targetOptimisations.size(); ++i)
 		{
-			pair->second.roundNumber = m_currentRound;
-			++prefixSize;
-			++m_hits;
+			auto const& pair = m_entries.find(targetOptimisations.substr(0, i));
+			if (pair != m_entries.end())
+			{
+				pair->second.roundNumber = m_currentRound;
+				++prefixSize;
+				++m_hits;
+			}
+			else
+				break;
 		}
-		else
-			break;
-	}
 
-	Program intermediateProgram = (
-		prefixSize == 0 ?
-		m_program :
-		m_entries.at(targetOptimisations.substr(0, prefixSize)).program
-	);
+		return (
+			prefixSize == 0 ?
+			m_program :
+			m_entries.at(targetOptimisations.substr(0, prefixSize)).program
+		);
+	}();
 
 	for (std::size_t i = prefixSize + 1; i <= targetOptimisations.size(); ++i)
 	{
 		std::string stepName = OptimiserSuite::stepAbbreviationToNameMap().at(targetOptimisations[i - 1]);
 		intermediateProgram.optimise({stepName});
 
-		m_entries.insert({targetOptimisations.substr(0, i), {intermediateProgram, m_currentRound}});
+		CacheEntry entry{intermediateProgram, m_currentRound};
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_entries.emplace(targetOptimisations.substr(0, i), std::move(entry));
 		++m_misses;
 	}
 
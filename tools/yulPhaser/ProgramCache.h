@@ -24,6 +24,7 @@
 
 #include <cstddef>
 #include <map>
+#include <mutex>
 #include <string>
 
 namespace solidity::phaser
@@ -102,6 +103,10 @@ struct CacheStats
  * There is currently no way to purge entries without starting a new round. Since the programs
  * take a lot of memory, this may lead to the cache eating up all the available RAM if sequences are
  * long and programs large. A limiter based on entry count or total program size would be useful.
+ *
+ * @a optimiseProgram() can be called from multiple threads at the same time. The optimisation
+ * steps run without holding the lock, so two threads may occasionally compute the same entry.
+ * The other members must not be called while programs are being optimised.
  */
 class ProgramCache
 {
@@ -139,6 +144,8 @@ private:
 	size_t m_currentRound = 0;
 	size_t m_hits = 0;
 	size_t m_misses = 0;
+	/// Guards the entries and the statistics in @a optimiseProgram().
+	std::mutex m_mutex;
 };
 
 }